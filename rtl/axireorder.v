@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/axireorder.v
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Delays, and reorders across IDs, one AXI channel: either a
+//		read request channel (AR) in front of a memory that answers
+//	in order, or a write response channel (B) behind one.  Either way,
+//	the result is a memory that may answer out of order across IDs.  (AW
+//	can't be reordered, since the W beats that follow it carry no ID.)
+//
+//	Each item is held in one of a small number of slots.  As it's
+//	accepted, the simulation's reordering model (sim/reordersim.cpp) is
+//	asked, via DPI, how long that item's ID should wait.  Items are then
+//	released, oldest first, among those whose wait is over--save that no
+//	item may pass an older item with the same ID.  A later item with a
+//	shorter wait may therefore pass an earlier one with a different ID.
+//
+//	If the simulation hasn't selected a reordering model at reset, or if
+//	this isn't being built by Verilator, items pass straight through.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+`default_nettype none
+//
+module	axireorder #(
+		// {{{
+		parameter	C_AXI_ID_WIDTH = 3,
+		// Width of everything else in the channel, such as the address
+		// and length of an AR request, or the BRESP of a B response
+		parameter	DW = 2,
+		// Set OPT_WRITE for the B channel, clear it for AR
+		parameter [0:0]	OPT_WRITE = 1'b0,
+		// Log_2 of the number of items that may be waiting at once
+		parameter	LGSLOTS = 3,
+		localparam	IW = C_AXI_ID_WIDTH,
+		localparam	NS = (1<<LGSLOTS)
+		// }}}
+	) (
+		// {{{
+		input	wire			S_AXI_ACLK,
+		input	wire			S_AXI_ARESETN,
+		//
+		// The incoming channel
+		input	wire			S_VALID,
+		output	wire			S_READY,
+		input	wire	[IW-1:0]	S_ID,
+		input	wire	[DW-1:0]	S_DATA,
+		//
+		// The outgoing (delayed, reordered) channel
+		output	wire			M_VALID,
+		input	wire			M_READY,
+		output	wire	[IW-1:0]	M_ID,
+		output	wire	[DW-1:0]	M_DATA
+		// }}}
+	);
+
+`ifdef	VERILATOR
+	import "DPI-C" function int reorder_enabled();
+	import "DPI-C" function int reorder_delay(input int wr, input int id);
+	import "DPI-C" function void reorder_passed(input int wr);
+`endif
+
+	// Local declarations
+	// {{{
+	wire			i_clk   =  S_AXI_ACLK;
+	wire			i_reset = !S_AXI_ARESETN;
+	integer			fk, rk, jk, pk;
+
+	reg			r_bypass;
+	reg	[63:0]		now;
+	reg	[31:0]		seq;
+
+	reg	[NS-1:0]	slot_valid;
+	reg	[IW-1:0]	slot_id		[0:NS-1];
+	reg	[DW-1:0]	slot_data	[0:NS-1];
+	reg	[63:0]		slot_release	[0:NS-1];
+	reg	[31:0]		slot_seq	[0:NS-1];
+
+	reg			full;
+	reg	[LGSLOTS-1:0]	free_idx;
+	reg	[NS-1:0]	ready;
+	reg			pick_valid;
+	reg	[LGSLOTS-1:0]	pick_idx, oldest_idx;
+	wire			accept, release_pick;
+
+	reg			m_valid;
+	reg	[IW-1:0]	m_id;
+	reg	[DW-1:0]	m_data;
+	// }}}
+
+	// r_bypass: set if there's no reordering model to follow
+	// {{{
+	initial	r_bypass = 1'b1;
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+`ifdef	VERILATOR
+		r_bypass <= (reorder_enabled() == 0);
+`else
+		r_bypass <= 1'b1;
+`endif
+	end
+	// }}}
+
+	// now, seq: the clock count, and the order items arrived in
+	// {{{
+	initial	now = 0;
+	always @(posedge i_clk)
+		now <= now + 1;
+
+	initial	seq = 0;
+	always @(posedge i_clk)
+	if (accept)
+		seq <= seq + 1;
+	// }}}
+
+	// Slot selection: the first free slot, and the item to release
+	// {{{
+	always @(*)
+	begin
+		full = 1'b1;
+		free_idx = 0;
+		for(fk=NS-1; fk>=0; fk=fk-1)
+		if (!slot_valid[fk])
+		begin
+			full = 1'b0;
+			free_idx = fk[LGSLOTS-1:0];
+		end
+	end
+
+	// An item is ready once its wait is over, and every older item with
+	// the same ID has been released
+	always @(*)
+	for(rk=0; rk<NS; rk=rk+1)
+	begin
+		ready[rk] = slot_valid[rk] && (now >= slot_release[rk]);
+		for(jk=0; jk<NS; jk=jk+1)
+		if (slot_valid[jk] && slot_id[jk] == slot_id[rk]
+				&& slot_seq[jk] < slot_seq[rk])
+			ready[rk] = 1'b0;
+	end
+
+	always @(*)
+	begin
+		pick_valid = 1'b0;
+		pick_idx   = 0;
+		oldest_idx = 0;
+		for(pk=0; pk<NS; pk=pk+1)
+		begin
+			if (ready[pk] && (!pick_valid
+					|| slot_seq[pk] < slot_seq[pick_idx]))
+			begin
+				pick_valid = 1'b1;
+				pick_idx = pk[LGSLOTS-1:0];
+			end
+
+			if (slot_valid[pk] && (!slot_valid[oldest_idx]
+					|| slot_seq[pk] < slot_seq[oldest_idx]))
+				oldest_idx = pk[LGSLOTS-1:0];
+		end
+	end
+
+	assign	accept = !r_bypass && S_VALID && !full;
+	assign	release_pick = !r_bypass && (!m_valid || M_READY) && pick_valid;
+	// }}}
+
+	// The slots themselves
+	// {{{
+	initial	slot_valid = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		slot_valid <= 0;
+	else begin
+		if (accept)
+			slot_valid[free_idx] <= 1'b1;
+		if (release_pick)
+			slot_valid[pick_idx] <= 1'b0;
+	end
+
+	always @(posedge i_clk)
+	if (accept)
+	begin
+		slot_id[free_idx]   <= S_ID;
+		slot_data[free_idx] <= S_DATA;
+		slot_seq[free_idx]  <= seq;
+`ifdef	VERILATOR
+		slot_release[free_idx] <= now + { 32'h0,
+			reorder_delay({ 31'h0, OPT_WRITE },
+				{ {(32-IW){1'b0}}, S_ID }) };
+`else
+		slot_release[free_idx] <= now;
+`endif
+	end
+
+`ifdef	VERILATOR
+	// Let the model count every item that passed an older one
+	always @(posedge i_clk)
+	if (release_pick && pick_idx != oldest_idx)
+		reorder_passed({ 31'h0, OPT_WRITE });
+`endif
+	// }}}
+
+	// The outgoing item
+	// {{{
+	initial	m_valid = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		m_valid <= 1'b0;
+	else if (!m_valid || M_READY)
+		m_valid <= release_pick;
+
+	initial	{ m_id, m_data } = 0;
+	always @(posedge i_clk)
+	if (release_pick)
+		{ m_id, m_data } <= { slot_id[pick_idx], slot_data[pick_idx] };
+
+	assign	S_READY = (r_bypass) ? M_READY : !full;
+	assign	M_VALID = (r_bypass) ? S_VALID : m_valid;
+	assign	M_ID    = (r_bypass) ? S_ID    : m_id;
+	assign	M_DATA  = (r_bypass) ? S_DATA  : m_data;
+	// }}}
+endmodule
@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/errinject.v
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Turns chosen bursts to or from an AXI memory into bus errors.
+//		As each request (AR or AW) is accepted by the memory, the
+//	simulation's error model (sim/errsim.cpp) is asked, via DPI, what that
+//	burst's response should be: OKAY, SLVERR, or DECERR.  The answer is
+//	then ORed into the memory's own response--every beat of a read burst's
+//	RRESP, or a write burst's BRESP--until the burst's last response.
+//
+//	The memory answers in the order it accepted its requests, so a small
+//	FIFO of answers is all that's needed.  Without a simulation error
+//	model, or if this isn't being built by Verilator, every answer is OKAY
+//	and the memory's responses pass through unchanged.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+`default_nettype none
+//
+module	errinject #(
+		// {{{
+		parameter	C_AXI_ADDR_WIDTH = 24,
+		// Set OPT_WRITE for the write channels, clear it for reads
+		parameter [0:0]	OPT_WRITE = 1'b0,
+		// Log_2 of the number of bursts that may be outstanding
+		parameter	LGFIFO = 4,
+		localparam	AW = C_AXI_ADDR_WIDTH
+		// }}}
+	) (
+		// {{{
+		input	wire			S_AXI_ACLK,
+		input	wire			S_AXI_ARESETN,
+		//
+		// A request accepted by the memory
+		input	wire			i_request,
+		input	wire	[AW-1:0]	i_addr,
+		input	wire	[7:0]		i_len,
+		//
+		// The memory's response, and whether it ends its burst
+		input	wire			i_last,
+		input	wire	[1:0]		i_resp,
+		output	wire	[1:0]		o_resp
+		// }}}
+	);
+
+`ifdef	VERILATOR
+	import "DPI-C" function int errinject_request(input int wr,
+			input longint addr, input int len);
+`endif
+
+	// Local declarations
+	// {{{
+	wire			i_clk   =  S_AXI_ACLK;
+	wire			i_reset = !S_AXI_ARESETN;
+
+	reg	[1:0]		fifo_resp	[0:(1<<LGFIFO)-1];
+	reg	[LGFIFO:0]	wr_addr, rd_addr;
+	wire			fifo_empty;
+	reg	[31:0]		dpi_resp;
+	// }}}
+
+	// The FIFO of answers, one per burst
+	// {{{
+	assign	fifo_empty = (wr_addr == rd_addr);
+
+	initial	wr_addr = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		wr_addr <= 0;
+	else if (i_request)
+		wr_addr <= wr_addr + 1;
+
+	always @(posedge i_clk)
+	if (i_request)
+	begin
+`ifdef	VERILATOR
+		dpi_resp = errinject_request({ 31'h0, OPT_WRITE },
+			{ {(64-AW){1'b0}}, i_addr }, { 24'h0, i_len });
+`else
+		dpi_resp = 32'h0;
+`endif
+		fifo_resp[wr_addr[LGFIFO-1:0]] <= dpi_resp[1:0];
+	end
+
+	initial	rd_addr = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		rd_addr <= 0;
+	else if (i_last && !fifo_empty)
+		rd_addr <= rd_addr + 1;
+	// }}}
+
+	assign	o_resp = i_resp | ((fifo_empty) ? 2'b00
+					: fifo_resp[rd_addr[LGFIFO-1:0]]);
+endmodule
@@ -8,7 +8,7 @@
 // Computer Generated: This file is computer generated by AUTOFPGA. DO NOT EDIT.
 // DO NOT EDIT THIS FILE!
 //
-// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt vibus.txt noconsole.txt
+// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axiram2.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt streamcheck.txt qos.txt vibus.txt noconsole.txt
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -132,7 +132,7 @@ module	main(i_clk, i_reset,
 	// {{{
 	input	wire				S_AXI_AWVALID;
 	output	wire				S_AXI_AWREADY;
-	input	wire [25-1:0]	S_AXI_AWADDR;
+	input	wire [34-1:0]	S_AXI_AWADDR;
 	//
 	input	wire				S_AXI_WVALID;
 	output	wire				S_AXI_WREADY;
@@ -145,7 +145,7 @@ module	main(i_clk, i_reset,
 	//
 	input	wire				S_AXI_ARVALID;
 	output	wire				S_AXI_ARREADY;
-	input	wire [25-1:0]	S_AXI_ARADDR;
+	input	wire [34-1:0]	S_AXI_ARADDR;
 	//
 	output	wire					S_AXI_RVALID;
 	input	wire					S_AXI_RREADY;
@@ -179,20 +179,80 @@ module	main(i_clk, i_reset,
 	// various components comprising the design.
 	//
 	wire	streamsink_tvalid, streamsink_tready, streamsink_tlast;
-	wire	[31:0]	streamsink_tdata;
-	reg	streamsrc_tvalid, streamsrc_tlast;
-	wire	streamsrc_tready;
-	reg	[31:0]	streamsrc_tdata;
-	reg	[31:0]	streamsrc_counter;
+	wire	[32-1:0]	streamsink_tdata;
+	wire	streamsink_start;
+	reg	streamsink_start_aw, streamsink_start_w;
+	wire	streamsrc_tvalid, streamsrc_tready, streamsrc_tlast;
+	wire	[32-1:0]	streamsrc_tdata;
 	// AXI RAM definitions
 	// {{{
 	wire	axiram_we, axiram_rd;
 	wire	[32-1:0]	axiram_wdata;
 	wire	[32/8-1:0]	axiram_wstrb;
 	reg	[32-1:0]	axiram_rdata;
-	wire	[24-$clog2(32/8)-1:0]		axiram_waddr, axiram_raddr;
+	wire	[33-$clog2(32/8)-1:0]		axiram_waddr, axiram_raddr;
+`ifdef	AXIRAM_SPARSE
+	// Byte addresses, for the sparse memory in sim/sparsemem.cpp
+	wire	[63:0]	axiram_wbyte, axiram_rbyte;
+`else
 	reg	[32-1:0]	axiram_mem [0:(4194304-1)];
+`endif
 	integer	axiram_ik;
+	//
+	// The AR and AW channels, after any DRAM timing delays
+	wire			axiram_arvalid, axiram_arready,
+				axiram_awvalid, axiram_awready;
+	wire	[3-1:0]	axiram_arid, axiram_awid;
+	wire	[33-1:0]	axiram_araddr, axiram_awaddr;
+	wire	[7:0]		axiram_arlen, axiram_awlen;
+	wire	[2:0]		axiram_arsize, axiram_awsize;
+	wire	[1:0]		axiram_arburst, axiram_awburst;
+	wire			axiram_arlock, axiram_awlock;
+	wire	[3:0]		axiram_arcache, axiram_awcache;
+	wire	[2:0]		axiram_arprot, axiram_awprot;
+	wire	[3:0]		axiram_arqos, axiram_awqos;
+	//
+	// The AR channel ahead of the DRAM timing, and the B channel from the
+	// memory, as reordered (if at all) by the simulation
+	wire			axiram_xarvalid, axiram_xarready;
+	wire	[3-1:0]	axiram_xarid;
+	wire	[33-1:0]	axiram_xaraddr;
+	wire	[7:0]		axiram_xarlen;
+	wire	[2:0]		axiram_xarsize;
+	wire	[1:0]		axiram_xarburst;
+	wire			axiram_xarlock;
+	wire	[3:0]		axiram_xarcache;
+	wire	[2:0]		axiram_xarprot;
+	wire	[3:0]		axiram_xarqos;
+	wire			axiram_xbvalid, axiram_xbready;
+	wire	[3-1:0]	axiram_xbid;
+	wire	[1:0]		axiram_xbresp;
+	//
+	// The memory's own R and B responses, before any injected errors
+	wire	[1:0]		axiram_rresp, axiram_mbresp;
+	// }}}
+	// Second AXI RAM definitions
+	// {{{
+	wire	axiram2_we, axiram2_rd;
+	wire	[32-1:0]	axiram2_wdata;
+	wire	[32/8-1:0]	axiram2_wstrb;
+	reg	[32-1:0]	axiram2_rdata;
+	wire	[22-$clog2(32/8)-1:0]		axiram2_waddr, axiram2_raddr;
+	reg	[32-1:0]	axiram2_mem [0:(1048576-1)];
+	integer	axiram2_ik;
+	// }}}
+	// QoS gate definitions
+	// {{{
+	// The movers' requests, before they pass through the QoS gates
+	wire		mm2s_arvalid, mm2s_arready,
+			s2mm_awvalid, s2mm_awready,
+			dma_arvalid, dma_arready, dma_awvalid, dma_awready;
+	// Verilator lint_off UNUSED
+	wire	[3:0]	mm2s_arqos, s2mm_awqos, dma_arqos, dma_awqos;
+	// Verilator lint_on  UNUSED
+	// The QoS values actually used, as set by the simulation
+	reg	[3:0]	qos_mm2s_ar, qos_s2mm_aw,
+			qos_dma_ar, qos_dma_aw;
 	// }}}
 	// Verilator lint_off UNUSED
 	wire	dma_cactive, dma_csysack;
@@ -225,7 +285,7 @@ module	main(i_clk, i_reset,
 	wire		wbu_vibus_awvalid;
 	wire		wbu_vibus_awready;
 	wire	[2:0]	wbu_vibus_awid;
-	wire	[24:0]	wbu_vibus_awaddr;
+	wire	[33:0]	wbu_vibus_awaddr;
 	wire	[7:0]	wbu_vibus_awlen;
 	wire	[2:0]	wbu_vibus_awsize;
 	wire	[1:0]	wbu_vibus_awburst;
@@ -249,7 +309,7 @@ module	main(i_clk, i_reset,
 	wire		wbu_vibus_arvalid;
 	wire		wbu_vibus_arready;
 	wire	[2:0]	wbu_vibus_arid;
-	wire	[24:0]	wbu_vibus_araddr;
+	wire	[33:0]	wbu_vibus_araddr;
 	wire	[7:0]	wbu_vibus_arlen;
 	wire	[2:0]	wbu_vibus_arsize;
 	wire	[1:0]	wbu_vibus_arburst;
@@ -281,7 +341,7 @@ module	main(i_clk, i_reset,
 	wire		wbu_wbu_awvalid;
 	wire		wbu_wbu_awready;
 	wire	[2:0]	wbu_wbu_awid;
-	wire	[24:0]	wbu_wbu_awaddr;
+	wire	[33:0]	wbu_wbu_awaddr;
 	wire	[7:0]	wbu_wbu_awlen;
 	wire	[2:0]	wbu_wbu_awsize;
 	wire	[1:0]	wbu_wbu_awburst;
@@ -305,7 +365,7 @@ module	main(i_clk, i_reset,
 	wire		wbu_wbu_arvalid;
 	wire		wbu_wbu_arready;
 	wire	[2:0]	wbu_wbu_arid;
-	wire	[24:0]	wbu_wbu_araddr;
+	wire	[33:0]	wbu_wbu_araddr;
 	wire	[7:0]	wbu_wbu_arlen;
 	wire	[2:0]	wbu_wbu_arsize;
 	wire	[1:0]	wbu_wbu_arburst;
@@ -341,7 +401,7 @@ module	main(i_clk, i_reset,
 	wire		axil_controlbus_awvalid, axil_controlbus_wvalid,
 			axil_controlbus_arvalid,
 			axil_controlbus_bready, axil_controlbus_rready;
-	wire	[6:0]	axil_controlbus_araddr, axil_controlbus_awaddr;
+	wire	[7:0]	axil_controlbus_araddr, axil_controlbus_awaddr;
 	wire	[2:0]	axil_controlbus_arprot, axil_controlbus_awprot;
 	wire	[31:0]	axil_controlbus_wdata;
 	wire	[3:0]	axil_controlbus_wstrb;
@@ -368,7 +428,7 @@ module	main(i_clk, i_reset,
 	wire		axil_streamsink_awvalid, axil_streamsink_wvalid,
 			axil_streamsink_arvalid,
 			axil_streamsink_bready, axil_streamsink_rready;
-	wire	[6:0]	axil_streamsink_araddr, axil_streamsink_awaddr;
+	wire	[7:0]	axil_streamsink_araddr, axil_streamsink_awaddr;
 	wire	[2:0]	axil_streamsink_arprot, axil_streamsink_awprot;
 	wire	[31:0]	axil_streamsink_wdata;
 	wire	[3:0]	axil_streamsink_wstrb;
@@ -389,7 +449,7 @@ module	main(i_clk, i_reset,
 	wire		axil_dma_awvalid, axil_dma_wvalid,
 			axil_dma_arvalid,
 			axil_dma_bready, axil_dma_rready;
-	wire	[6:0]	axil_dma_araddr, axil_dma_awaddr;
+	wire	[7:0]	axil_dma_araddr, axil_dma_awaddr;
 	wire	[2:0]	axil_dma_arprot, axil_dma_awprot;
 	wire	[31:0]	axil_dma_wdata;
 	wire	[3:0]	axil_dma_wstrb;
@@ -410,7 +470,7 @@ module	main(i_clk, i_reset,
 	wire		axil_mm2s_awvalid, axil_mm2s_wvalid,
 			axil_mm2s_arvalid,
 			axil_mm2s_bready, axil_mm2s_rready;
-	wire	[6:0]	axil_mm2s_araddr, axil_mm2s_awaddr;
+	wire	[7:0]	axil_mm2s_araddr, axil_mm2s_awaddr;
 	wire	[2:0]	axil_mm2s_arprot, axil_mm2s_awprot;
 	wire	[31:0]	axil_mm2s_wdata;
 	wire	[3:0]	axil_mm2s_wstrb;
@@ -431,11 +491,53 @@ module	main(i_clk, i_reset,
 	wire		axil_s2mm_awvalid, axil_s2mm_wvalid,
 			axil_s2mm_arvalid,
 			axil_s2mm_bready, axil_s2mm_rready;
-	wire	[6:0]	axil_s2mm_araddr, axil_s2mm_awaddr;
+	wire	[7:0]	axil_s2mm_araddr, axil_s2mm_awaddr;
 	wire	[2:0]	axil_s2mm_arprot, axil_s2mm_awprot;
 	wire	[31:0]	axil_s2mm_wdata;
 	wire	[3:0]	axil_s2mm_wstrb;
 
+	// Verilator lint_on  UNUSED
+	// }}}
+	//
+	// AXI-lite slave definitions for bus axil,
+	// component streamsrc, with prefix axil_streamsrc
+	// {{{
+	// Verilator lint_off UNUSED
+	wire		axil_streamsrc_awready, axil_streamsrc_wready,
+			axil_streamsrc_arready;
+	wire		axil_streamsrc_bvalid, axil_streamsrc_rvalid;
+	wire	[1:0]	axil_streamsrc_bresp, axil_streamsrc_rresp;
+	wire	[31:0]	axil_streamsrc_rdata;
+
+	wire		axil_streamsrc_awvalid, axil_streamsrc_wvalid,
+			axil_streamsrc_arvalid,
+			axil_streamsrc_bready, axil_streamsrc_rready;
+	wire	[7:0]	axil_streamsrc_araddr, axil_streamsrc_awaddr;
+	wire	[2:0]	axil_streamsrc_arprot, axil_streamsrc_awprot;
+	wire	[31:0]	axil_streamsrc_wdata;
+	wire	[3:0]	axil_streamsrc_wstrb;
+
+	// Verilator lint_on  UNUSED
+	// }}}
+	//
+	// AXI-lite slave definitions for bus axil,
+	// component streamcheck, with prefix axil_streamcheck
+	// {{{
+	// Verilator lint_off UNUSED
+	wire		axil_streamcheck_awready, axil_streamcheck_wready,
+			axil_streamcheck_arready;
+	wire		axil_streamcheck_bvalid, axil_streamcheck_rvalid;
+	wire	[1:0]	axil_streamcheck_bresp, axil_streamcheck_rresp;
+	wire	[31:0]	axil_streamcheck_rdata;
+
+	wire		axil_streamcheck_awvalid, axil_streamcheck_wvalid,
+			axil_streamcheck_arvalid,
+			axil_streamcheck_bready, axil_streamcheck_rready;
+	wire	[7:0]	axil_streamcheck_araddr, axil_streamcheck_awaddr;
+	wire	[2:0]	axil_streamcheck_arprot, axil_streamcheck_awprot;
+	wire	[31:0]	axil_streamcheck_wdata;
+	wire	[3:0]	axil_streamcheck_wstrb;
+
 	// Verilator lint_on  UNUSED
 	// }}}
 	// }}}
@@ -448,7 +550,7 @@ module	main(i_clk, i_reset,
 	wire		axi_wbu_awvalid;
 	wire		axi_wbu_awready;
 	wire	[2:0]	axi_wbu_awid;
-	wire	[24:0]	axi_wbu_awaddr;
+	wire	[33:0]	axi_wbu_awaddr;
 	wire	[7:0]	axi_wbu_awlen;
 	wire	[2:0]	axi_wbu_awsize;
 	wire	[1:0]	axi_wbu_awburst;
@@ -472,7 +574,7 @@ module	main(i_clk, i_reset,
 	wire		axi_wbu_arvalid;
 	wire		axi_wbu_arready;
 	wire	[2:0]	axi_wbu_arid;
-	wire	[24:0]	axi_wbu_araddr;
+	wire	[33:0]	axi_wbu_araddr;
 	wire	[7:0]	axi_wbu_arlen;
 	wire	[2:0]	axi_wbu_arsize;
 	wire	[1:0]	axi_wbu_arburst;
@@ -498,7 +600,7 @@ module	main(i_clk, i_reset,
 	wire		axi_dma_awvalid;
 	wire		axi_dma_awready;
 	wire	[2:0]	axi_dma_awid;
-	wire	[24:0]	axi_dma_awaddr;
+	wire	[33:0]	axi_dma_awaddr;
 	wire	[7:0]	axi_dma_awlen;
 	wire	[2:0]	axi_dma_awsize;
 	wire	[1:0]	axi_dma_awburst;
@@ -522,7 +624,7 @@ module	main(i_clk, i_reset,
 	wire		axi_dma_arvalid;
 	wire		axi_dma_arready;
 	wire	[2:0]	axi_dma_arid;
-	wire	[24:0]	axi_dma_araddr;
+	wire	[33:0]	axi_dma_araddr;
 	wire	[7:0]	axi_dma_arlen;
 	wire	[2:0]	axi_dma_arsize;
 	wire	[1:0]	axi_dma_arburst;
@@ -548,7 +650,7 @@ module	main(i_clk, i_reset,
 	wire		axi_mm2s_awvalid;
 	wire		axi_mm2s_awready;
 	wire	[2:0]	axi_mm2s_awid;
-	wire	[24:0]	axi_mm2s_awaddr;
+	wire	[33:0]	axi_mm2s_awaddr;
 	wire	[7:0]	axi_mm2s_awlen;
 	wire	[2:0]	axi_mm2s_awsize;
 	wire	[1:0]	axi_mm2s_awburst;
@@ -572,7 +674,7 @@ module	main(i_clk, i_reset,
 	wire		axi_mm2s_arvalid;
 	wire		axi_mm2s_arready;
 	wire	[2:0]	axi_mm2s_arid;
-	wire	[24:0]	axi_mm2s_araddr;
+	wire	[33:0]	axi_mm2s_araddr;
 	wire	[7:0]	axi_mm2s_arlen;
 	wire	[2:0]	axi_mm2s_arsize;
 	wire	[1:0]	axi_mm2s_arburst;
@@ -598,7 +700,7 @@ module	main(i_clk, i_reset,
 	wire		axi_s2mm_awvalid;
 	wire		axi_s2mm_awready;
 	wire	[2:0]	axi_s2mm_awid;
-	wire	[24:0]	axi_s2mm_awaddr;
+	wire	[33:0]	axi_s2mm_awaddr;
 	wire	[7:0]	axi_s2mm_awlen;
 	wire	[2:0]	axi_s2mm_awsize;
 	wire	[1:0]	axi_s2mm_awburst;
@@ -622,7 +724,7 @@ module	main(i_clk, i_reset,
 	wire		axi_s2mm_arvalid;
 	wire		axi_s2mm_arready;
 	wire	[2:0]	axi_s2mm_arid;
-	wire	[24:0]	axi_s2mm_araddr;
+	wire	[33:0]	axi_s2mm_araddr;
 	wire	[7:0]	axi_s2mm_arlen;
 	wire	[2:0]	axi_s2mm_arsize;
 	wire	[1:0]	axi_s2mm_arburst;
@@ -654,7 +756,7 @@ module	main(i_clk, i_reset,
 	wire		axi_controlbus_awvalid;
 	wire		axi_controlbus_awready;
 	wire	[2:0]	axi_controlbus_awid;
-	wire	[24:0]	axi_controlbus_awaddr;
+	wire	[33:0]	axi_controlbus_awaddr;
 	wire	[7:0]	axi_controlbus_awlen;
 	wire	[2:0]	axi_controlbus_awsize;
 	wire	[1:0]	axi_controlbus_awburst;
@@ -678,7 +780,7 @@ module	main(i_clk, i_reset,
 	wire		axi_controlbus_arvalid;
 	wire		axi_controlbus_arready;
 	wire	[2:0]	axi_controlbus_arid;
-	wire	[24:0]	axi_controlbus_araddr;
+	wire	[33:0]	axi_controlbus_araddr;
 	wire	[7:0]	axi_controlbus_arlen;
 	wire	[2:0]	axi_controlbus_arsize;
 	wire	[1:0]	axi_controlbus_arburst;
@@ -704,7 +806,7 @@ module	main(i_clk, i_reset,
 	wire		axi_axiram_awvalid;
 	wire		axi_axiram_awready;
 	wire	[2:0]	axi_axiram_awid;
-	wire	[24:0]	axi_axiram_awaddr;
+	wire	[33:0]	axi_axiram_awaddr;
 	wire	[7:0]	axi_axiram_awlen;
 	wire	[2:0]	axi_axiram_awsize;
 	wire	[1:0]	axi_axiram_awburst;
@@ -728,7 +830,7 @@ module	main(i_clk, i_reset,
 	wire		axi_axiram_arvalid;
 	wire		axi_axiram_arready;
 	wire	[2:0]	axi_axiram_arid;
-	wire	[24:0]	axi_axiram_araddr;
+	wire	[33:0]	axi_axiram_araddr;
 	wire	[7:0]	axi_axiram_arlen;
 	wire	[2:0]	axi_axiram_arsize;
 	wire	[1:0]	axi_axiram_arburst;
@@ -747,6 +849,56 @@ module	main(i_clk, i_reset,
 	wire	[1:0]	axi_axiram_rresp;
 	// Verilator lint_on  UNUSED
 	// }}}
+	// AXI4 slave definitions for bus axi,
+	// component axiram2, with prefix axi_axiram2
+	// {{{
+	// Verilator lint_off UNUSED
+	wire		axi_axiram2_awvalid;
+	wire		axi_axiram2_awready;
+	wire	[2:0]	axi_axiram2_awid;
+	wire	[33:0]	axi_axiram2_awaddr;
+	wire	[7:0]	axi_axiram2_awlen;
+	wire	[2:0]	axi_axiram2_awsize;
+	wire	[1:0]	axi_axiram2_awburst;
+	wire		axi_axiram2_awlock;
+	wire	[3:0]	axi_axiram2_awcache;
+	wire	[2:0]	axi_axiram2_awprot;
+	wire	[3:0]	axi_axiram2_awqos;
+	//
+	wire		axi_axiram2_wvalid;
+	wire		axi_axiram2_wready;
+	wire	[31:0]	axi_axiram2_wdata;
+
+	wire	[3:0]	axi_axiram2_wstrb;
+
+	wire		axi_axiram2_wlast;
+
+	wire		axi_axiram2_bvalid;
+	wire		axi_axiram2_bready;
+	wire	[2:0]	axi_axiram2_bid;
+	wire	[1:0]	axi_axiram2_bresp;
+	wire		axi_axiram2_arvalid;
+	wire		axi_axiram2_arready;
+	wire	[2:0]	axi_axiram2_arid;
+	wire	[33:0]	axi_axiram2_araddr;
+	wire	[7:0]	axi_axiram2_arlen;
+	wire	[2:0]	axi_axiram2_arsize;
+	wire	[1:0]	axi_axiram2_arburst;
+	wire		axi_axiram2_arlock;
+	wire	[3:0]	axi_axiram2_arcache;
+	wire	[2:0]	axi_axiram2_arprot;
+	wire	[3:0]	axi_axiram2_arqos;
+	//
+	wire		axi_axiram2_rvalid;
+	wire		axi_axiram2_rready;
+	wire	[2:0]	axi_axiram2_rid;
+	wire	[31:0]	axi_axiram2_rdata;
+
+	wire		axi_axiram2_rlast;
+
+	wire	[1:0]	axi_axiram2_rresp;
+	// Verilator lint_on  UNUSED
+	// }}}
 	// }}}
 	// }}}
 	////////////////////////////////////////////////////////////////////////
@@ -819,34 +971,38 @@ module	main(i_clk, i_reset,
 	// Some extra wires to capture combined values--values
 	// that will be the same across all slaves of the
 	// class
-	wire [6:0]	axil_diow_awaddr;
+	wire [7:0]	axil_diow_awaddr;
 	wire [2:0]	axil_diow_awprot;
 	wire [31:0]	axil_diow_wdata;
 	wire [3:0]	axil_diow_wstrb;
-	wire [6:0]	axil_diow_araddr;
+	wire [7:0]	axil_diow_araddr;
 	wire [2:0]	axil_diow_arprot;
 
 	axildouble #(
 		// {{{
-		.C_AXI_ADDR_WIDTH(7),
+		.C_AXI_ADDR_WIDTH(8),
 		.C_AXI_DATA_WIDTH(32),
-		.NS(4),
+		.NS(6),
 		.OPT_LOWPOWER(1'b1),
 		.SLAVE_ADDR({
-			// Address width    = 7
+			// Address width    = 8
 			// Address LSBs     = 0
-			{ 7'h60 }, //       s2mm: 0x60
-			{ 7'h40 }, //       mm2s: 0x40
-			{ 7'h20 }, //        dma: 0x20
-			{ 7'h00 }  // streamsink: 0x00
+			{ 8'hc0 }, // streamcheck: 0xc0
+			{ 8'ha0 }, //  streamsrc: 0xa0
+			{ 8'h80 }, //       s2mm: 0x80
+			{ 8'h60 }, //       mm2s: 0x60
+			{ 8'h40 }, //        dma: 0x40
+			{ 8'h00 }  // streamsink: 0x00
 		}),
 		.SLAVE_MASK({
-			// Address width    = 7
+			// Address width    = 8
 			// Address LSBs     = 0
-			{ 7'h60 }, //       s2mm
-			{ 7'h60 }, //       mm2s
-			{ 7'h60 }, //        dma
-			{ 7'h60 }  // streamsink
+			{ 8'he0 }, // streamcheck
+			{ 8'he0 }, //  streamsrc
+			{ 8'he0 }, //       s2mm
+			{ 8'he0 }, //       mm2s
+			{ 8'he0 }, //        dma
+			{ 8'hc0 }  // streamsink
 		})
 		// }}}
 	) axil_axildouble(
@@ -858,7 +1014,7 @@ module	main(i_clk, i_reset,
 		// {{{
 		.S_AXI_AWVALID(axil_controlbus_awvalid),
 		.S_AXI_AWREADY(axil_controlbus_awready),
-		.S_AXI_AWADDR( axil_controlbus_awaddr[6:0]),
+		.S_AXI_AWADDR( axil_controlbus_awaddr[7:0]),
 		.S_AXI_AWPROT( axil_controlbus_awprot),
 		//
 		.S_AXI_WVALID( axil_controlbus_wvalid),
@@ -873,7 +1029,7 @@ module	main(i_clk, i_reset,
 		// Read connections
 		.S_AXI_ARVALID(axil_controlbus_arvalid),
 		.S_AXI_ARREADY(axil_controlbus_arready),
-		.S_AXI_ARADDR( axil_controlbus_araddr[6:0]),
+		.S_AXI_ARADDR( axil_controlbus_araddr[7:0]),
 		.S_AXI_ARPROT( axil_controlbus_arprot),
 		//
 		.S_AXI_RVALID( axil_controlbus_rvalid),
@@ -884,6 +1040,8 @@ module	main(i_clk, i_reset,
 		// Connections to slaves
 		// {{{
 		.M_AXI_AWVALID({
+			axil_streamcheck_awvalid,
+			axil_streamsrc_awvalid,
 			axil_s2mm_awvalid,
 			axil_mm2s_awvalid,
 			axil_dma_awvalid,
@@ -896,6 +1054,8 @@ module	main(i_clk, i_reset,
 		//
 		//
 		.M_AXI_BRESP({
+			axil_streamcheck_bresp,
+			axil_streamsrc_bresp,
 			axil_s2mm_bresp,
 			axil_mm2s_bresp,
 			axil_dma_bresp,
@@ -903,6 +1063,8 @@ module	main(i_clk, i_reset,
 		}),
 		// Read connections
 		.M_AXI_ARVALID({
+			axil_streamcheck_arvalid,
+			axil_streamsrc_arvalid,
 			axil_s2mm_arvalid,
 			axil_mm2s_arvalid,
 			axil_dma_arvalid,
@@ -912,12 +1074,16 @@ module	main(i_clk, i_reset,
 		.M_AXI_ARPROT( axil_diow_arprot),
 		//
 		.M_AXI_RDATA({
+			axil_streamcheck_rdata,
+			axil_streamsrc_rdata,
 			axil_s2mm_rdata,
 			axil_mm2s_rdata,
 			axil_dma_rdata,
 			axil_streamsink_rdata
 		}),
 		.M_AXI_RRESP({
+			axil_streamcheck_rresp,
+			axil_streamsrc_rresp,
 			axil_s2mm_rresp,
 			axil_mm2s_rresp,
 			axil_dma_rresp,
@@ -930,6 +1096,30 @@ module	main(i_clk, i_reset,
 	//
 	// Now connecting the extra slaves wires to the AXILDOUBLE controller
 	//
+	// streamcheck
+	// {{{
+	assign axil_streamcheck_awaddr = axil_diow_awaddr;
+	assign axil_streamcheck_awprot = axil_diow_awprot;
+	assign axil_streamcheck_wvalid = axil_streamcheck_awvalid;
+	assign axil_streamcheck_wdata = axil_diow_wdata;
+	assign axil_streamcheck_wstrb = axil_diow_wstrb;
+	assign axil_streamcheck_bready = 1'b1;
+	assign axil_streamcheck_araddr = axil_diow_araddr;
+	assign axil_streamcheck_arprot = axil_diow_arprot;
+	assign axil_streamcheck_rready = 1'b1;
+	// }}}
+	// streamsrc
+	// {{{
+	assign axil_streamsrc_awaddr = axil_diow_awaddr;
+	assign axil_streamsrc_awprot = axil_diow_awprot;
+	assign axil_streamsrc_wvalid = axil_streamsrc_awvalid;
+	assign axil_streamsrc_wdata = axil_diow_wdata;
+	assign axil_streamsrc_wstrb = axil_diow_wstrb;
+	assign axil_streamsrc_bready = 1'b1;
+	assign axil_streamsrc_araddr = axil_diow_araddr;
+	assign axil_streamsrc_arprot = axil_diow_arprot;
+	assign axil_streamsrc_rready = 1'b1;
+	// }}}
 	// s2mm
 	// {{{
 	assign axil_s2mm_awaddr = axil_diow_awaddr;
@@ -998,21 +1188,23 @@ module	main(i_clk, i_reset,
 	//
 	axixbar #(
 		// {{{
-		.C_AXI_ADDR_WIDTH(25),
+		.C_AXI_ADDR_WIDTH(34),
 		.C_AXI_DATA_WIDTH(32),
 		.C_AXI_ID_WIDTH(3),
-		.NM(4), .NS(2),
+		.NM(4), .NS(3),
 		.SLAVE_ADDR({
-			// Address width    = 25
+			// Address width    = 34
 			// Address LSBs     = 0
-			{ 25'h1000000 }, //     axiram: 0x1000000
-			{ 25'h0800000 }  // controlbus: 0x0800000
+			{ 34'h200000000 }, //     axiram: 0x200000000
+			{ 34'h000800000 }, // controlbus: 0x000800000
+			{ 34'h000400000 }  //    axiram2: 0x000400000
 		}),
 		.SLAVE_MASK({
-			// Address width    = 25
+			// Address width    = 34
 			// Address LSBs     = 0
-			{ 25'h1000000 }, //     axiram
-			{ 25'h1800000 }  // controlbus
+			{ 34'h200000000 }, //     axiram
+			{ 34'h3ff800000 }, // controlbus
+			{ 34'h3ffc00000 }  //    axiram2
 		}),
 		.OPT_LOWPOWER(1'b1)
 		// }}}
@@ -1254,156 +1446,193 @@ module	main(i_clk, i_reset,
 		// {{{
 		.M_AXI_AWVALID({
 			axi_axiram_awvalid,
-			axi_controlbus_awvalid
+			axi_controlbus_awvalid,
+			axi_axiram2_awvalid
 		}),
 		.M_AXI_AWREADY({
 			axi_axiram_awready,
-			axi_controlbus_awready
+			axi_controlbus_awready,
+			axi_axiram2_awready
 		}),
 		.M_AXI_AWID({
 			axi_axiram_awid,
-			axi_controlbus_awid
+			axi_controlbus_awid,
+			axi_axiram2_awid
 		}),
 		.M_AXI_AWADDR({
 			axi_axiram_awaddr,
-			axi_controlbus_awaddr
+			axi_controlbus_awaddr,
+			axi_axiram2_awaddr
 		}),
 		.M_AXI_AWLEN({
 			axi_axiram_awlen,
-			axi_controlbus_awlen
+			axi_controlbus_awlen,
+			axi_axiram2_awlen
 		}),
 		.M_AXI_AWSIZE({
 			axi_axiram_awsize,
-			axi_controlbus_awsize
+			axi_controlbus_awsize,
+			axi_axiram2_awsize
 		}),
 		.M_AXI_AWBURST({
 			axi_axiram_awburst,
-			axi_controlbus_awburst
+			axi_controlbus_awburst,
+			axi_axiram2_awburst
 		}),
 		.M_AXI_AWLOCK({
 			axi_axiram_awlock,
-			axi_controlbus_awlock
+			axi_controlbus_awlock,
+			axi_axiram2_awlock
 		}),
 		.M_AXI_AWCACHE({
 			axi_axiram_awcache,
-			axi_controlbus_awcache
+			axi_controlbus_awcache,
+			axi_axiram2_awcache
 		}),
 		.M_AXI_AWPROT({
 			axi_axiram_awprot,
-			axi_controlbus_awprot
+			axi_controlbus_awprot,
+			axi_axiram2_awprot
 		}),
 		.M_AXI_AWQOS({
 			axi_axiram_awqos,
-			axi_controlbus_awqos
+			axi_controlbus_awqos,
+			axi_axiram2_awqos
 		}),
 		//
 		.M_AXI_WVALID({
 			axi_axiram_wvalid,
-			axi_controlbus_wvalid
+			axi_controlbus_wvalid,
+			axi_axiram2_wvalid
 		}),
 		.M_AXI_WREADY({
 			axi_axiram_wready,
-			axi_controlbus_wready
+			axi_controlbus_wready,
+			axi_axiram2_wready
 		}),
 		.M_AXI_WDATA({
 			axi_axiram_wdata,
-			axi_controlbus_wdata
+			axi_controlbus_wdata,
+			axi_axiram2_wdata
 		}),
 		.M_AXI_WSTRB({
 			axi_axiram_wstrb,
-			axi_controlbus_wstrb
+			axi_controlbus_wstrb,
+			axi_axiram2_wstrb
 		}),
 		.M_AXI_WLAST({
 			axi_axiram_wlast,
-			axi_controlbus_wlast
+			axi_controlbus_wlast,
+			axi_axiram2_wlast
 		}),
 		//
 		.M_AXI_BVALID({
 			axi_axiram_bvalid,
-			axi_controlbus_bvalid
+			axi_controlbus_bvalid,
+			axi_axiram2_bvalid
 		}),
 		.M_AXI_BREADY({
 			axi_axiram_bready,
-			axi_controlbus_bready
+			axi_controlbus_bready,
+			axi_axiram2_bready
 		}),
 		.M_AXI_BID({
 			axi_axiram_bid,
-			axi_controlbus_bid
+			axi_controlbus_bid,
+			axi_axiram2_bid
 		}),
 		.M_AXI_BRESP({
 			axi_axiram_bresp,
-			axi_controlbus_bresp
+			axi_controlbus_bresp,
+			axi_axiram2_bresp
 		}),
 		//
 		// Read connections
 		.M_AXI_ARVALID({
 			axi_axiram_arvalid,
-			axi_controlbus_arvalid
+			axi_controlbus_arvalid,
+			axi_axiram2_arvalid
 		}),
 		.M_AXI_ARREADY({
 			axi_axiram_arready,
-			axi_controlbus_arready
+			axi_controlbus_arready,
+			axi_axiram2_arready
 		}),
 		.M_AXI_ARID({
 			axi_axiram_arid,
-			axi_controlbus_arid
+			axi_controlbus_arid,
+			axi_axiram2_arid
 		}),
 		.M_AXI_ARADDR({
 			axi_axiram_araddr,
-			axi_controlbus_araddr
+			axi_controlbus_araddr,
+			axi_axiram2_araddr
 		}),
 		.M_AXI_ARLEN({
 			axi_axiram_arlen,
-			axi_controlbus_arlen
+			axi_controlbus_arlen,
+			axi_axiram2_arlen
 		}),
 		.M_AXI_ARSIZE({
 			axi_axiram_arsize,
-			axi_controlbus_arsize
+			axi_controlbus_arsize,
+			axi_axiram2_arsize
 		}),
 		.M_AXI_ARBURST({
 			axi_axiram_arburst,
-			axi_controlbus_arburst
+			axi_controlbus_arburst,
+			axi_axiram2_arburst
 		}),
 		.M_AXI_ARLOCK({
 			axi_axiram_arlock,
-			axi_controlbus_arlock
+			axi_controlbus_arlock,
+			axi_axiram2_arlock
 		}),
 		.M_AXI_ARCACHE({
 			axi_axiram_arcache,
-			axi_controlbus_arcache
+			axi_controlbus_arcache,
+			axi_axiram2_arcache
 		}),
 		.M_AXI_ARPROT({
 			axi_axiram_arprot,
-			axi_controlbus_arprot
+			axi_controlbus_arprot,
+			axi_axiram2_arprot
 		}),
 		.M_AXI_ARQOS({
 			axi_axiram_arqos,
-			axi_controlbus_arqos
+			axi_controlbus_arqos,
+			axi_axiram2_arqos
 		}),
 		//
 		.M_AXI_RVALID({
 			axi_axiram_rvalid,
-			axi_controlbus_rvalid
+			axi_controlbus_rvalid,
+			axi_axiram2_rvalid
 		}),
 		.M_AXI_RREADY({
 			axi_axiram_rready,
-			axi_controlbus_rready
+			axi_controlbus_rready,
+			axi_axiram2_rready
 		}),
 		.M_AXI_RID({
 			axi_axiram_rid,
-			axi_controlbus_rid
+			axi_controlbus_rid,
+			axi_axiram2_rid
 		}),
 		.M_AXI_RDATA({
 			axi_axiram_rdata,
-			axi_controlbus_rdata
+			axi_controlbus_rdata,
+			axi_axiram2_rdata
 		}),
 		.M_AXI_RLAST({
 			axi_axiram_rlast,
-			axi_controlbus_rlast
+			axi_controlbus_rlast,
+			axi_axiram2_rlast
 		}),
 		.M_AXI_RRESP({
 			axi_axiram_rresp,
-			axi_controlbus_rresp
+			axi_controlbus_rresp,
+			axi_axiram2_rresp
 		})
 		// }}}
 		// }}}
@@ -1459,7 +1688,7 @@ module	main(i_clk, i_reset,
 	// Convert from AXI-lite to AXI
 	axilite2axi #(
 		// {{{
-		.C_AXI_ADDR_WIDTH(25),
+		.C_AXI_ADDR_WIDTH(34),
 		.C_AXI_DATA_WIDTH(32),
 		.C_AXI_ID_WIDTH(3),
 		.C_AXI_WRITE_ID(3'b100),
@@ -1500,7 +1729,7 @@ module	main(i_clk, i_reset,
 		.M_AXI_AWVALID(wbu_vibus_awvalid),
 		.M_AXI_AWREADY(wbu_vibus_awready),
 		.M_AXI_AWID(   wbu_vibus_awid),
-		.M_AXI_AWADDR( wbu_vibus_awaddr[25-1:0]),
+		.M_AXI_AWADDR( wbu_vibus_awaddr[34-1:0]),
 		.M_AXI_AWLEN(  wbu_vibus_awlen),
 		.M_AXI_AWSIZE( wbu_vibus_awsize),
 		.M_AXI_AWBURST(wbu_vibus_awburst),
@@ -1523,7 +1752,7 @@ module	main(i_clk, i_reset,
 		.M_AXI_ARVALID(wbu_vibus_arvalid),
 		.M_AXI_ARREADY(wbu_vibus_arready),
 		.M_AXI_ARID(   wbu_vibus_arid),
-		.M_AXI_ARADDR( wbu_vibus_araddr[25-1:0]),
+		.M_AXI_ARADDR( wbu_vibus_araddr[34-1:0]),
 		.M_AXI_ARLEN(  wbu_vibus_arlen),
 		.M_AXI_ARSIZE( wbu_vibus_arsize),
 		.M_AXI_ARBURST(wbu_vibus_arburst),
@@ -1548,7 +1777,30 @@ module	main(i_clk, i_reset,
 	// Streamsink (streamcounter) : streamsink
 	// {{{
 	//
+
+	// Latency is measured from the completion of any write to the MM2S
+	// control register that sets its start bit.  The address and data
+	// may be accepted on different clocks, so each is noted as it's
+	// accepted, and the two are joined at the write's response.
+	initial	streamsink_start_aw = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		streamsink_start_aw <= 1'b0;
+	else if (axil_mm2s_awvalid && axil_mm2s_awready)
+		streamsink_start_aw <= (axil_mm2s_awaddr[4:2] == 3'h0);
+
+	initial	streamsink_start_w = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		streamsink_start_w <= 1'b0;
+	else if (axil_mm2s_wvalid && axil_mm2s_wready)
+		streamsink_start_w <= axil_mm2s_wstrb[3] && axil_mm2s_wdata[31];
+
+	assign	streamsink_start = axil_mm2s_bvalid && axil_mm2s_bready
+			&& streamsink_start_aw && streamsink_start_w;
+
 	streamcounter #(
+		.C_AXI_ADDR_WIDTH(6),
 		.C_AXIS_DATA_WIDTH(32),
 		.OPT_LOWPOWER(1'b1)
 	) streamsinki (
@@ -1560,9 +1812,11 @@ module	main(i_clk, i_reset,
 		.S_AXIS_TDATA(streamsink_tdata),
 		.S_AXIS_TLAST(streamsink_tlast),
 		//
+		.i_start(streamsink_start),
+		//
 		.S_AXI_AWVALID(axil_streamsink_awvalid),
 		.S_AXI_AWREADY(axil_streamsink_awready),
-		.S_AXI_AWADDR( axil_streamsink_awaddr[4-1:0]),
+		.S_AXI_AWADDR( axil_streamsink_awaddr[6-1:0]),
 		.S_AXI_AWPROT( axil_streamsink_awprot),
 //
 		.S_AXI_WVALID(axil_streamsink_wvalid),
@@ -1576,7 +1830,7 @@ module	main(i_clk, i_reset,
 		// Read connections
 		.S_AXI_ARVALID(axil_streamsink_arvalid),
 		.S_AXI_ARREADY(axil_streamsink_arready),
-		.S_AXI_ARADDR( axil_streamsink_araddr[4-1:0]),
+		.S_AXI_ARADDR( axil_streamsink_araddr[6-1:0]),
 		.S_AXI_ARPROT( axil_streamsink_arprot),
 //
 		.S_AXI_RVALID(axil_streamsink_rvalid),
@@ -1591,10 +1845,11 @@ module	main(i_clk, i_reset,
 	// AXI to AXI-lite conversion for the controlbus
 	// {{{
 	//
-	axi2axilite #(
+	axi2axilsub #(
 		// {{{
-		.C_AXI_ADDR_WIDTH(7),
-		.C_AXI_DATA_WIDTH(32),
+		.C_AXI_ADDR_WIDTH(8),
+		.C_S_AXI_DATA_WIDTH(32),
+		.C_M_AXI_DATA_WIDTH(32),
 		.C_AXI_ID_WIDTH(3)
 		// }}}
 	) controlbusi (
@@ -1606,7 +1861,7 @@ module	main(i_clk, i_reset,
 		.S_AXI_AWVALID(axi_controlbus_awvalid),
 		.S_AXI_AWREADY(axi_controlbus_awready),
 		.S_AXI_AWID(   axi_controlbus_awid),
-		.S_AXI_AWADDR( axi_controlbus_awaddr[7-1:0]),
+		.S_AXI_AWADDR( axi_controlbus_awaddr[8-1:0]),
 		.S_AXI_AWLEN(  axi_controlbus_awlen),
 		.S_AXI_AWSIZE( axi_controlbus_awsize),
 		.S_AXI_AWBURST(axi_controlbus_awburst),
@@ -1629,7 +1884,7 @@ module	main(i_clk, i_reset,
 		.S_AXI_ARVALID(axi_controlbus_arvalid),
 		.S_AXI_ARREADY(axi_controlbus_arready),
 		.S_AXI_ARID(   axi_controlbus_arid),
-		.S_AXI_ARADDR( axi_controlbus_araddr[7-1:0]),
+		.S_AXI_ARADDR( axi_controlbus_araddr[8-1:0]),
 		.S_AXI_ARLEN(  axi_controlbus_arlen),
 		.S_AXI_ARSIZE( axi_controlbus_arsize),
 		.S_AXI_ARBURST(axi_controlbus_arburst),
@@ -1649,7 +1904,7 @@ module	main(i_clk, i_reset,
 		// {{{
 		.M_AXI_AWVALID(axil_controlbus_awvalid),
 		.M_AXI_AWREADY(axil_controlbus_awready),
-		.M_AXI_AWADDR( axil_controlbus_awaddr[7-1:0]),
+		.M_AXI_AWADDR( axil_controlbus_awaddr[8-1:0]),
 		.M_AXI_AWPROT( axil_controlbus_awprot),
 		//
 		.M_AXI_WVALID(axil_controlbus_wvalid),
@@ -1663,7 +1918,7 @@ module	main(i_clk, i_reset,
 		// Read connections
 		.M_AXI_ARVALID(axil_controlbus_arvalid),
 		.M_AXI_ARREADY(axil_controlbus_arready),
-		.M_AXI_ARADDR( axil_controlbus_araddr[7-1:0]),
+		.M_AXI_ARADDR( axil_controlbus_araddr[8-1:0]),
 		.M_AXI_ARPROT( axil_controlbus_arprot),
 //
 		.M_AXI_RVALID(axil_controlbus_rvalid),
@@ -1676,29 +1931,143 @@ module	main(i_clk, i_reset,
 	// }}}
 	////////////////////////////////////////////////////////////////////////
 	//
-	// AXI streamsrc : streamsrc
+	// AXI streamsrc (streamsource) : streamsrc
 	// {{{
 	//
-	always @(posedge i_clk)
-	if (i_reset)
-		streamsrc_tvalid <= 0;
-	else
-		streamsrc_tvalid <= 1;
+	streamsource #(
+		.C_AXI_ADDR_WIDTH(5),
+		.C_AXIS_DATA_WIDTH(32),
+		.OPT_LOWPOWER(1'b1)
+	) streamsrci (
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.M_AXIS_TVALID(streamsrc_tvalid),
+		.M_AXIS_TREADY(streamsrc_tready),
+		.M_AXIS_TDATA(streamsrc_tdata),
+		.M_AXIS_TLAST(streamsrc_tlast),
+		//
+		.S_AXI_AWVALID(axil_streamsrc_awvalid),
+		.S_AXI_AWREADY(axil_streamsrc_awready),
+		.S_AXI_AWADDR( axil_streamsrc_awaddr[5-1:0]),
+		.S_AXI_AWPROT( axil_streamsrc_awprot),
+//
+		.S_AXI_WVALID(axil_streamsrc_wvalid),
+		.S_AXI_WREADY(axil_streamsrc_wready),
+		.S_AXI_WDATA( axil_streamsrc_wdata),
+		.S_AXI_WSTRB( axil_streamsrc_wstrb),
+//
+		.S_AXI_BVALID(axil_streamsrc_bvalid),
+		.S_AXI_BREADY(axil_streamsrc_bready),
+		.S_AXI_BRESP( axil_streamsrc_bresp),
+		// Read connections
+		.S_AXI_ARVALID(axil_streamsrc_arvalid),
+		.S_AXI_ARREADY(axil_streamsrc_arready),
+		.S_AXI_ARADDR( axil_streamsrc_araddr[5-1:0]),
+		.S_AXI_ARPROT( axil_streamsrc_arprot),
+//
+		.S_AXI_RVALID(axil_streamsrc_rvalid),
+		.S_AXI_RREADY(axil_streamsrc_rready),
+		.S_AXI_RDATA( axil_streamsrc_rdata),
+		.S_AXI_RRESP( axil_streamsrc_rresp)
+	);
 
-	always @(*)
-		streamsrc_tlast = 1;
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Stream data checker (streamcheck) : streamcheck
+	// {{{
+	//
+	streamcheck #(
+		.C_AXI_ADDR_WIDTH(5),
+		.C_AXIS_DATA_WIDTH(32),
+		.OPT_LOWPOWER(1'b1)
+	) streamchecki (
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.S_AXIS_TVALID(streamsink_tvalid),
+		.S_AXIS_TREADY(streamsink_tready),
+		.S_AXIS_TDATA(streamsink_tdata),
+		.S_AXIS_TLAST(streamsink_tlast),
+		//
+		.S_AXI_AWVALID(axil_streamcheck_awvalid),
+		.S_AXI_AWREADY(axil_streamcheck_awready),
+		.S_AXI_AWADDR( axil_streamcheck_awaddr[5-1:0]),
+		.S_AXI_AWPROT( axil_streamcheck_awprot),
+//
+		.S_AXI_WVALID(axil_streamcheck_wvalid),
+		.S_AXI_WREADY(axil_streamcheck_wready),
+		.S_AXI_WDATA( axil_streamcheck_wdata),
+		.S_AXI_WSTRB( axil_streamcheck_wstrb),
+//
+		.S_AXI_BVALID(axil_streamcheck_bvalid),
+		.S_AXI_BREADY(axil_streamcheck_bready),
+		.S_AXI_BRESP( axil_streamcheck_bresp),
+		// Read connections
+		.S_AXI_ARVALID(axil_streamcheck_arvalid),
+		.S_AXI_ARREADY(axil_streamcheck_arready),
+		.S_AXI_ARADDR( axil_streamcheck_araddr[5-1:0]),
+		.S_AXI_ARPROT( axil_streamcheck_arprot),
+//
+		.S_AXI_RVALID(axil_streamcheck_rvalid),
+		.S_AXI_RREADY(axil_streamcheck_rready),
+		.S_AXI_RDATA( axil_streamcheck_rdata),
+		.S_AXI_RRESP( axil_streamcheck_rresp)
+	);
 
-	initial	streamsrc_counter = 0;
-	always @(posedge i_clk)
-	if (i_reset)
-		streamsrc_counter <= 0;
-	else
-		streamsrc_counter <= streamsrc_counter + 1;
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// QoS gates : qos
+	// {{{
+	//
 
-	always @(posedge i_clk)
-	if (!streamsrc_tvalid || streamsrc_tready)
-		streamsrc_tdata <= streamsrc_counter;
+	initial	qos_mm2s_ar = 4'h0;
+	initial	qos_s2mm_aw = 4'h0;
+	initial	qos_dma_ar  = 4'h0;
+	initial	qos_dma_aw  = 4'h0;
+
+	// Reads: the DMA vs the MM2S
+	// {{{
+	qosgate #(
+		.NM(2)
+	) qos_rdgate (
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.i_qos({ qos_dma_ar, qos_mm2s_ar }),
+		//
+		.S_VALID({ dma_arvalid, mm2s_arvalid }),
+		.S_READY({ dma_arready, mm2s_arready }),
+		//
+		.M_VALID({ axi_dma_arvalid, axi_mm2s_arvalid }),
+		.M_READY({ axi_dma_arready, axi_mm2s_arready })
+	);
+	// }}}
 
+	// Writes: the DMA vs the S2MM
+	// {{{
+	qosgate #(
+		.NM(2)
+	) qos_wrgate (
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.i_qos({ qos_dma_aw, qos_s2mm_aw }),
+		//
+		.S_VALID({ dma_awvalid, s2mm_awvalid }),
+		.S_READY({ dma_awready, s2mm_awready }),
+		//
+		.M_VALID({ axi_dma_awvalid, axi_s2mm_awvalid }),
+		.M_READY({ axi_dma_awready, axi_s2mm_awready })
+	);
+	// }}}
+
+	assign	axi_mm2s_arqos = qos_mm2s_ar;
+	assign	axi_s2mm_awqos = qos_s2mm_aw;
+	assign	axi_dma_arqos  = qos_dma_ar;
+	assign	axi_dma_awqos  = qos_dma_aw;
 	// }}}
 `ifdef	WBUBUS_MASTER
 	// {{{
@@ -1709,7 +2078,7 @@ module	main(i_clk, i_reset,
 	assign  axi_wbu_awvalid  = wbu_wbu_awvalid;
 	assign  wbu_wbu_awready = axi_wbu_awready;
 	assign  axi_wbu_awid     = wbu_wbu_awid;
-	assign  axi_wbu_awaddr   = wbu_wbu_awaddr[25-1:0];
+	assign  axi_wbu_awaddr   = wbu_wbu_awaddr[34-1:0];
 	assign  axi_wbu_awlen    = wbu_wbu_awlen;
 	assign  axi_wbu_awsize   = wbu_wbu_awsize;
 	assign  axi_wbu_awburst  = wbu_wbu_awburst;
@@ -1732,7 +2101,7 @@ module	main(i_clk, i_reset,
 	assign  axi_wbu_arvalid  = wbu_wbu_arvalid;
 	assign  wbu_wbu_arready = axi_wbu_arready;
 	assign  axi_wbu_arid     = wbu_wbu_arid;
-	assign  axi_wbu_araddr   = wbu_wbu_araddr[25-1:0];
+	assign  axi_wbu_araddr   = wbu_wbu_araddr[34-1:0];
 	assign  axi_wbu_arlen    = wbu_wbu_arlen;
 	assign  axi_wbu_arsize   = wbu_wbu_arsize;
 	assign  axi_wbu_arburst  = wbu_wbu_arburst;
@@ -1766,9 +2135,116 @@ module	main(i_clk, i_reset,
 	// AXI RAM
 	// {{{
 	//
+	// Out of order read responses, if the simulation asks for them (see
+	// sim/reordersim.h)
+	axireorder #(
+		// {{{
+		.C_AXI_ID_WIDTH(3),
+		.DW(33+25),
+		.OPT_WRITE(1'b0)
+		// }}}
+	) axiram_arorder (
+		// {{{
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.S_VALID(axi_axiram_arvalid),
+		.S_READY(axi_axiram_arready),
+		.S_ID(   axi_axiram_arid),
+		.S_DATA({ axi_axiram_araddr[33-1:0],
+			axi_axiram_arlen, axi_axiram_arsize,
+			axi_axiram_arburst, axi_axiram_arlock,
+			axi_axiram_arcache, axi_axiram_arprot,
+			axi_axiram_arqos }),
+		//
+		.M_VALID(axiram_xarvalid),
+		.M_READY(axiram_xarready),
+		.M_ID(   axiram_xarid),
+		.M_DATA({ axiram_xaraddr, axiram_xarlen, axiram_xarsize,
+			axiram_xarburst, axiram_xarlock, axiram_xarcache,
+			axiram_xarprot, axiram_xarqos })
+		// }}}
+	);
+
+	//
+	// DRAM timing, if the simulation asks for it (see sim/dramsim.h)
+	memtiming #(
+		// {{{
+		.C_AXI_ID_WIDTH(3),
+		.C_AXI_ADDR_WIDTH(33),
+		.OPT_WRITE(1'b0)
+		// }}}
+	) axiram_artime (
+		// {{{
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.S_AXI_AVALID(axiram_xarvalid),
+		.S_AXI_AREADY(axiram_xarready),
+		.S_AXI_AID(   axiram_xarid),
+		.S_AXI_AADDR( axiram_xaraddr),
+		.S_AXI_ALEN(  axiram_xarlen),
+		.S_AXI_ASIZE( axiram_xarsize),
+		.S_AXI_ABURST(axiram_xarburst),
+		.S_AXI_ALOCK( axiram_xarlock),
+		.S_AXI_ACACHE(axiram_xarcache),
+		.S_AXI_APROT( axiram_xarprot),
+		.S_AXI_AQOS(  axiram_xarqos),
+		//
+		.M_AXI_AVALID(axiram_arvalid),
+		.M_AXI_AREADY(axiram_arready),
+		.M_AXI_AID(   axiram_arid),
+		.M_AXI_AADDR( axiram_araddr),
+		.M_AXI_ALEN(  axiram_arlen),
+		.M_AXI_ASIZE( axiram_arsize),
+		.M_AXI_ABURST(axiram_arburst),
+		.M_AXI_ALOCK( axiram_arlock),
+		.M_AXI_ACACHE(axiram_arcache),
+		.M_AXI_APROT( axiram_arprot),
+		.M_AXI_AQOS(  axiram_arqos)
+		// }}}
+	);
+
+	memtiming #(
+		// {{{
+		.C_AXI_ID_WIDTH(3),
+		.C_AXI_ADDR_WIDTH(33),
+		.OPT_WRITE(1'b1)
+		// }}}
+	) axiram_awtime (
+		// {{{
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.S_AXI_AVALID(axi_axiram_awvalid),
+		.S_AXI_AREADY(axi_axiram_awready),
+		.S_AXI_AID(   axi_axiram_awid),
+		.S_AXI_AADDR( axi_axiram_awaddr[33-1:0]),
+		.S_AXI_ALEN(  axi_axiram_awlen),
+		.S_AXI_ASIZE( axi_axiram_awsize),
+		.S_AXI_ABURST(axi_axiram_awburst),
+		.S_AXI_ALOCK( axi_axiram_awlock),
+		.S_AXI_ACACHE(axi_axiram_awcache),
+		.S_AXI_APROT( axi_axiram_awprot),
+		.S_AXI_AQOS(  axi_axiram_awqos),
+		//
+		.M_AXI_AVALID(axiram_awvalid),
+		.M_AXI_AREADY(axiram_awready),
+		.M_AXI_AID(   axiram_awid),
+		.M_AXI_AADDR( axiram_awaddr),
+		.M_AXI_ALEN(  axiram_awlen),
+		.M_AXI_ASIZE( axiram_awsize),
+		.M_AXI_ABURST(axiram_awburst),
+		.M_AXI_ALOCK( axiram_awlock),
+		.M_AXI_ACACHE(axiram_awcache),
+		.M_AXI_APROT( axiram_awprot),
+		.M_AXI_AQOS(  axiram_awqos)
+		// }}}
+	);
+
 	demofull #(
 		// {{{
-		.C_S_AXI_ADDR_WIDTH(24),
+		.C_S_AXI_ADDR_WIDTH(33),
 		.C_S_AXI_DATA_WIDTH(32),
 		.C_S_AXI_ID_WIDTH(3)
 		// }}}
@@ -1785,17 +2261,17 @@ module	main(i_clk, i_reset,
 		.o_raddr(axiram_raddr),
 		.i_rdata(axiram_rdata),
 		//
-		.S_AXI_AWVALID(axi_axiram_awvalid),
-		.S_AXI_AWREADY(axi_axiram_awready),
-		.S_AXI_AWID(   axi_axiram_awid),
-		.S_AXI_AWADDR( axi_axiram_awaddr[24-1:0]),
-		.S_AXI_AWLEN(  axi_axiram_awlen),
-		.S_AXI_AWSIZE( axi_axiram_awsize),
-		.S_AXI_AWBURST(axi_axiram_awburst),
-		.S_AXI_AWLOCK( axi_axiram_awlock),
-		.S_AXI_AWCACHE(axi_axiram_awcache),
-		.S_AXI_AWPROT( axi_axiram_awprot),
-		.S_AXI_AWQOS(  axi_axiram_awqos),
+		.S_AXI_AWVALID(axiram_awvalid),
+		.S_AXI_AWREADY(axiram_awready),
+		.S_AXI_AWID(   axiram_awid),
+		.S_AXI_AWADDR( axiram_awaddr),
+		.S_AXI_AWLEN(  axiram_awlen),
+		.S_AXI_AWSIZE( axiram_awsize),
+		.S_AXI_AWBURST(axiram_awburst),
+		.S_AXI_AWLOCK( axiram_awlock),
+		.S_AXI_AWCACHE(axiram_awcache),
+		.S_AXI_AWPROT( axiram_awprot),
+		.S_AXI_AWQOS(  axiram_awqos),
 		//
 		.S_AXI_WVALID(axi_axiram_wvalid),
 		.S_AXI_WREADY(axi_axiram_wready),
@@ -1803,47 +2279,230 @@ module	main(i_clk, i_reset,
 		.S_AXI_WSTRB( axi_axiram_wstrb),
 		.S_AXI_WLAST( axi_axiram_wlast),
 		//
-		.S_AXI_BVALID(axi_axiram_bvalid),
-		.S_AXI_BREADY(axi_axiram_bready),
-		.S_AXI_BID(   axi_axiram_bid),
-		.S_AXI_BRESP( axi_axiram_bresp),
+		.S_AXI_BVALID(axiram_xbvalid),
+		.S_AXI_BREADY(axiram_xbready),
+		.S_AXI_BID(   axiram_xbid),
+		.S_AXI_BRESP( axiram_mbresp),
 		// Read connections
-		.S_AXI_ARVALID(axi_axiram_arvalid),
-		.S_AXI_ARREADY(axi_axiram_arready),
-		.S_AXI_ARID(   axi_axiram_arid),
-		.S_AXI_ARADDR( axi_axiram_araddr[24-1:0]),
-		.S_AXI_ARLEN(  axi_axiram_arlen),
-		.S_AXI_ARSIZE( axi_axiram_arsize),
-		.S_AXI_ARBURST(axi_axiram_arburst),
-		.S_AXI_ARLOCK( axi_axiram_arlock),
-		.S_AXI_ARCACHE(axi_axiram_arcache),
-		.S_AXI_ARPROT( axi_axiram_arprot),
-		.S_AXI_ARQOS(  axi_axiram_arqos),
-//
+		.S_AXI_ARVALID(axiram_arvalid),
+		.S_AXI_ARREADY(axiram_arready),
+		.S_AXI_ARID(   axiram_arid),
+		.S_AXI_ARADDR( axiram_araddr),
+		.S_AXI_ARLEN(  axiram_arlen),
+		.S_AXI_ARSIZE( axiram_arsize),
+		.S_AXI_ARBURST(axiram_arburst),
+		.S_AXI_ARLOCK( axiram_arlock),
+		.S_AXI_ARCACHE(axiram_arcache),
+		.S_AXI_ARPROT( axiram_arprot),
+		.S_AXI_ARQOS(  axiram_arqos),
+		//
 		.S_AXI_RVALID(axi_axiram_rvalid),
 		.S_AXI_RREADY(axi_axiram_rready),
 		.S_AXI_RID(   axi_axiram_rid),
 		.S_AXI_RDATA( axi_axiram_rdata),
 		.S_AXI_RLAST( axi_axiram_rlast),
-		.S_AXI_RRESP( axi_axiram_rresp)
+		.S_AXI_RRESP( axiram_rresp)
+		// }}}
+	);
+
+	//
+	// Bus errors, on any bursts the simulation chooses (see sim/errsim.h)
+	errinject #(
+		// {{{
+		.C_AXI_ADDR_WIDTH(33),
+		.OPT_WRITE(1'b0)
+		// }}}
+	) axiram_rerr (
+		// {{{
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.i_request(axiram_arvalid && axiram_arready),
+		.i_addr(   axiram_araddr),
+		.i_len(    axiram_arlen),
+		//
+		.i_last(axi_axiram_rvalid && axi_axiram_rready && axi_axiram_rlast),
+		.i_resp(axiram_rresp),
+		.o_resp(axi_axiram_rresp)
+		// }}}
+	);
+
+	errinject #(
+		// {{{
+		.C_AXI_ADDR_WIDTH(33),
+		.OPT_WRITE(1'b1)
+		// }}}
+	) axiram_werr (
+		// {{{
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.i_request(axiram_awvalid && axiram_awready),
+		.i_addr(   axiram_awaddr),
+		.i_len(    axiram_awlen),
+		//
+		.i_last(axiram_xbvalid && axiram_xbready),
+		.i_resp(axiram_mbresp),
+		.o_resp(axiram_xbresp)
+		// }}}
+	);
+
+	//
+	// Out of order write responses, if the simulation asks for them
+	axireorder #(
+		// {{{
+		.C_AXI_ID_WIDTH(3),
+		.DW(2),
+		.OPT_WRITE(1'b1)
+		// }}}
+	) axiram_border (
+		// {{{
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.S_VALID(axiram_xbvalid),
+		.S_READY(axiram_xbready),
+		.S_ID(   axiram_xbid),
+		.S_DATA( axiram_xbresp),
+		//
+		.M_VALID(axi_axiram_bvalid),
+		.M_READY(axi_axiram_bready),
+		.M_ID(   axi_axiram_bid),
+		.M_DATA( axi_axiram_bresp)
 		// }}}
 	);
 
 	// The companion SRAM implementation itself
 	// {{{
+`ifdef	AXIRAM_SPARSE
+	// A sparse, paged, memory kept in C++, 32-bits at a time
+	import "DPI-C" function int sparsemem_read(input longint addr);
+	import "DPI-C" function void sparsemem_write(input longint addr,
+			input int data, input int strb);
+
+	assign	axiram_wbyte = { {(64-33){1'b0}}, axiram_waddr,
+				{($clog2(32/8)){1'b0}} };
+	assign	axiram_rbyte = { {(64-33){1'b0}}, axiram_raddr,
+				{($clog2(32/8)){1'b0}} };
+
+	// Reads come first, so a read and a write of the same address on the
+	// same clock return the old value, just as the dense array would
+	always @(posedge i_clk)
+	begin
+		if (axiram_rd)
+		for(axiram_ik=0; axiram_ik < 32/32;
+				axiram_ik = axiram_ik + 1)
+			axiram_rdata[axiram_ik*32 +: 32]
+				<= sparsemem_read(axiram_rbyte
+					+ { 32'h0, 4*axiram_ik });
+
+		if (axiram_we)
+		for(axiram_ik=0; axiram_ik < 32/32;
+				axiram_ik = axiram_ik + 1)
+		if (|axiram_wstrb[axiram_ik*4 +: 4])
+			sparsemem_write(axiram_wbyte + { 32'h0, 4*axiram_ik },
+				axiram_wdata[axiram_ik*32 +: 32],
+				{ 28'h0, axiram_wstrb[axiram_ik*4 +: 4] });
+	end
+`else
 	always @(posedge i_clk)
 	if (axiram_we)
 	for(axiram_ik=0; axiram_ik < 32/8;
 			axiram_ik = axiram_ik + 1)
 	begin
 		if (axiram_wstrb[axiram_ik])
-			axiram_mem[axiram_waddr][axiram_ik*8 +: 8] <= axiram_wdata[axiram_ik*8 +: 8];
+			axiram_mem[axiram_waddr[24-$clog2(32/8)-1:0]][axiram_ik*8 +: 8] <= axiram_wdata[axiram_ik*8 +: 8];
 	end
 
 	always @(posedge i_clk)
 	if (axiram_rd)
-		axiram_rdata <= axiram_mem[axiram_raddr];
+		axiram_rdata <= axiram_mem[axiram_raddr[24-$clog2(32/8)-1:0]];
 
+`endif
+	// }}}
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Second AXI RAM
+	// {{{
+	//
+	demofull #(
+		// {{{
+		.C_S_AXI_ADDR_WIDTH(22),
+		.C_S_AXI_DATA_WIDTH(32),
+		.C_S_AXI_ID_WIDTH(3)
+		// }}}
+	) axiram2i (
+		// {{{
+		.S_AXI_ACLK(i_clk),
+		.S_AXI_ARESETN(!i_reset),
+		//
+		.o_we(axiram2_we),
+		.o_waddr(axiram2_waddr),
+		.o_wdata(axiram2_wdata),
+		.o_wstrb(axiram2_wstrb),
+		.o_rd(axiram2_rd),
+		.o_raddr(axiram2_raddr),
+		.i_rdata(axiram2_rdata),
+		//
+		.S_AXI_AWVALID(axi_axiram2_awvalid),
+		.S_AXI_AWREADY(axi_axiram2_awready),
+		.S_AXI_AWID(   axi_axiram2_awid),
+		.S_AXI_AWADDR( axi_axiram2_awaddr[22-1:0]),
+		.S_AXI_AWLEN(  axi_axiram2_awlen),
+		.S_AXI_AWSIZE( axi_axiram2_awsize),
+		.S_AXI_AWBURST(axi_axiram2_awburst),
+		.S_AXI_AWLOCK( axi_axiram2_awlock),
+		.S_AXI_AWCACHE(axi_axiram2_awcache),
+		.S_AXI_AWPROT( axi_axiram2_awprot),
+		.S_AXI_AWQOS(  axi_axiram2_awqos),
+		//
+		.S_AXI_WVALID(axi_axiram2_wvalid),
+		.S_AXI_WREADY(axi_axiram2_wready),
+		.S_AXI_WDATA( axi_axiram2_wdata),
+		.S_AXI_WSTRB( axi_axiram2_wstrb),
+		.S_AXI_WLAST( axi_axiram2_wlast),
+		//
+		.S_AXI_BVALID(axi_axiram2_bvalid),
+		.S_AXI_BREADY(axi_axiram2_bready),
+		.S_AXI_BID(   axi_axiram2_bid),
+		.S_AXI_BRESP( axi_axiram2_bresp),
+		// Read connections
+		.S_AXI_ARVALID(axi_axiram2_arvalid),
+		.S_AXI_ARREADY(axi_axiram2_arready),
+		.S_AXI_ARID(   axi_axiram2_arid),
+		.S_AXI_ARADDR( axi_axiram2_araddr[22-1:0]),
+		.S_AXI_ARLEN(  axi_axiram2_arlen),
+		.S_AXI_ARSIZE( axi_axiram2_arsize),
+		.S_AXI_ARBURST(axi_axiram2_arburst),
+		.S_AXI_ARLOCK( axi_axiram2_arlock),
+		.S_AXI_ARCACHE(axi_axiram2_arcache),
+		.S_AXI_ARPROT( axi_axiram2_arprot),
+		.S_AXI_ARQOS(  axi_axiram2_arqos),
+		//
+		.S_AXI_RVALID(axi_axiram2_rvalid),
+		.S_AXI_RREADY(axi_axiram2_rready),
+		.S_AXI_RID(   axi_axiram2_rid),
+		.S_AXI_RDATA( axi_axiram2_rdata),
+		.S_AXI_RLAST( axi_axiram2_rlast),
+		.S_AXI_RRESP( axi_axiram2_rresp)
+		// }}}
+	);
+
+	// The SRAM itself
+	// {{{
+	always @(posedge i_clk)
+	if (axiram2_we)
+	for(axiram2_ik=0; axiram2_ik < 32/8;
+			axiram2_ik = axiram2_ik + 1)
+	begin
+		if (axiram2_wstrb[axiram2_ik])
+			axiram2_mem[axiram2_waddr][axiram2_ik*8 +: 8] <= axiram2_wdata[axiram2_ik*8 +: 8];
+	end
+
+	always @(posedge i_clk)
+	if (axiram2_rd)
+		axiram2_rdata <= axiram2_mem[axiram2_raddr];
 	// }}}
 	// }}}
 	////////////////////////////////////////////////////////////////////////
@@ -1853,7 +2512,7 @@ module	main(i_clk, i_reset,
 	//
 	axidma #(
 		// {{{
-		.C_AXI_ADDR_WIDTH(25),
+		.C_AXI_ADDR_WIDTH(34),
 		.C_AXI_DATA_WIDTH(32),
 		.C_AXI_ID_WIDTH(3),
 `ifdef	VERILATOR
@@ -1890,17 +2549,17 @@ module	main(i_clk, i_reset,
 		.S_AXIL_RREADY(axil_dma_rready),
 		.S_AXIL_RDATA( axil_dma_rdata),
 		.S_AXIL_RRESP( axil_dma_rresp),
-		.M_AXI_AWVALID(axi_dma_awvalid),
-		.M_AXI_AWREADY(axi_dma_awready),
+		.M_AXI_AWVALID(dma_awvalid),
+		.M_AXI_AWREADY(dma_awready),
 		.M_AXI_AWID(   axi_dma_awid),
-		.M_AXI_AWADDR( axi_dma_awaddr[25-1:0]),
+		.M_AXI_AWADDR( axi_dma_awaddr[34-1:0]),
 		.M_AXI_AWLEN(  axi_dma_awlen),
 		.M_AXI_AWSIZE( axi_dma_awsize),
 		.M_AXI_AWBURST(axi_dma_awburst),
 		.M_AXI_AWLOCK( axi_dma_awlock),
 		.M_AXI_AWCACHE(axi_dma_awcache),
 		.M_AXI_AWPROT( axi_dma_awprot),
-		.M_AXI_AWQOS(  axi_dma_awqos),
+		.M_AXI_AWQOS(  dma_awqos),
 		//
 		.M_AXI_WVALID(axi_dma_wvalid),
 		.M_AXI_WREADY(axi_dma_wready),
@@ -1913,18 +2572,18 @@ module	main(i_clk, i_reset,
 		.M_AXI_BID(   axi_dma_bid),
 		.M_AXI_BRESP( axi_dma_bresp),
 		// Read connections
-		.M_AXI_ARVALID(axi_dma_arvalid),
-		.M_AXI_ARREADY(axi_dma_arready),
+		.M_AXI_ARVALID(dma_arvalid),
+		.M_AXI_ARREADY(dma_arready),
 		.M_AXI_ARID(   axi_dma_arid),
-		.M_AXI_ARADDR( axi_dma_araddr[25-1:0]),
+		.M_AXI_ARADDR( axi_dma_araddr[34-1:0]),
 		.M_AXI_ARLEN(  axi_dma_arlen),
 		.M_AXI_ARSIZE( axi_dma_arsize),
 		.M_AXI_ARBURST(axi_dma_arburst),
 		.M_AXI_ARLOCK( axi_dma_arlock),
 		.M_AXI_ARCACHE(axi_dma_arcache),
 		.M_AXI_ARPROT( axi_dma_arprot),
-		.M_AXI_ARQOS(  axi_dma_arqos),
-//
+		.M_AXI_ARQOS(  dma_arqos),
+		//
 		.M_AXI_RVALID(axi_dma_rvalid),
 		.M_AXI_RREADY(axi_dma_rready),
 		.M_AXI_RID(   axi_dma_rid),
@@ -1943,7 +2602,7 @@ module	main(i_clk, i_reset,
 	//
 	aximm2s #(
 		// {{{
-		.C_AXI_ADDR_WIDTH(25),
+		.C_AXI_ADDR_WIDTH(34),
 		.C_AXI_DATA_WIDTH(32),
 		.C_AXI_ID_WIDTH(3),
 		.AXI_ID(3'b00)
@@ -1980,18 +2639,18 @@ module	main(i_clk, i_reset,
 		.S_AXIL_RREADY(axil_mm2s_rready),
 		.S_AXIL_RDATA( axil_mm2s_rdata),
 		.S_AXIL_RRESP( axil_mm2s_rresp),
-		.M_AXI_ARVALID(axi_mm2s_arvalid),
-		.M_AXI_ARREADY(axi_mm2s_arready),
+		.M_AXI_ARVALID(mm2s_arvalid),
+		.M_AXI_ARREADY(mm2s_arready),
 		.M_AXI_ARID(   axi_mm2s_arid),
-		.M_AXI_ARADDR( axi_mm2s_araddr[25-1:0]),
+		.M_AXI_ARADDR( axi_mm2s_araddr[34-1:0]),
 		.M_AXI_ARLEN(  axi_mm2s_arlen),
 		.M_AXI_ARSIZE( axi_mm2s_arsize),
 		.M_AXI_ARBURST(axi_mm2s_arburst),
 		.M_AXI_ARLOCK( axi_mm2s_arlock),
 		.M_AXI_ARCACHE(axi_mm2s_arcache),
 		.M_AXI_ARPROT( axi_mm2s_arprot),
-		.M_AXI_ARQOS(  axi_mm2s_arqos),
-//
+		.M_AXI_ARQOS(  mm2s_arqos),
+		//
 		.M_AXI_RVALID(axi_mm2s_rvalid),
 		.M_AXI_RREADY(axi_mm2s_rready),
 		.M_AXI_RID(   axi_mm2s_rid),
@@ -2028,7 +2687,7 @@ module	main(i_clk, i_reset,
 	//
 	axis2mm #(
 		// {{{
-		.C_AXI_ADDR_WIDTH(25),
+		.C_AXI_ADDR_WIDTH(34),
 		.C_AXI_DATA_WIDTH(32),
 		.C_AXI_ID_WIDTH(3),
 		.AXI_ID(3'b001)
@@ -2067,17 +2726,17 @@ module	main(i_clk, i_reset,
 		.S_AXIL_RREADY(axil_s2mm_rready),
 		.S_AXIL_RDATA( axil_s2mm_rdata),
 		.S_AXIL_RRESP( axil_s2mm_rresp),
-		.M_AXI_AWVALID(axi_s2mm_awvalid),
-		.M_AXI_AWREADY(axi_s2mm_awready),
+		.M_AXI_AWVALID(s2mm_awvalid),
+		.M_AXI_AWREADY(s2mm_awready),
 		.M_AXI_AWID(   axi_s2mm_awid),
-		.M_AXI_AWADDR( axi_s2mm_awaddr[25-1:0]),
+		.M_AXI_AWADDR( axi_s2mm_awaddr[34-1:0]),
 		.M_AXI_AWLEN(  axi_s2mm_awlen),
 		.M_AXI_AWSIZE( axi_s2mm_awsize),
 		.M_AXI_AWBURST(axi_s2mm_awburst),
 		.M_AXI_AWLOCK( axi_s2mm_awlock),
 		.M_AXI_AWCACHE(axi_s2mm_awcache),
 		.M_AXI_AWPROT( axi_s2mm_awprot),
-		.M_AXI_AWQOS(  axi_s2mm_awqos),
+		.M_AXI_AWQOS(  s2mm_awqos),
 		//
 		.M_AXI_WVALID(axi_s2mm_wvalid),
 		.M_AXI_WREADY(axi_s2mm_wready),
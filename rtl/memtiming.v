@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/memtiming.v
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Delays the request channel (AR or AW) of an AXI memory, so
+//		that an ideal single-cycle memory behind it appears to have
+//	the timing of a DRAM.  Requests are accepted into a small FIFO as
+//	soon as there's room.  As each is accepted, the simulation's DRAM
+//	model (sim/dramsim.cpp) is asked, via DPI, when that request may be
+//	released to the memory.  Requests are then released in order, each
+//	no earlier than its release time.  Since several requests may be
+//	waiting at once, a master with more transactions outstanding will
+//	hide more of this latency--much as it would with a real DRAM.
+//
+//	If the simulation hasn't selected a DRAM model at reset, or if this
+//	isn't being built by Verilator, requests pass straight through with
+//	no added delay at all.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+//
+`default_nettype none
+//
+module	memtiming #(
+		// {{{
+		parameter	C_AXI_ID_WIDTH = 3,
+		parameter	C_AXI_ADDR_WIDTH = 24,
+		// Set OPT_WRITE for the AW channel, clear it for AR
+		parameter [0:0]	OPT_WRITE = 1'b0,
+		// Log_2 of the number of requests that may be waiting at once
+		parameter	LGFIFO = 4,
+		localparam	IW = C_AXI_ID_WIDTH,
+		localparam	AW = C_AXI_ADDR_WIDTH,
+		localparam	RW = IW + AW + 8 + 3 + 2 + 1 + 4 + 3 + 4
+		// }}}
+	) (
+		// {{{
+		input	wire			S_AXI_ACLK,
+		input	wire			S_AXI_ARESETN,
+		//
+		// The incoming request channel
+		input	wire			S_AXI_AVALID,
+		output	wire			S_AXI_AREADY,
+		input	wire	[IW-1:0]	S_AXI_AID,
+		input	wire	[AW-1:0]	S_AXI_AADDR,
+		input	wire	[7:0]		S_AXI_ALEN,
+		input	wire	[2:0]		S_AXI_ASIZE,
+		input	wire	[1:0]		S_AXI_ABURST,
+		input	wire			S_AXI_ALOCK,
+		input	wire	[3:0]		S_AXI_ACACHE,
+		input	wire	[2:0]		S_AXI_APROT,
+		input	wire	[3:0]		S_AXI_AQOS,
+		//
+		// The outgoing (delayed) request channel
+		output	wire			M_AXI_AVALID,
+		input	wire			M_AXI_AREADY,
+		output	wire	[IW-1:0]	M_AXI_AID,
+		output	wire	[AW-1:0]	M_AXI_AADDR,
+		output	wire	[7:0]		M_AXI_ALEN,
+		output	wire	[2:0]		M_AXI_ASIZE,
+		output	wire	[1:0]		M_AXI_ABURST,
+		output	wire			M_AXI_ALOCK,
+		output	wire	[3:0]		M_AXI_ACACHE,
+		output	wire	[2:0]		M_AXI_APROT,
+		output	wire	[3:0]		M_AXI_AQOS
+		// }}}
+	);
+
+`ifdef	VERILATOR
+	import "DPI-C" function int memtiming_enabled();
+	import "DPI-C" function longint memtiming_request(
+		input longint now, input int wr, input longint addr,
+		input int len, input int size);
+`endif
+
+	// Local declarations
+	// {{{
+	wire			i_clk   =  S_AXI_ACLK;
+	wire			i_reset = !S_AXI_ARESETN;
+
+	reg			r_bypass;
+	reg	[63:0]		now;
+
+	reg	[RW-1:0]	fifo_req	[0:(1<<LGFIFO)-1];
+	reg	[63:0]		fifo_release	[0:(1<<LGFIFO)-1];
+	reg	[LGFIFO:0]	wr_addr, rd_addr;
+	wire			fifo_full, fifo_empty, release_head;
+	wire	[RW-1:0]	s_req;
+
+	reg			m_valid;
+	reg	[RW-1:0]	m_req;
+	// }}}
+
+	// r_bypass: set if there's no timing model to follow
+	// {{{
+	initial	r_bypass = 1'b1;
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+`ifdef	VERILATOR
+		r_bypass <= (memtiming_enabled() == 0);
+`else
+		r_bypass <= 1'b1;
+`endif
+	end
+	// }}}
+
+	// now: the clock count, as shared with the DRAM model
+	// {{{
+	initial	now = 0;
+	always @(posedge i_clk)
+		now <= now + 1;
+	// }}}
+
+	// The request FIFO, together with each request's release time
+	// {{{
+	assign	s_req = { S_AXI_AID, S_AXI_AADDR, S_AXI_ALEN, S_AXI_ASIZE,
+			S_AXI_ABURST, S_AXI_ALOCK, S_AXI_ACACHE, S_AXI_APROT,
+			S_AXI_AQOS };
+
+	assign	fifo_empty = (wr_addr == rd_addr);
+	assign	fifo_full  = (wr_addr[LGFIFO] != rd_addr[LGFIFO])
+			&& (wr_addr[LGFIFO-1:0] == rd_addr[LGFIFO-1:0]);
+	assign	release_head = !fifo_empty && (now >= fifo_release[rd_addr[LGFIFO-1:0]]);
+
+	initial	wr_addr = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		wr_addr <= 0;
+	else if (!r_bypass && S_AXI_AVALID && !fifo_full)
+		wr_addr <= wr_addr + 1;
+
+	always @(posedge i_clk)
+	if (!r_bypass && S_AXI_AVALID && !fifo_full)
+	begin
+		fifo_req[wr_addr[LGFIFO-1:0]] <= s_req;
+`ifdef	VERILATOR
+		fifo_release[wr_addr[LGFIFO-1:0]] <= memtiming_request(now,
+			{ 31'h0, OPT_WRITE },
+			{ {(64-AW){1'b0}}, S_AXI_AADDR },
+			{ 24'h0, S_AXI_ALEN }, { 29'h0, S_AXI_ASIZE });
+`else
+		fifo_release[wr_addr[LGFIFO-1:0]] <= now;
+`endif
+	end
+
+	initial	rd_addr = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		rd_addr <= 0;
+	else if ((!m_valid || M_AXI_AREADY) && release_head)
+		rd_addr <= rd_addr + 1;
+	// }}}
+
+	// The outgoing request
+	// {{{
+	initial	m_valid = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		m_valid <= 1'b0;
+	else if (!m_valid || M_AXI_AREADY)
+		m_valid <= release_head;
+
+	initial	m_req = 0;
+	always @(posedge i_clk)
+	if ((!m_valid || M_AXI_AREADY) && release_head)
+		m_req <= fifo_req[rd_addr[LGFIFO-1:0]];
+
+	assign	S_AXI_AREADY = (r_bypass) ? M_AXI_AREADY : !fifo_full;
+	assign	M_AXI_AVALID = (r_bypass) ? S_AXI_AVALID : m_valid;
+	assign	{ M_AXI_AID, M_AXI_AADDR, M_AXI_ALEN, M_AXI_ASIZE,
+			M_AXI_ABURST, M_AXI_ALOCK, M_AXI_ACACHE, M_AXI_APROT,
+			M_AXI_AQOS } = (r_bypass) ? s_req : m_req;
+	// }}}
+endmodule
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/qosgate.v
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A strict priority gate, by AxQOS, for one request channel (AR
+//		or AW) of several masters ahead of the crossbar.  The crossbar
+//	itself pays no attention to QoS.  With OPT_QOS set, a master's new
+//	request is held back from the crossbar for as long as some other
+//	master with a greater QoS is also requesting, so the higher priority
+//	master always wins arbitration.  A request already offered to the
+//	crossbar stays there until it is accepted, as AXI requires.  Masters
+//	of equal QoS share the crossbar as they would without this gate.
+//
+//	This gate doesn't decode addresses: requests compete even if they
+//	are headed for different slaves.
+//
+//	OPT_QOS defaults to clear, so the gate is a pass through, unless the
+//	design is built with QOS_ARBITER defined (make -C rtl QOS=1).
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+`default_nettype none
+//
+module	qosgate #(
+		// {{{
+		// The number of masters
+		parameter	NM = 2,
+`ifdef	QOS_ARBITER
+		parameter [0:0]	OPT_QOS = 1'b1
+`else
+		parameter [0:0]	OPT_QOS = 1'b0
+`endif
+		// }}}
+	) (
+		// {{{
+		input	wire			S_AXI_ACLK,
+		input	wire			S_AXI_ARESETN,
+		//
+		// Each master's AxQOS, four bits apiece
+		input	wire	[NM*4-1:0]	i_qos,
+		//
+		// Requests from the masters
+		input	wire	[NM-1:0]	S_VALID,
+		output	wire	[NM-1:0]	S_READY,
+		//
+		// Requests to the crossbar
+		output	wire	[NM-1:0]	M_VALID,
+		input	wire	[NM-1:0]	M_READY
+		// }}}
+	);
+
+	generate if (OPT_QOS)
+	begin : GEN_QOS
+		// {{{
+		reg	[NM-1:0]	r_held, blocked;
+		integer			ik, jk;
+
+		// A request offered to the crossbar must stay there
+		initial	r_held = 0;
+		always @(posedge S_AXI_ACLK)
+		if (!S_AXI_ARESETN)
+			r_held <= 0;
+		else
+			r_held <= M_VALID & ~M_READY;
+
+		// Is anyone of a greater QoS asking?
+		always @(*)
+		for(ik=0; ik<NM; ik=ik+1)
+		begin
+			blocked[ik] = 1'b0;
+			for(jk=0; jk<NM; jk=jk+1)
+			if (jk != ik && S_VALID[jk]
+					&& i_qos[jk*4 +: 4] > i_qos[ik*4 +: 4])
+				blocked[ik] = 1'b1;
+		end
+
+		assign	M_VALID = S_VALID & (r_held | ~blocked);
+		assign	S_READY = M_READY & M_VALID;
+		// }}}
+	end else begin : NO_QOS
+		// {{{
+		assign	M_VALID = S_VALID;
+		assign	S_READY = M_READY;
+
+		// Verilator lint_off UNUSED
+		wire	unused;
+		assign	unused = &{ 1'b0, S_AXI_ACLK, S_AXI_ARESETN, i_qos };
+		// Verilator lint_on  UNUSED
+		// }}}
+	end endgenerate
+endmodule
@@ -0,0 +1,561 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/streamcheck.v
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Watches an AXI stream, without taking part in it, and checks
+//		every beat against an expected sequence so that long runs
+//	can be verified at full speed without capturing the data.  The stream
+//	is checked as a sequence of 32-bit words, lowest lane first, so that
+//	a stream of any width matches the words in memory it came from.
+//
+//	0: CTRL	Bits [1:0] select the expected sequence:
+//		0: None.  Words are counted, and the CRC kept, but nothing is
+//			compared.  (The default)
+//		1: Counter.  Each word is one more than the last.
+//		2: LFSR.  Each word is the next state of a 32-bit Galois LFSR,
+//			shifting right, with taps 32'h80200003.
+//		Writing CTRL restarts the check: the next word is expected to
+//		equal SEED, and all counts, the CRC, and the mismatch record
+//		are cleared.  Bit 31 reads as one once a mismatch is found.
+//	1: SEED	The first expected word following a restart
+//	2: WORDS	Number of 32-bit words checked since the restart
+//	3: ERRORS	Number of words that didn't match
+//	4: ERRIDX	Index (from zero) of the first word that didn't match
+//	5: ERRDATA	The value of that word
+//	6: ERREXP	The value that was expected instead
+//	7: CRC	CRC-32 (as in zlib, or Ethernet) of every byte received
+//		since the restart, lowest byte first
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+//
+`default_nettype none
+//
+module	streamcheck #(
+		// {{{
+		//
+		// Size of the AXI-lite bus.  These are fixed, since 1) AXI-lite
+		// is fixed at a width of 32-bits by Xilinx def'n, and 2) since
+		// we only ever have 8 configuration words.
+		parameter	C_AXI_ADDR_WIDTH = 5,
+		localparam	C_AXI_DATA_WIDTH = 32,
+		// The stream may be any multiple of 32-bits wide
+		parameter	C_AXIS_DATA_WIDTH = 32,
+		parameter [0:0]	OPT_LOWPOWER = 0,
+		localparam	ADDRLSB = $clog2(C_AXI_DATA_WIDTH)-3,
+		localparam	LANES = C_AXIS_DATA_WIDTH / 32
+		// }}}
+	) (
+		// {{{
+		input	wire					S_AXI_ACLK,
+		input	wire					S_AXI_ARESETN,
+		//
+		// The stream being watched.  All of these are inputs.
+		input	wire					S_AXIS_TVALID,
+		input	wire					S_AXIS_TREADY,
+		input	wire	[C_AXIS_DATA_WIDTH-1:0]		S_AXIS_TDATA,
+		input	wire					S_AXIS_TLAST,
+		//
+		input	wire					S_AXI_AWVALID,
+		output	wire					S_AXI_AWREADY,
+		input	wire	[C_AXI_ADDR_WIDTH-1:0]		S_AXI_AWADDR,
+		input	wire	[2:0]				S_AXI_AWPROT,
+		//
+		input	wire					S_AXI_WVALID,
+		output	wire					S_AXI_WREADY,
+		input	wire	[C_AXI_DATA_WIDTH-1:0]		S_AXI_WDATA,
+		input	wire	[C_AXI_DATA_WIDTH/8-1:0]	S_AXI_WSTRB,
+		//
+		output	wire					S_AXI_BVALID,
+		input	wire					S_AXI_BREADY,
+		output	wire	[1:0]				S_AXI_BRESP,
+		//
+		input	wire					S_AXI_ARVALID,
+		output	wire					S_AXI_ARREADY,
+		input	wire	[C_AXI_ADDR_WIDTH-1:0]		S_AXI_ARADDR,
+		input	wire	[2:0]				S_AXI_ARPROT,
+		//
+		output	wire					S_AXI_RVALID,
+		input	wire					S_AXI_RREADY,
+		output	wire	[C_AXI_DATA_WIDTH-1:0]		S_AXI_RDATA,
+		output	wire	[1:0]				S_AXI_RRESP
+		// }}}
+	);
+
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Register/wire signal declarations
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+	wire	i_clk   =  S_AXI_ACLK;
+	wire	i_reset = !S_AXI_ARESETN;
+
+	wire				axil_write_ready;
+	wire	[C_AXI_ADDR_WIDTH-ADDRLSB-1:0]	awskd_addr;
+	//
+	wire	[C_AXI_DATA_WIDTH-1:0]	wskd_data;
+	wire [C_AXI_DATA_WIDTH/8-1:0]	wskd_strb;
+	reg				axil_bvalid;
+	//
+	wire				axil_read_ready;
+	wire	[C_AXI_ADDR_WIDTH-ADDRLSB-1:0]	arskd_addr;
+	reg	[C_AXI_DATA_WIDTH-1:0]	axil_read_data;
+	reg				axil_read_valid;
+
+	localparam [1:0]	CHK_NONE    = 2'h0,
+				CHK_COUNTER = 2'h1,
+				CHK_LFSR    = 2'h2;
+	localparam [31:0]	LFSR_TAPS = 32'h80200003,
+				CRC_POLY  = 32'hedb88320;
+
+	reg	[1:0]		chk_mode;
+	reg	[31:0]		chk_seed, chk_next, word_counts, err_counts,
+				err_index, err_data, err_expected, crc;
+	reg			err_seen;
+	wire			restart, beat;
+	wire	[31:0]		ctrl_word;
+
+	reg	[C_AXIS_DATA_WIDTH-1:0]	expected;
+	reg	[31:0]			next_base;
+	reg	[LANES-1:0]		lane_err;
+	reg	[$clog2(LANES+1)-1:0]	lane_errs, first_err;
+	// }}}
+
+	////////////////////////////////////////////////////////////////////////
+	//
+	// AXI-lite signaling
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	//
+	// Write signaling
+	//
+	// {{{
+
+	wire	awskd_valid, wskd_valid;
+
+	skidbuffer #(.OPT_OUTREG(0),
+			.OPT_LOWPOWER(OPT_LOWPOWER),
+			.DW(C_AXI_ADDR_WIDTH-ADDRLSB))
+	axilawskid(//
+		.i_clk(S_AXI_ACLK), .i_reset(i_reset),
+		.i_valid(S_AXI_AWVALID), .o_ready(S_AXI_AWREADY),
+		.i_data(S_AXI_AWADDR[C_AXI_ADDR_WIDTH-1:ADDRLSB]),
+		.o_valid(awskd_valid), .i_ready(axil_write_ready),
+		.o_data(awskd_addr));
+
+	skidbuffer #(.OPT_OUTREG(0),
+			.OPT_LOWPOWER(OPT_LOWPOWER),
+			.DW(C_AXI_DATA_WIDTH+C_AXI_DATA_WIDTH/8))
+	axilwskid(//
+		.i_clk(S_AXI_ACLK), .i_reset(i_reset),
+		.i_valid(S_AXI_WVALID), .o_ready(S_AXI_WREADY),
+		.i_data({ S_AXI_WDATA, S_AXI_WSTRB }),
+		.o_valid(wskd_valid), .i_ready(axil_write_ready),
+		.o_data({ wskd_data, wskd_strb }));
+
+	assign	axil_write_ready = awskd_valid && wskd_valid
+			&& (!S_AXI_BVALID || S_AXI_BREADY);
+
+	initial	axil_bvalid = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		axil_bvalid <= 0;
+	else if (axil_write_ready)
+		axil_bvalid <= 1;
+	else if (S_AXI_BREADY)
+		axil_bvalid <= 0;
+
+	assign	S_AXI_BVALID = axil_bvalid;
+	assign	S_AXI_BRESP = 2'b00;
+	// }}}
+
+	//
+	// Read signaling
+	//
+	// {{{
+
+	wire	arskd_valid;
+
+	skidbuffer #(.OPT_OUTREG(0),
+			.OPT_LOWPOWER(OPT_LOWPOWER),
+			.DW(C_AXI_ADDR_WIDTH-ADDRLSB))
+	axilarskid(//
+		.i_clk(S_AXI_ACLK), .i_reset(i_reset),
+		.i_valid(S_AXI_ARVALID), .o_ready(S_AXI_ARREADY),
+		.i_data(S_AXI_ARADDR[C_AXI_ADDR_WIDTH-1:ADDRLSB]),
+		.o_valid(arskd_valid), .i_ready(axil_read_ready),
+		.o_data(arskd_addr));
+
+	assign	axil_read_ready = arskd_valid
+			&& (!axil_read_valid || S_AXI_RREADY);
+
+	initial	axil_read_valid = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		axil_read_valid <= 1'b0;
+	else if (axil_read_ready)
+		axil_read_valid <= 1'b1;
+	else if (S_AXI_RREADY)
+		axil_read_valid <= 1'b0;
+
+	assign	S_AXI_RVALID = axil_read_valid;
+	assign	S_AXI_RDATA  = axil_read_data;
+	assign	S_AXI_RRESP = 2'b00;
+	// }}}
+
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// AXI-lite register logic
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	function [31:0]	lfsr_step;
+		input	[31:0]	prior;
+		lfsr_step = (prior >> 1) ^ (prior[0] ? LFSR_TAPS : 32'h0);
+	endfunction
+
+	function [31:0]	apply_wstrb;
+		input	[31:0]		prior_data;
+		input	[31:0]		new_data;
+		input	[3:0]		wstrb;
+
+		integer	k;
+		for(k=0; k<4; k=k+1)
+		begin
+			apply_wstrb[k*8 +: 8]
+				= wstrb[k] ? new_data[k*8 +: 8] : prior_data[k*8 +: 8];
+		end
+	endfunction
+
+	assign	restart = axil_write_ready && awskd_addr == 3'h0
+				&& wskd_strb != 0;
+	assign	beat    = S_AXIS_TVALID && S_AXIS_TREADY;
+
+	assign	ctrl_word = { err_seen, 29'h0, chk_mode };
+
+	initial	chk_mode = CHK_NONE;
+	initial	chk_seed = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		chk_mode <= CHK_NONE;
+		chk_seed <= 0;
+	end else if (axil_write_ready)
+	begin
+		case(awskd_addr)
+		3'h0: if (wskd_strb[0])
+			chk_mode <= wskd_data[1:0];
+		3'h1: chk_seed <= apply_wstrb(chk_seed, wskd_data, wskd_strb);
+		default: begin end
+		endcase
+	end
+
+	initial	axil_read_data = 0;
+	always @(posedge i_clk)
+	if (OPT_LOWPOWER && !S_AXI_ARESETN)
+		axil_read_data <= 0;
+	else if (!S_AXI_RVALID || S_AXI_RREADY)
+	begin
+		case(arskd_addr)
+		3'h0:	axil_read_data	<= ctrl_word;
+		3'h1:	axil_read_data	<= chk_seed;
+		3'h2:	axil_read_data	<= word_counts;
+		3'h3:	axil_read_data	<= err_counts;
+		3'h4:	axil_read_data	<= err_index;
+		3'h5:	axil_read_data	<= err_data;
+		3'h6:	axil_read_data	<= err_expected;
+		3'h7:	axil_read_data	<= ~crc;
+		endcase
+
+		if (OPT_LOWPOWER && !axil_read_ready)
+			axil_read_data <= 0;
+	end
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Sequence checking
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	// The expected value of each 32-bit lane, and the first word expected
+	// in the next beat
+	// {{{
+	always @(*)
+	begin : EXPECT
+		integer	k;
+		reg	[31:0]	word;
+
+		word = chk_next;
+		for(k=0; k<LANES; k=k+1)
+		begin
+			expected[k*32 +: 32] = word;
+			if (chk_mode == CHK_LFSR)
+				word = lfsr_step(word);
+			else
+				word = word + 1;
+		end
+
+		next_base = word;
+	end
+	// }}}
+
+	// Which lanes mismatch, how many, and the first of them
+	// {{{
+	always @(*)
+	begin : COMPARE
+		integer	k;
+
+		lane_errs = 0;
+		first_err = 0;
+		for(k=LANES-1; k>=0; k=k-1)
+		begin
+			lane_err[k] = (chk_mode != CHK_NONE)
+				&& (S_AXIS_TDATA[k*32 +: 32] != expected[k*32 +: 32]);
+			if (lane_err[k])
+			begin
+				lane_errs = lane_errs + 1;
+				first_err = k[$clog2(LANES+1)-1:0];
+			end
+		end
+	end
+	// }}}
+
+	// Counts, and the first mismatch
+	// {{{
+	initial	chk_next     = 0;
+	initial	word_counts  = 0;
+	initial	err_counts   = 0;
+	initial	err_seen     = 0;
+	initial	err_index    = 0;
+	initial	err_data     = 0;
+	initial	err_expected = 0;
+	always @(posedge i_clk)
+	if (i_reset || restart)
+	begin
+		chk_next     <= (i_reset) ? 0 : chk_seed;
+		word_counts  <= 0;
+		err_counts   <= 0;
+		err_seen     <= 0;
+		err_index    <= 0;
+		err_data     <= 0;
+		err_expected <= 0;
+	end else if (beat)
+	begin
+		chk_next    <= next_base;
+		word_counts <= word_counts + LANES;
+		err_counts  <= err_counts + { {(32-$clog2(LANES+1)){1'b0}},
+							lane_errs };
+
+		if (!err_seen && lane_err != 0)
+		begin
+			err_seen     <= 1;
+			err_index    <= word_counts + { {(32-$clog2(LANES+1)){1'b0}},
+							first_err };
+			err_data     <= S_AXIS_TDATA[first_err*32 +: 32];
+			err_expected <= expected[first_err*32 +: 32];
+		end
+	end
+	// }}}
+
+	// Running CRC-32, over every byte of every beat
+	// {{{
+	initial	crc = 32'hffff_ffff;
+	always @(posedge i_clk)
+	if (i_reset || restart)
+		crc <= 32'hffff_ffff;
+	else if (beat)
+	begin : CRC_UPDATE
+		integer		k, b;
+		reg	[31:0]	next_crc;
+
+		next_crc = crc;
+		for(k=0; k<C_AXIS_DATA_WIDTH; k=k+8)
+		begin
+			next_crc = next_crc ^ { 24'h0, S_AXIS_TDATA[k +: 8] };
+			for(b=0; b<8; b=b+1)
+				next_crc = (next_crc >> 1)
+					^ (next_crc[0] ? CRC_POLY : 32'h0);
+		end
+
+		crc <= next_crc;
+	end
+	// }}}
+	// }}}
+
+	// Verilator lint_off UNUSED
+	wire	unused;
+	assign	unused = &{ 1'b0, S_AXI_AWPROT, S_AXI_ARPROT, S_AXIS_TLAST,
+			S_AXI_ARADDR[ADDRLSB-1:0],
+			S_AXI_AWADDR[ADDRLSB-1:0] };
+	// Verilator lint_on  UNUSED
+`ifdef	FORMAL
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Formal properties used in verfiying this core
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+	reg	f_past_valid;
+	initial	f_past_valid = 0;
+	always @(posedge i_clk)
+		f_past_valid <= 1;
+
+	////////////////////////////////////////////////////////////////////////
+	//
+	// The AXI-lite control interface
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+	localparam	F_AXIL_LGDEPTH = 4;
+	wire	[F_AXIL_LGDEPTH-1:0]	faxil_rd_outstanding,
+					faxil_wr_outstanding,
+					faxil_awr_outstanding;
+
+	faxil_slave #(
+		// {{{
+		.C_AXI_DATA_WIDTH(C_AXI_DATA_WIDTH),
+		.C_AXI_ADDR_WIDTH(C_AXI_ADDR_WIDTH),
+		.F_LGDEPTH(F_AXIL_LGDEPTH),
+		.F_AXI_MAXWAIT(2),
+		.F_AXI_MAXDELAY(2),
+		.F_AXI_MAXRSTALL(3),
+		.F_OPT_COVER_BURST(4)
+		// }}}
+	) faxil(
+		// {{{
+		.i_clk(S_AXI_ACLK), .i_axi_reset_n(S_AXI_ARESETN),
+		//
+		.i_axi_awvalid(S_AXI_AWVALID),
+		.i_axi_awready(S_AXI_AWREADY),
+		.i_axi_awaddr( S_AXI_AWADDR),
+		.i_axi_awcache(4'h0),
+		.i_axi_awprot( S_AXI_AWPROT),
+		//
+		.i_axi_wvalid(S_AXI_WVALID),
+		.i_axi_wready(S_AXI_WREADY),
+		.i_axi_wdata( S_AXI_WDATA),
+		.i_axi_wstrb( S_AXI_WSTRB),
+		//
+		.i_axi_bvalid(S_AXI_BVALID),
+		.i_axi_bready(S_AXI_BREADY),
+		.i_axi_bresp( S_AXI_BRESP),
+		//
+		.i_axi_arvalid(S_AXI_ARVALID),
+		.i_axi_arready(S_AXI_ARREADY),
+		.i_axi_araddr( S_AXI_ARADDR),
+		.i_axi_arcache(4'h0),
+		.i_axi_arprot( S_AXI_ARPROT),
+		//
+		.i_axi_rvalid(S_AXI_RVALID),
+		.i_axi_rready(S_AXI_RREADY),
+		.i_axi_rdata( S_AXI_RDATA),
+		.i_axi_rresp( S_AXI_RRESP),
+		//
+		.f_axi_rd_outstanding(faxil_rd_outstanding),
+		.f_axi_wr_outstanding(faxil_wr_outstanding),
+		.f_axi_awr_outstanding(faxil_awr_outstanding)
+		// }}}
+		);
+
+	always @(*)
+	begin
+		assert(faxil_awr_outstanding== (S_AXI_BVALID ? 1:0)
+			+(S_AXI_AWREADY ? 0:1));
+		assert(faxil_wr_outstanding == (S_AXI_BVALID ? 1:0)
+			+(S_AXI_WREADY ? 0:1));
+
+		assert(faxil_rd_outstanding == (S_AXI_RVALID ? 1:0)
+			+(S_AXI_ARREADY ? 0:1));
+	end
+
+	always @(posedge S_AXI_ACLK)
+	if (f_past_valid && $past(S_AXI_ARESETN
+			&& axil_read_ready))
+	begin
+		assert(S_AXI_RVALID);
+		case($past(arskd_addr))
+		1: assert(S_AXI_RDATA == $past(chk_seed));
+		2: assert(S_AXI_RDATA == $past(word_counts));
+		3: assert(S_AXI_RDATA == $past(err_counts));
+		endcase
+	end
+
+	//
+	// Check that our low-power only logic works by verifying that anytime
+	// S_AXI_RVALID is inactive, then the outgoing data is also zero.
+	//
+	always @(*)
+	if (OPT_LOWPOWER && !S_AXI_RVALID)
+		assert(S_AXI_RDATA == 0);
+
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Checker properties
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	// Nothing is counted as an error without a mismatch being recorded
+	always @(*)
+	if (S_AXI_ARESETN && !err_seen)
+		assert(err_counts == 0);
+
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Cover checks
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	always @(posedge S_AXI_ACLK)
+	if (S_AXI_ARESETN && chk_mode == CHK_COUNTER)
+		cover(word_counts == 4 * LANES && !err_seen);
+
+	// }}}
+	// }}}
+`endif
+endmodule
@@ -15,6 +15,47 @@
 //	and without skidbuffers, this example demonstrates both so that the
 //	differences can be compared and contrasted.
 //
+//	In addition to counting, the sink can also throttle its own TREADY,
+//	so that a stream source may be measured against a consumer that
+//	stalls.  The throttle is controlled from the AXI-lite bus:
+//
+//	0: BEATS	Number of stream beats accepted
+//	1: PACKETS	Number of TLAST beats accepted
+//	2: CLOCKS	Clocks from the first (TDATA==0) beat to the last beat
+//		Writing to any of these first four registers clears all three
+//		counters.
+//
+//	4: BPCTRL	Backpressure control.  Bits [2:0] select the mode,
+//		bits [31:16] set the length (in clocks) of any replay trace.
+//		Writing this register restarts the pattern from its beginning.
+//
+//		0: TREADY is always set.  (The default)
+//		1: Duty cycle.  TREADY is set for ON of every PERIOD clocks,
+//			spread as evenly as possible.
+//		2: Random.  TREADY is set on any clock where the bottom 16
+//			bits of a 32-bit LFSR are less than ON.
+//		3: Burst.  TREADY is set for ON clocks, then cleared for OFF
+//			clocks, and so on.  An OFF of zero never stalls.
+//		4: Replay.  TREADY follows the bits written to BPTRACE, one
+//			bit per clock, repeating every trace length clocks.
+//
+//	5: BPARG	ON in bits [15:0], and PERIOD (or OFF) in bits [31:16].
+//	6: BPSEED	Seed for the LFSR used by the random mode.
+//	7: BPTRACE	Writes append 32 bits (LSB first) to the replay trace.
+//		Reads return the number of words written so far.
+//
+//	Finally, the sink measures how smoothly the stream arrives:
+//
+//	8: LATENCY	Clocks from the last i_start strobe to the first beat
+//		following it.  Zero if no beat has followed a strobe yet.
+//	9: MAXGAP	Longest run of clocks, between two beats, where TVALID
+//		was low.  Clocks spent in backpressure are not included.
+//	10: STALLS	Clocks where TVALID was high but TREADY was low
+//	11-15: HIST0-HIST4	A histogram of the clocks between successive
+//		beats: 0 (back to back), 1, 2-3, 4-15, and 16 or more.
+//		Writing to any of 8-15, as with 0-3, clears all of the
+//		statistics.
+//
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
 //
@@ -51,11 +92,17 @@ module	streamcounter #(
 		//
 		// Size of the AXI-lite bus.  These are fixed, since 1) AXI-lite
 		// is fixed at a width of 32-bits by Xilinx def'n, and 2) since
-		// we only ever have 4 configuration words.
-		parameter	C_AXI_ADDR_WIDTH = 4,
+		// we only ever have 16 configuration words.
+		parameter	C_AXI_ADDR_WIDTH = 6,
 		localparam	C_AXI_DATA_WIDTH = 32,
+		// The stream may be any multiple of 32-bits wide.  Only the
+		// first (lowest) 32-bit lane is used to recognize the start
+		// of a test.
 		parameter	C_AXIS_DATA_WIDTH = 32,
 		parameter [0:0]	OPT_LOWPOWER = 0,
+		// Log_2 of the maximum length of the backpressure replay
+		// trace, in clocks.  Must be between 6 and 15.
+		parameter	LGTRACE = 10,
 		localparam	ADDRLSB = $clog2(C_AXI_DATA_WIDTH)-3
 		// }}}
 	) (
@@ -68,6 +115,10 @@ module	streamcounter #(
 		input	wire	[C_AXIS_DATA_WIDTH-1:0]		S_AXIS_TDATA,
 		input	wire					S_AXIS_TLAST,
 		//
+		// A strobe marking the start of a transfer, from which
+		// the first-beat latency is measured
+		input	wire					i_start,
+		//
 		input	wire					S_AXI_AWVALID,
 		output	wire					S_AXI_AWREADY,
 		input	wire	[C_AXI_ADDR_WIDTH-1:0]		S_AXI_AWADDR,
@@ -118,6 +169,31 @@ module	streamcounter #(
 
 	reg	[31:0]	beat_counts, packet_counts, clock_counts,
 			tick_counter;
+	wire		clear_counts, beat;
+
+	reg	[31:0]	latency, lat_counter, max_gap, gap_counter,
+			stall_counts, since_beat;
+	reg		lat_armed, seen_beat;
+	reg	[31:0]	gap_hist	[0:4];
+	reg	[2:0]	gap_bin;
+
+	localparam [2:0]	BP_NONE   = 3'h0,
+				BP_DUTY   = 3'h1,
+				BP_RANDOM = 3'h2,
+				BP_BURST  = 3'h3,
+				BP_REPLAY = 3'h4;
+	localparam [31:0]	LFSR_TAPS = 32'h80200003;
+
+	reg	[2:0]		bp_mode;
+	reg	[15:0]		bp_on, bp_off, bp_count;
+	reg	[31:0]		bp_seed, bp_lfsr;
+	reg			bp_phase, bp_ready;
+	reg	[LGTRACE-1:0]	bp_tracelen, bp_tracepos;
+	reg	[LGTRACE-5:0]	bp_wraddr;
+	reg	[31:0]		bp_trace	[0:(1<<(LGTRACE-5))-1];
+	reg	[31:0]		bp_traceword;
+	reg	[4:0]		bp_tracebit;
+	wire	[31:0]		bpctrl_word, bparg_word, new_bpctrl;
 
 
 	////////////////////////////////////////////////////////////////////////
@@ -214,6 +290,11 @@ module	streamcounter #(
 	//
 	// {{{
 
+	// Writes to the backpressure registers, 4-7, don't clear the counters
+	assign	clear_counts = axil_write_ready && wskd_strb != 0
+				&& awskd_addr[3:2] != 2'b01;
+	assign	beat = S_AXIS_TVALID && S_AXIS_TREADY;
+
 	initial	beat_counts   = 0;
 	initial	packet_counts = 0;
 	initial	clock_counts  = 0;
@@ -223,7 +304,7 @@ module	streamcounter #(
 		beat_counts   <= 0;
 		packet_counts <= 0;
 		clock_counts  <= 0;
-	end else if (axil_write_ready && wskd_strb != 0)
+	end else if (clear_counts)
 	begin
 		beat_counts   <= 0;
 		packet_counts <= 0;
@@ -234,7 +315,7 @@ module	streamcounter #(
 		if (S_AXIS_TLAST)
 			packet_counts <= packet_counts + 1;
 
-		if (S_AXIS_TDATA == 0)
+		if (S_AXIS_TDATA[31:0] == 0)
 			clock_counts <= 1;
 		else
 			clock_counts <= tick_counter + 1;
@@ -244,9 +325,9 @@ module	streamcounter #(
 	always @(posedge i_clk)
 	if (i_reset)
 		tick_counter  <= 0;
-	else if (axil_write_ready && wskd_strb != 0)
+	else if (clear_counts)
 		tick_counter  <= 0;
-	else if (S_AXIS_TVALID && S_AXIS_TREADY && S_AXIS_TDATA == 0)
+	else if (S_AXIS_TVALID && S_AXIS_TREADY && S_AXIS_TDATA[31:0] == 0)
 		tick_counter <= 1;
 	else
 		tick_counter <= tick_counter + 1;
@@ -258,9 +339,22 @@ module	streamcounter #(
 	else if (!S_AXI_RVALID || S_AXI_RREADY)
 	begin
 		case(arskd_addr)
-		2'b00:	axil_read_data	<= beat_counts;
-		2'b01:	axil_read_data	<= packet_counts;
-		2'b10:	axil_read_data	<= clock_counts;
+		4'h0:	axil_read_data	<= beat_counts;
+		4'h1:	axil_read_data	<= packet_counts;
+		4'h2:	axil_read_data	<= clock_counts;
+		4'h4:	axil_read_data	<= bpctrl_word;
+		4'h5:	axil_read_data	<= bparg_word;
+		4'h6:	axil_read_data	<= bp_seed;
+		4'h7:	axil_read_data	<= { {(32-(LGTRACE-4)){1'b0}},
+							bp_wraddr };
+		4'h8:	axil_read_data	<= latency;
+		4'h9:	axil_read_data	<= max_gap;
+		4'ha:	axil_read_data	<= stall_counts;
+		4'hb:	axil_read_data	<= gap_hist[0];
+		4'hc:	axil_read_data	<= gap_hist[1];
+		4'hd:	axil_read_data	<= gap_hist[2];
+		4'he:	axil_read_data	<= gap_hist[3];
+		4'hf:	axil_read_data	<= gap_hist[4];
 		default:	axil_read_data <= 0;
 		endcase
 
@@ -268,17 +362,271 @@ module	streamcounter #(
 			axil_read_data <= 0;
 	end
 
+	function [C_AXI_DATA_WIDTH-1:0]	apply_wstrb;
+		input	[C_AXI_DATA_WIDTH-1:0]		prior_data;
+		input	[C_AXI_DATA_WIDTH-1:0]		new_data;
+		input	[C_AXI_DATA_WIDTH/8-1:0]	wstrb;
+
+		integer	k;
+		for(k=0; k<C_AXI_DATA_WIDTH/8; k=k+1)
+		begin
+			apply_wstrb[k*8 +: 8]
+				= wstrb[k] ? new_data[k*8 +: 8] : prior_data[k*8 +: 8];
+		end
+	endfunction
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Stream statistics: latency, gaps, and stalls
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	// First beat latency
+	// {{{
+	initial	lat_armed   = 0;
+	initial	lat_counter = 0;
+	initial	latency     = 0;
+	always @(posedge i_clk)
+	if (i_reset || clear_counts)
+	begin
+		lat_armed   <= 0;
+		lat_counter <= 0;
+		latency     <= 0;
+	end else if (i_start)
+	begin
+		lat_armed   <= 1;
+		lat_counter <= 1;
+	end else if (lat_armed)
+	begin
+		if (beat)
+		begin
+			lat_armed <= 0;
+			latency   <= lat_counter;
+		end
+
+		if (!(&lat_counter))
+			lat_counter <= lat_counter + 1;
+	end
+	// }}}
+
+	// Stalls, and the longest TVALID gap
+	// {{{
+	initial	stall_counts = 0;
+	initial	gap_counter  = 0;
+	initial	max_gap      = 0;
+	initial	seen_beat    = 0;
+	always @(posedge i_clk)
+	if (i_reset || clear_counts)
+	begin
+		stall_counts <= 0;
+		gap_counter  <= 0;
+		max_gap      <= 0;
+		seen_beat    <= 0;
+	end else begin
+		if (S_AXIS_TVALID && !S_AXIS_TREADY)
+			stall_counts <= stall_counts + 1;
+
+		if (beat)
+			seen_beat <= 1;
+
+		// A gap is only complete once TVALID returns, so that the
+		// idle time following the last beat isn't counted.
+		if (S_AXIS_TVALID)
+		begin
+			gap_counter <= 0;
+			if (seen_beat && gap_counter > max_gap)
+				max_gap <= gap_counter;
+		end else if (!(&gap_counter))
+			gap_counter <= gap_counter + 1;
+	end
 	// }}}
 
-	assign	S_AXIS_TREADY = 1'b1;
+	// Inter-beat gap histogram
+	// {{{
+	always @(*)
+	if (since_beat == 0)
+		gap_bin = 3'h0;
+	else if (since_beat == 1)
+		gap_bin = 3'h1;
+	else if (since_beat < 4)
+		gap_bin = 3'h2;
+	else if (since_beat < 16)
+		gap_bin = 3'h3;
+	else
+		gap_bin = 3'h4;
+
+	initial	since_beat = 0;
+	always @(posedge i_clk)
+	if (i_reset || clear_counts || beat)
+		since_beat <= 0;
+	else if (!(&since_beat))
+		since_beat <= since_beat + 1;
+
+	integer	ik;
+	initial	for(ik=0; ik<5; ik=ik+1)
+		gap_hist[ik] = 0;
+	always @(posedge i_clk)
+	if (i_reset || clear_counts)
+	begin
+		for(ik=0; ik<5; ik=ik+1)
+			gap_hist[ik] <= 0;
+	end else if (beat && seen_beat)
+		gap_hist[gap_bin] <= gap_hist[gap_bin] + 1;
+	// }}}
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Backpressure generation
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	assign	bpctrl_word = { {(16-LGTRACE){1'b0}}, bp_tracelen,
+					13'h0, bp_mode };
+	assign	bparg_word  = { bp_off, bp_on };
+	assign	new_bpctrl  = apply_wstrb(bpctrl_word, wskd_data, wskd_strb);
+
+	// Control registers
+	// {{{
+	initial	bp_mode = BP_NONE;
+	initial	bp_on   = 0;
+	initial	bp_off  = 0;
+	initial	bp_seed = 1;
+	initial	bp_tracelen = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		bp_mode <= BP_NONE;
+		bp_on   <= 0;
+		bp_off  <= 0;
+		bp_seed <= 1;
+		bp_tracelen <= 0;
+	end else if (axil_write_ready)
+	begin
+		case(awskd_addr)
+		4'h4: begin
+			bp_mode     <= new_bpctrl[2:0];
+			bp_tracelen <= new_bpctrl[16 +: LGTRACE];
+			end
+		4'h5: { bp_off, bp_on }
+			<= apply_wstrb(bparg_word, wskd_data, wskd_strb);
+		4'h6: bp_seed <= apply_wstrb(bp_seed, wskd_data, wskd_strb);
+		default: begin end
+		endcase
+	end
+	// }}}
+
+	// Replay trace memory
+	// {{{
+	initial	bp_wraddr = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		bp_wraddr <= 0;
+	else if (axil_write_ready && awskd_addr == 4'h4)
+		bp_wraddr <= 0;
+	else if (axil_write_ready && awskd_addr == 4'h7
+			&& !bp_wraddr[LGTRACE-5])
+		bp_wraddr <= bp_wraddr + 1;
+
+	always @(posedge i_clk)
+	if (axil_write_ready && awskd_addr == 4'h7 && !bp_wraddr[LGTRACE-5])
+		bp_trace[bp_wraddr[LGTRACE-6:0]] <= wskd_data;
+
+	// The bit index is registered along with its word, so that both
+	// come from the same trace position
+	always @(posedge i_clk)
+	begin
+		bp_traceword <= bp_trace[bp_tracepos[LGTRACE-1:5]];
+		bp_tracebit  <= bp_tracepos[4:0];
+	end
+	// }}}
+
+	// Pattern state: LFSR, duty/burst counter, and replay position
+	// {{{
+	initial	bp_lfsr     = 1;
+	initial	bp_count    = 0;
+	initial	bp_phase    = 1'b1;
+	initial	bp_tracepos = 0;
+	always @(posedge i_clk)
+	if (i_reset || (axil_write_ready && awskd_addr[3:2] == 2'b01))
+	begin
+		// Any configuration write restarts the pattern
+		if (i_reset || bp_seed == 0)
+			bp_lfsr <= 32'h1;
+		else
+			bp_lfsr <= bp_seed;
+		bp_count    <= 0;
+		bp_phase    <= 1'b1;
+		bp_tracepos <= 0;
+	end else begin
+		bp_lfsr <= (bp_lfsr >> 1) ^ (bp_lfsr[0] ? LFSR_TAPS : 32'h0);
+
+		case(bp_mode)
+		BP_DUTY: begin
+			// Bresenham style: ON of every PERIOD clocks
+			if ({ 1'b0, bp_count } + bp_on >= { 1'b0, bp_off })
+				bp_count <= bp_count + bp_on - bp_off;
+			else
+				bp_count <= bp_count + bp_on;
+			end
+		BP_BURST: begin
+			if (bp_count + 1 >= (bp_phase ? bp_on : bp_off))
+			begin
+				bp_count <= 0;
+				bp_phase <= !bp_phase;
+			end else
+				bp_count <= bp_count + 1;
+			end
+		default: begin end
+		endcase
+
+		if (bp_tracepos + 1 >= bp_tracelen)
+			bp_tracepos <= 0;
+		else
+			bp_tracepos <= bp_tracepos + 1;
+	end
+	// }}}
+
+	// bp_ready, the registered TREADY
+	// {{{
+	initial	bp_ready = 1'b1;
+	always @(posedge i_clk)
+	if (i_reset)
+		bp_ready <= 1'b1;
+	else case(bp_mode)
+	BP_DUTY:	bp_ready <= (bp_on >= bp_off)
+				|| ({ 1'b0, bp_count } + bp_on >= { 1'b0, bp_off });
+	BP_RANDOM:	bp_ready <= (bp_lfsr[15:0] < bp_on);
+	BP_BURST:	bp_ready <= (bp_off == 0)
+				|| (bp_phase && (bp_on != 0));
+	BP_REPLAY:	bp_ready <= (bp_tracelen == 0)
+				|| bp_traceword[bp_tracebit];
+	default:	bp_ready <= 1'b1;
+	endcase
+	// }}}
+
+	assign	S_AXIS_TREADY = bp_ready;
+	// }}}
 
 	// Verilator lint_off UNUSED
 	wire	unused;
 	assign	unused = &{ 1'b0, S_AXI_AWPROT, S_AXI_ARPROT,
 			S_AXI_ARADDR[ADDRLSB-1:0],
-			S_AXI_AWADDR[ADDRLSB-1:0],
-			awskd_addr, wskd_data };
+			S_AXI_AWADDR[ADDRLSB-1:0] };
 	// Verilator lint_on  UNUSED
+
+	// Only the first 32-bit lane of a wide stream is examined
+	generate if (C_AXIS_DATA_WIDTH > 32)
+	begin : UNUSED_TDATA
+		// Verilator lint_off UNUSED
+		wire	unused_tdata;
+		assign	unused_tdata = &{ 1'b0,
+				S_AXIS_TDATA[C_AXIS_DATA_WIDTH-1:32] };
+		// Verilator lint_on  UNUSED
+	end endgenerate
 	// }}}
 `ifdef	FORMAL
 	////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,593 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	rtl/streamsource.v
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Generates an AXI stream, suitable for testing the S2MM, whose
+//		rate and packet structure may be controlled over AXI-lite.
+//	The data is a simple counter.  When the stream is wider than 32-bits,
+//	each 32-bit lane carries the next value of the counter, so that the
+//	words written to memory still increment one at a time.
+//
+//	Out of reset, TVALID is always set and every beat is the last beat of
+//	its packet--matching the original free-running test source.
+//
+//	0: RATE	N in bits [15:0], M in bits [31:16].  TVALID will be raised
+//		on N of every M clocks, spread as evenly as possible.  If N
+//		is greater than or equal to M, as it is by default, TVALID
+//		will be raised on every clock.
+//	1: BURST	BEATS in bits [15:0], IDLE in bits [31:16].  After
+//		every BEATS beats have been accepted, TVALID will be held low
+//		for IDLE clocks.  If BEATS is zero (the default), there are no
+//		idle periods.
+//	2: PKTLEN	Number of beats per packet.  TLAST will be set on every
+//		PKTLEN'th beat.  Zero or one sets TLAST on every beat.
+//	3: RESTART	Writes restart the data counter at zero.
+//		Writing to any of these first four registers restarts the
+//		rate, burst, and packet patterns from their beginnings.
+//
+//	4: BEATS	Number of beats accepted by the stream consumer
+//	5: PACKETS	Number of TLAST beats accepted by the consumer
+//	6: STALLS	Number of clocks where TVALID && !TREADY
+//		Writing to any of these three registers clears all three.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+//
+`default_nettype none
+//
+module	streamsource #(
+		// {{{
+		//
+		// Size of the AXI-lite bus.  These are fixed, since 1) AXI-lite
+		// is fixed at a width of 32-bits by Xilinx def'n, and 2) since
+		// we only ever have 8 configuration words.
+		parameter	C_AXI_ADDR_WIDTH = 5,
+		localparam	C_AXI_DATA_WIDTH = 32,
+		// The stream may be any multiple of 32-bits wide
+		parameter	C_AXIS_DATA_WIDTH = 32,
+		parameter [0:0]	OPT_LOWPOWER = 0,
+		localparam	ADDRLSB = $clog2(C_AXI_DATA_WIDTH)-3,
+		localparam	LANES = C_AXIS_DATA_WIDTH / 32
+		// }}}
+	) (
+		// {{{
+		input	wire					S_AXI_ACLK,
+		input	wire					S_AXI_ARESETN,
+		//
+		output	reg					M_AXIS_TVALID,
+		input	wire					M_AXIS_TREADY,
+		output	reg	[C_AXIS_DATA_WIDTH-1:0]		M_AXIS_TDATA,
+		output	reg					M_AXIS_TLAST,
+		//
+		input	wire					S_AXI_AWVALID,
+		output	wire					S_AXI_AWREADY,
+		input	wire	[C_AXI_ADDR_WIDTH-1:0]		S_AXI_AWADDR,
+		input	wire	[2:0]				S_AXI_AWPROT,
+		//
+		input	wire					S_AXI_WVALID,
+		output	wire					S_AXI_WREADY,
+		input	wire	[C_AXI_DATA_WIDTH-1:0]		S_AXI_WDATA,
+		input	wire	[C_AXI_DATA_WIDTH/8-1:0]	S_AXI_WSTRB,
+		//
+		output	wire					S_AXI_BVALID,
+		input	wire					S_AXI_BREADY,
+		output	wire	[1:0]				S_AXI_BRESP,
+		//
+		input	wire					S_AXI_ARVALID,
+		output	wire					S_AXI_ARREADY,
+		input	wire	[C_AXI_ADDR_WIDTH-1:0]		S_AXI_ARADDR,
+		input	wire	[2:0]				S_AXI_ARPROT,
+		//
+		output	wire					S_AXI_RVALID,
+		input	wire					S_AXI_RREADY,
+		output	wire	[C_AXI_DATA_WIDTH-1:0]		S_AXI_RDATA,
+		output	wire	[1:0]				S_AXI_RRESP
+		// }}}
+	);
+
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Register/wire signal declarations
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+	wire	i_clk   =  S_AXI_ACLK;
+	wire	i_reset = !S_AXI_ARESETN;
+
+	wire				axil_write_ready;
+	wire	[C_AXI_ADDR_WIDTH-ADDRLSB-1:0]	awskd_addr;
+	//
+	wire	[C_AXI_DATA_WIDTH-1:0]	wskd_data;
+	wire [C_AXI_DATA_WIDTH/8-1:0]	wskd_strb;
+	reg				axil_bvalid;
+	//
+	wire				axil_read_ready;
+	wire	[C_AXI_ADDR_WIDTH-ADDRLSB-1:0]	arskd_addr;
+	reg	[C_AXI_DATA_WIDTH-1:0]	axil_read_data;
+	reg				axil_read_valid;
+
+	reg	[15:0]		rate_n, rate_m, burst_beats, burst_idle;
+	reg	[31:0]		pkt_len;
+	wire	[31:0]		rate_word, burst_word;
+	wire			restart, clear_counts;
+
+	reg	[16:0]		rate_acc;
+	reg			rate_token;
+	wire			rate_ok, allowed, launch;
+	reg	[15:0]		burst_count, idle_count;
+	reg	[31:0]		pkt_count, data_counter;
+	integer			ik;
+
+	reg	[31:0]		beat_counts, packet_counts, stall_counts;
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// AXI-lite signaling
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	//
+	// Write signaling
+	//
+	// {{{
+
+	wire	awskd_valid, wskd_valid;
+
+	skidbuffer #(.OPT_OUTREG(0),
+			.OPT_LOWPOWER(OPT_LOWPOWER),
+			.DW(C_AXI_ADDR_WIDTH-ADDRLSB))
+	axilawskid(//
+		.i_clk(S_AXI_ACLK), .i_reset(i_reset),
+		.i_valid(S_AXI_AWVALID), .o_ready(S_AXI_AWREADY),
+		.i_data(S_AXI_AWADDR[C_AXI_ADDR_WIDTH-1:ADDRLSB]),
+		.o_valid(awskd_valid), .i_ready(axil_write_ready),
+		.o_data(awskd_addr));
+
+	skidbuffer #(.OPT_OUTREG(0),
+			.OPT_LOWPOWER(OPT_LOWPOWER),
+			.DW(C_AXI_DATA_WIDTH+C_AXI_DATA_WIDTH/8))
+	axilwskid(//
+		.i_clk(S_AXI_ACLK), .i_reset(i_reset),
+		.i_valid(S_AXI_WVALID), .o_ready(S_AXI_WREADY),
+		.i_data({ S_AXI_WDATA, S_AXI_WSTRB }),
+		.o_valid(wskd_valid), .i_ready(axil_write_ready),
+		.o_data({ wskd_data, wskd_strb }));
+
+	assign	axil_write_ready = awskd_valid && wskd_valid
+			&& (!S_AXI_BVALID || S_AXI_BREADY);
+
+	initial	axil_bvalid = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+		axil_bvalid <= 0;
+	else if (axil_write_ready)
+		axil_bvalid <= 1;
+	else if (S_AXI_BREADY)
+		axil_bvalid <= 0;
+
+	assign	S_AXI_BVALID = axil_bvalid;
+	assign	S_AXI_BRESP = 2'b00;
+	// }}}
+
+	//
+	// Read signaling
+	//
+	// {{{
+
+	wire	arskd_valid;
+
+	skidbuffer #(.OPT_OUTREG(0),
+			.OPT_LOWPOWER(OPT_LOWPOWER),
+			.DW(C_AXI_ADDR_WIDTH-ADDRLSB))
+	axilarskid(//
+		.i_clk(S_AXI_ACLK), .i_reset(i_reset),
+		.i_valid(S_AXI_ARVALID), .o_ready(S_AXI_ARREADY),
+		.i_data(S_AXI_ARADDR[C_AXI_ADDR_WIDTH-1:ADDRLSB]),
+		.o_valid(arskd_valid), .i_ready(axil_read_ready),
+		.o_data(arskd_addr));
+
+	assign	axil_read_ready = arskd_valid
+			&& (!axil_read_valid || S_AXI_RREADY);
+
+	initial	axil_read_valid = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		axil_read_valid <= 1'b0;
+	else if (axil_read_ready)
+		axil_read_valid <= 1'b1;
+	else if (S_AXI_RREADY)
+		axil_read_valid <= 1'b0;
+
+	assign	S_AXI_RVALID = axil_read_valid;
+	assign	S_AXI_RDATA  = axil_read_data;
+	assign	S_AXI_RRESP = 2'b00;
+	// }}}
+
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// AXI-lite register logic
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	assign	rate_word  = { rate_m, rate_n };
+	assign	burst_word = { burst_idle, burst_beats };
+
+	// Any write to the first four registers restarts the patterns
+	assign	restart = axil_write_ready && !awskd_addr[2];
+	assign	clear_counts = axil_write_ready && awskd_addr[2];
+
+	initial	{ rate_m, rate_n } = 0;
+	initial	{ burst_idle, burst_beats } = 0;
+	initial	pkt_len = 0;
+	always @(posedge i_clk)
+	if (i_reset)
+	begin
+		{ rate_m, rate_n } <= 0;
+		{ burst_idle, burst_beats } <= 0;
+		pkt_len <= 0;
+	end else if (axil_write_ready)
+	begin
+		case(awskd_addr)
+		3'h0: { rate_m, rate_n }
+			<= apply_wstrb(rate_word, wskd_data, wskd_strb);
+		3'h1: { burst_idle, burst_beats }
+			<= apply_wstrb(burst_word, wskd_data, wskd_strb);
+		3'h2: pkt_len <= apply_wstrb(pkt_len, wskd_data, wskd_strb);
+		default: begin end
+		endcase
+	end
+
+	initial	axil_read_data = 0;
+	always @(posedge i_clk)
+	if (OPT_LOWPOWER && !S_AXI_ARESETN)
+		axil_read_data <= 0;
+	else if (!S_AXI_RVALID || S_AXI_RREADY)
+	begin
+		case(arskd_addr)
+		3'h0:	axil_read_data	<= rate_word;
+		3'h1:	axil_read_data	<= burst_word;
+		3'h2:	axil_read_data	<= pkt_len;
+		3'h4:	axil_read_data	<= beat_counts;
+		3'h5:	axil_read_data	<= packet_counts;
+		3'h6:	axil_read_data	<= stall_counts;
+		default:	axil_read_data <= 0;
+		endcase
+
+		if (OPT_LOWPOWER && !axil_read_ready)
+			axil_read_data <= 0;
+	end
+
+	function [C_AXI_DATA_WIDTH-1:0]	apply_wstrb;
+		input	[C_AXI_DATA_WIDTH-1:0]		prior_data;
+		input	[C_AXI_DATA_WIDTH-1:0]		new_data;
+		input	[C_AXI_DATA_WIDTH/8-1:0]	wstrb;
+
+		integer	k;
+		for(k=0; k<C_AXI_DATA_WIDTH/8; k=k+1)
+		begin
+			apply_wstrb[k*8 +: 8]
+				= wstrb[k] ? new_data[k*8 +: 8] : prior_data[k*8 +: 8];
+		end
+	endfunction
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Stream rate and packet control
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	// Rate: a Bresenham accumulator hands out one token for every M/N
+	// clocks.  At most one token is held, so a stalled consumer can't
+	// build up a burst of tokens to be spent later.
+	// {{{
+	assign	rate_ok = (rate_n >= rate_m) || rate_token;
+
+	initial	rate_acc   = 0;
+	initial	rate_token = 0;
+	always @(posedge i_clk)
+	if (i_reset || restart)
+	begin
+		rate_acc   <= 0;
+		rate_token <= 0;
+	end else if (!rate_token || launch)
+	begin
+		if (rate_acc + rate_n >= { 1'b0, rate_m })
+		begin
+			rate_acc   <= rate_acc + rate_n - rate_m;
+			rate_token <= 1'b1;
+		end else begin
+			rate_acc   <= rate_acc + rate_n;
+			rate_token <= 1'b0;
+		end
+	end
+	// }}}
+
+	// Bursts: count accepted beats, then idle
+	// {{{
+	initial	burst_count = 0;
+	initial	idle_count  = 0;
+	always @(posedge i_clk)
+	if (i_reset || restart)
+	begin
+		burst_count <= 0;
+		idle_count  <= 0;
+	end else if (launch && burst_beats != 0)
+	begin
+		if (burst_count + 1 >= burst_beats)
+		begin
+			burst_count <= 0;
+			idle_count  <= burst_idle;
+		end else
+			burst_count <= burst_count + 1;
+	end else if (idle_count != 0)
+		idle_count <= idle_count - 1;
+	// }}}
+
+	assign	allowed = rate_ok && (idle_count == 0);
+	assign	launch  = (!M_AXIS_TVALID || M_AXIS_TREADY) && allowed;
+
+	// M_AXIS_TVALID
+	// {{{
+	initial	M_AXIS_TVALID = 1'b0;
+	always @(posedge i_clk)
+	if (i_reset)
+		M_AXIS_TVALID <= 1'b0;
+	else if (!M_AXIS_TVALID || M_AXIS_TREADY)
+		M_AXIS_TVALID <= allowed;
+	// }}}
+
+	// M_AXIS_TDATA, the data counter
+	// {{{
+	initial	data_counter = 0;
+	always @(posedge i_clk)
+	if (i_reset || (axil_write_ready && awskd_addr == 3'h3))
+		data_counter <= 0;
+	else if (launch)
+		data_counter <= data_counter + LANES;
+
+	initial	M_AXIS_TDATA = 0;
+	always @(posedge i_clk)
+	if (OPT_LOWPOWER && i_reset)
+		M_AXIS_TDATA <= 0;
+	else if (launch)
+	begin
+		for(ik=0; ik<LANES; ik=ik+1)
+			M_AXIS_TDATA[ik*32 +: 32] <= data_counter + ik;
+	end else if (OPT_LOWPOWER && M_AXIS_TREADY)
+		M_AXIS_TDATA <= 0;
+	// }}}
+
+	// M_AXIS_TLAST, every pkt_len beats
+	// {{{
+	initial	pkt_count = 0;
+	always @(posedge i_clk)
+	if (i_reset || restart)
+		pkt_count <= 0;
+	else if (launch)
+	begin
+		if (pkt_count + 1 >= pkt_len)
+			pkt_count <= 0;
+		else
+			pkt_count <= pkt_count + 1;
+	end
+
+	initial	M_AXIS_TLAST = 1'b0;
+	always @(posedge i_clk)
+	if (OPT_LOWPOWER && i_reset)
+		M_AXIS_TLAST <= 1'b0;
+	else if (launch)
+		M_AXIS_TLAST <= (pkt_count + 1 >= pkt_len);
+	else if (OPT_LOWPOWER && M_AXIS_TREADY)
+		M_AXIS_TLAST <= 1'b0;
+	// }}}
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Consumer statistics
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+	initial	beat_counts   = 0;
+	initial	packet_counts = 0;
+	initial	stall_counts  = 0;
+	always @(posedge i_clk)
+	if (i_reset || clear_counts)
+	begin
+		beat_counts   <= 0;
+		packet_counts <= 0;
+		stall_counts  <= 0;
+	end else if (M_AXIS_TVALID)
+	begin
+		if (M_AXIS_TREADY)
+		begin
+			beat_counts <= beat_counts + 1;
+			if (M_AXIS_TLAST)
+				packet_counts <= packet_counts + 1;
+		end else
+			stall_counts <= stall_counts + 1;
+	end
+	// }}}
+
+	// Verilator lint_off UNUSED
+	wire	unused;
+	assign	unused = &{ 1'b0, S_AXI_AWPROT, S_AXI_ARPROT,
+			S_AXI_ARADDR[ADDRLSB-1:0],
+			S_AXI_AWADDR[ADDRLSB-1:0] };
+	// Verilator lint_on  UNUSED
+`ifdef	FORMAL
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Formal properties used in verfiying this core
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+	reg	f_past_valid;
+	initial	f_past_valid = 0;
+	always @(posedge i_clk)
+		f_past_valid <= 1;
+
+	////////////////////////////////////////////////////////////////////////
+	//
+	// The AXI-lite control interface
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+	localparam	F_AXIL_LGDEPTH = 4;
+	wire	[F_AXIL_LGDEPTH-1:0]	faxil_rd_outstanding,
+					faxil_wr_outstanding,
+					faxil_awr_outstanding;
+
+	faxil_slave #(
+		// {{{
+		.C_AXI_DATA_WIDTH(C_AXI_DATA_WIDTH),
+		.C_AXI_ADDR_WIDTH(C_AXI_ADDR_WIDTH),
+		.F_LGDEPTH(F_AXIL_LGDEPTH),
+		.F_AXI_MAXWAIT(2),
+		.F_AXI_MAXDELAY(2),
+		.F_AXI_MAXRSTALL(3),
+		.F_OPT_COVER_BURST(4)
+		// }}}
+	) faxil(
+		// {{{
+		.i_clk(S_AXI_ACLK), .i_axi_reset_n(S_AXI_ARESETN),
+		//
+		.i_axi_awvalid(S_AXI_AWVALID),
+		.i_axi_awready(S_AXI_AWREADY),
+		.i_axi_awaddr( S_AXI_AWADDR),
+		.i_axi_awcache(4'h0),
+		.i_axi_awprot( S_AXI_AWPROT),
+		//
+		.i_axi_wvalid(S_AXI_WVALID),
+		.i_axi_wready(S_AXI_WREADY),
+		.i_axi_wdata( S_AXI_WDATA),
+		.i_axi_wstrb( S_AXI_WSTRB),
+		//
+		.i_axi_bvalid(S_AXI_BVALID),
+		.i_axi_bready(S_AXI_BREADY),
+		.i_axi_bresp( S_AXI_BRESP),
+		//
+		.i_axi_arvalid(S_AXI_ARVALID),
+		.i_axi_arready(S_AXI_ARREADY),
+		.i_axi_araddr( S_AXI_ARADDR),
+		.i_axi_arcache(4'h0),
+		.i_axi_arprot( S_AXI_ARPROT),
+		//
+		.i_axi_rvalid(S_AXI_RVALID),
+		.i_axi_rready(S_AXI_RREADY),
+		.i_axi_rdata( S_AXI_RDATA),
+		.i_axi_rresp( S_AXI_RRESP),
+		//
+		.f_axi_rd_outstanding(faxil_rd_outstanding),
+		.f_axi_wr_outstanding(faxil_wr_outstanding),
+		.f_axi_awr_outstanding(faxil_awr_outstanding)
+		// }}}
+		);
+
+	always @(*)
+	begin
+		assert(faxil_awr_outstanding== (S_AXI_BVALID ? 1:0)
+			+(S_AXI_AWREADY ? 0:1));
+		assert(faxil_wr_outstanding == (S_AXI_BVALID ? 1:0)
+			+(S_AXI_WREADY ? 0:1));
+
+		assert(faxil_rd_outstanding == (S_AXI_RVALID ? 1:0)
+			+(S_AXI_ARREADY ? 0:1));
+	end
+
+	always @(posedge S_AXI_ACLK)
+	if (f_past_valid && $past(S_AXI_ARESETN
+			&& axil_read_ready))
+	begin
+		assert(S_AXI_RVALID);
+		case($past(arskd_addr))
+		0: assert(S_AXI_RDATA == $past(rate_word));
+		2: assert(S_AXI_RDATA == $past(pkt_len));
+		4: assert(S_AXI_RDATA == $past(beat_counts));
+		endcase
+	end
+
+	//
+	// Check that our low-power only logic works by verifying that anytime
+	// S_AXI_RVALID is inactive, then the outgoing data is also zero.
+	//
+	always @(*)
+	if (OPT_LOWPOWER && !S_AXI_RVALID)
+		assert(S_AXI_RDATA == 0);
+
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// AXI stream properties
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	// Once raised, TVALID must stay high, and TDATA and TLAST must stay
+	// constant, until the beat is accepted.
+	always @(posedge S_AXI_ACLK)
+	if (f_past_valid && $past(S_AXI_ARESETN)
+			&& $past(M_AXIS_TVALID && !M_AXIS_TREADY))
+	begin
+		assert(M_AXIS_TVALID);
+		assert($stable(M_AXIS_TDATA));
+		assert($stable(M_AXIS_TLAST));
+	end
+
+	// }}}
+	////////////////////////////////////////////////////////////////////////
+	//
+	// Cover checks
+	//
+	////////////////////////////////////////////////////////////////////////
+	//
+	// {{{
+
+	always @(posedge S_AXI_ACLK)
+	if (S_AXI_ARESETN && pkt_len == 4)
+		cover(M_AXIS_TVALID && M_AXIS_TREADY && M_AXIS_TLAST
+			&& packet_counts == 2);
+
+	// }}}
+	// }}}
+`endif
+endmodule
@@ -7,7 +7,7 @@
 // Computer Generated: This file is computer generated by AUTOFPGA. DO NOT EDIT.
 // DO NOT EDIT THIS FILE!
 //
-// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt vibus.txt noconsole.txt
+// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axiram2.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt streamcheck.txt qos.txt vibus.txt noconsole.txt
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -105,7 +105,7 @@ module	toplevel(
 	// {{{
 	input	wire				S_AXI_AWVALID;
 	output	wire				S_AXI_AWREADY;
-	input	wire [25-1:0]	S_AXI_AWADDR;
+	input	wire [34-1:0]	S_AXI_AWADDR;
 	//
 	input	wire				S_AXI_WVALID;
 	output	wire				S_AXI_WREADY;
@@ -118,7 +118,7 @@ module	toplevel(
 	//
 	input	wire				S_AXI_ARVALID;
 	output	wire				S_AXI_ARREADY;
-	input	wire [25-1:0]	S_AXI_ARADDR;
+	input	wire [34-1:0]	S_AXI_ARADDR;
 	//
 	output	wire					S_AXI_RVALID;
 	input	wire					S_AXI_RREADY;
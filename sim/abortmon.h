@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/abortmon.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Watches one data mover across an abort.  Counts the mover's
+//		AXI data beats, its stream beats (into the stream sink for the
+//	MM2S, out of the stream source for the S2MM), and the bursts it has
+//	outstanding: read bursts from AR until RLAST, write bursts from AW
+//	until B.  Once armed, it watches the mover's AXI-lite control port,
+//	and on the clock that port accepts the abort write (both AW and W) it
+//	snapshots all three, so that what the mover did afterwards--how long it
+//	took to drain, how many bursts it still had to finish, and how much
+//	data still moved--may be measured from the mover's own view of the
+//	abort, rather than from the host's.  It also notes the first bus error
+//	(SLVERR or DECERR) the mover receives, so that a bus error may be
+//	measured the same way.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	ABORTMON_H
+#define	ABORTMON_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "aximon.h"
+
+#define	ABORTMON_BIND(P)	do {					\
+	m_arvalid = &core->VVAR(_axi_ ## P ## _arvalid);		\
+	m_arready = &core->VVAR(_axi_ ## P ## _arready);		\
+	m_rvalid  = &core->VVAR(_axi_ ## P ## _rvalid);			\
+	m_rready  = &core->VVAR(_axi_ ## P ## _rready);			\
+	m_rlast   = &core->VVAR(_axi_ ## P ## _rlast);			\
+	m_rresp   = &core->VVAR(_axi_ ## P ## _rresp);			\
+	m_awvalid = &core->VVAR(_axi_ ## P ## _awvalid);		\
+	m_awready = &core->VVAR(_axi_ ## P ## _awready);		\
+	m_wvalid  = &core->VVAR(_axi_ ## P ## _wvalid);			\
+	m_wready  = &core->VVAR(_axi_ ## P ## _wready);			\
+	m_bvalid  = &core->VVAR(_axi_ ## P ## _bvalid);			\
+	m_bready  = &core->VVAR(_axi_ ## P ## _bready);			\
+	m_bresp   = &core->VVAR(_axi_ ## P ## _bresp);			\
+	m_cawvalid = &core->VVAR(_axil_ ## P ## _awvalid);		\
+	m_cawready = &core->VVAR(_axil_ ## P ## _awready);		\
+	m_cwvalid  = &core->VVAR(_axil_ ## P ## _wvalid);		\
+	m_cwready  = &core->VVAR(_axil_ ## P ## _wready);		\
+	} while(0)
+
+//
+// ABORTMON
+// {{{
+class	ABORTMON : public TICKMON {
+	CData	*m_arvalid, *m_arready, *m_rvalid, *m_rready, *m_rlast,
+		*m_awvalid, *m_awready, *m_wvalid, *m_wready,
+		*m_bvalid, *m_bready, *m_rresp, *m_bresp,
+		*m_tvalid, *m_tready;
+	// The mover's AXI-lite control port, where the abort arrives
+	CData	*m_cawvalid, *m_cawready, *m_cwvalid, *m_cwready;
+	bool	m_armed, m_caw, m_cw;
+
+	void	abort(unsigned long clk) {
+		m_abort     = clk;
+		m_at_beats  = m_beats;
+		m_at_stream = m_stream;
+		m_at_bursts = outstanding();
+	}
+public:
+	// Running totals
+	unsigned long	m_beats, m_stream, m_rbursts, m_wbursts;
+	// The clock the abort reached the mover, and the totals at that time
+	unsigned long	m_abort, m_at_beats, m_at_stream, m_at_bursts;
+	// The last clock with any AXI beat, or B response
+	unsigned long	m_last;
+	// The clock of the first bus error, and its response
+	unsigned long	m_error;
+	unsigned	m_errresp;
+
+	ABORTMON(Vmain *core, int master) {
+		// {{{
+		m_tvalid = m_tready = NULL;
+		switch(master) {
+		case AXIMON::MM2S:
+			ABORTMON_BIND(mm2s);
+			m_tvalid = &core->VVAR(_streamsink_tvalid);
+			m_tready = &core->VVAR(_streamsink_tready);
+			break;
+		case AXIMON::S2MM:
+			ABORTMON_BIND(s2mm);
+			m_tvalid = &core->VVAR(_streamsrc_tvalid);
+			m_tready = &core->VVAR(_streamsrc_tready);
+			break;
+		default:
+			ABORTMON_BIND(dma);
+			break;
+		}
+
+		clear();
+	}
+	// }}}
+
+	void	clear(void) {
+		m_beats = m_stream = m_rbursts = m_wbursts = 0;
+		m_abort = m_at_beats = m_at_stream = m_at_bursts = 0;
+		m_last = 0;
+		m_error = 0;
+		m_errresp = 0;
+		m_armed = m_caw = m_cw = false;
+	}
+
+	// Bursts requested, yet not yet complete
+	unsigned long	outstanding(void) const {
+		return m_rbursts + m_wbursts;
+	}
+
+	// To be called just before the abort is written.  The next write to
+	// the mover's control port is taken to be the abort.
+	void	arm(void) {
+		m_armed = true;
+		m_caw = m_cw = false;
+	}
+
+	bool	aborted(void) const { return m_abort != 0; }
+
+	// AXI beats, and stream beats, following the abort
+	unsigned long	beats_after(void) const { return m_beats - m_at_beats; }
+	unsigned long	stream_after(void) const {
+		return m_stream - m_at_stream; }
+
+	// Clocks from the abort until the last AXI beat or response
+	unsigned long	drain(void) const {
+		return (m_last > m_abort) ? m_last - m_abort : 0;
+	}
+
+	virtual	void	tick(unsigned long clk) {
+		// {{{
+		if (*m_arvalid && *m_arready)
+			m_rbursts++;
+		if (*m_awvalid && *m_awready)
+			m_wbursts++;
+		if (*m_rvalid && *m_rready) {
+			m_beats++;
+			m_last = clk;
+			if (*m_rresp != 0 && m_error == 0) {
+				m_error   = clk;
+				m_errresp = *m_rresp;
+			}
+			if (*m_rlast && m_rbursts > 0)
+				m_rbursts--;
+		} if (*m_wvalid && *m_wready) {
+			m_beats++;
+			m_last = clk;
+		} if (*m_bvalid && *m_bready) {
+			m_last = clk;
+			if (*m_bresp != 0 && m_error == 0) {
+				m_error   = clk;
+				m_errresp = *m_bresp;
+			}
+			if (m_wbursts > 0)
+				m_wbursts--;
+		}
+
+		if (m_tvalid && *m_tvalid && *m_tready)
+			m_stream++;
+
+		if (m_armed) {
+			if (*m_cawvalid && *m_cawready)
+				m_caw = true;
+			if (*m_cwvalid && *m_cwready)
+				m_cw = true;
+			if (m_caw && m_cw) {
+				m_armed = false;
+				abort(clk);
+			}
+		}
+	}
+	// }}}
+};
+// }}}
+#endif
@@ -52,22 +52,43 @@
 // #include "port.h"
 #include "main_tb.cpp"
 #include "axi_tb.h"
+#include "dramsim.h"
+#include "reordersim.h"
+#include "errsim.h"
+#include "aximon.h"
+#include "axisample.h"
+#include "axitrace.h"
+#include "axiwatch.h"
+#include "abortmon.h"
+#include "gapmon.h"
+#include "togglemon.h"
+#include "verifier.h"
+#include "scenario.h"
 
-#define	TBRAM	m_tb->m_core->AXIRAM
+// TBRAM is the AXI RAM as an array of 32-bit words, whatever the bus width
+#define	TBRAM	m_tb->axiram_words()
+// CLEARRAM(F) sets every word of the AXI RAM to F
+#define	CLEARRAM	m_tb->axiram_clear
 
-#define	MM2S_START_ADDR		0x24
+// Test addresses are aligned to the bus word size, so that each test measures
+// the same thing regardless of how wide the bus is
+#define	BUSBYTES		(AXIBUS_WIDTH/8)
+#define	BUSALIGN(A)		((A) & -BUSBYTES)
+
+#define	MM2S_START_ADDR		BUSALIGN(0x24)
 #define	MM2S_LENGTH		32768 // 262144
 #define	MM2S_START_ADDRW	(MM2S_START_ADDR/4)
 #define	MM2S_LENGTHW		(MM2S_LENGTH/4)
 #define	MM2S_START_CMD		0xc0000000
 #define	MM2S_ABORT_CMD		0x6d000000
 #define	MM2S_CONTINUOUS		0x10000000
+#define	MM2S_ERR		0x40000000
 #define	MM2S_BUSY		0x80000000
 
-#define	S2MM_START_ADDR		0x30
+#define	S2MM_START_ADDR		BUSALIGN(0x30)
 #define	S2MM_LENGTH		32768 // 262144
-#define	S2MM_START_ADDRW	(MM2S_START_ADDR/4)
-#define	S2MM_LENGTHW		(MM2S_LENGTH/4)
+#define	S2MM_START_ADDRW	(S2MM_START_ADDR/4)
+#define	S2MM_LENGTHW		(S2MM_LENGTH/4)
 #define	S2MM_START_CMD		0xc0000000
 #define	S2MM_ABORT_CMD		0x26000000
 #define	S2MM_CONTINUOUS		0x10000000
@@ -76,6 +97,9 @@
 
 #define	DMA_START_CMD		0x00000011
 #define	DMA_BUSY_BIT		0x00000001
+#define	DMA_ERR_BIT		0x00000010
+#define	DMA_ABORT_CMD		0x00006d00
+#define	DMA_TIMEOUT		400000	// Clocks, from the DMA's start
 // Extra realignment read (only)
 // #define	DMA_SRC_ADDR		0x00000203
 // #define	DMA_DST_ADDR		0x00008201
@@ -86,15 +110,1583 @@
 #define	DMA_DST_ADDR		0x00008202
 #define	DMA_LENGTH		0x00000403
 
+// Stream sink backpressure modes, written to R_STREAMSINK_BPCTRL
+#define	BP_NONE			0
+#define	BP_DUTY			1
+#define	BP_RANDOM		2
+#define	BP_BURST		3
+#define	BP_REPLAY		4
+#define	BPARG(ON,OFF)		((((OFF)&0x0ffff)<<16)|((ON)&0x0ffff))
+#define	BP_MAXTRACE		1023	// Clocks, set by LGTRACE in the RTL
+
+// Stream checker sequences, written to R_STREAMCHK_CTRL
+#define	CHK_NONE		0
+#define	CHK_COUNTER		1
+#define	CHK_LFSR		2
+#define	CHK_ERR			0x80000000
+
+// Concurrent (contention) test: memory regions for each master
+#define	CONTEND_MM2S_ADDR	0x00100000
+#define	CONTEND_S2MM_ADDR	0x00200000
+#define	CONTEND_DMA_SRC		0x00300000
+#define	CONTEND_DMA_DST		0x00400000
+#define	CONTEND_MAXLEN		0x00100000
+#define	CONTEND_LENGTH		32768
+
+// Stream source controls, written to R_STREAMSRC_RATE and R_STREAMSRC_BURST
+#define	SRC_RATE(N,M)		((((M)&0x0ffff)<<16)|((N)&0x0ffff))
+#define	SRC_BURST(BEATS,IDLE)	((((IDLE)&0x0ffff)<<16)|((BEATS)&0x0ffff))
+
+// If requested (-s), the throughput of the whole run is sampled into a file
+AXISAMPLE	*sampler = NULL;
+// Checks the RAM after each test, while the simulation moves on
+VERIFIER	*verifier = NULL;
+
+// mark()
+// {{{
+// Labels the sampled time series, and the host profile, (if any) with the
+// name of the next test
+void	mark(const char *name) {
+	if (sampler)
+		sampler->mark(name);
+	if (hostprof)
+		hostprof->phase(name);
+}
+// }}}
+
+// perfline()
+// {{{
+// Prints a one line, machine readable, summary of a test's throughput.
+// sim/buswidths.sh collects these lines across bus widths, and
+// sim/configs.sh across design configurations.
+void	perfline(const char *name, unsigned long bytes, unsigned long clocks) {
+	printf("PERF: %-20s %3d %10lu %10lu\n", name, AXIBUS_WIDTH,
+		bytes, clocks);
+}
+// }}}
+
+// elapsed()
+// {{{
+// Wall clock seconds since the first call
+double	elapsed(void) {
+	static	struct timespec	start = { 0, 0 };
+	struct	timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	if (start.tv_sec == 0 && start.tv_nsec == 0)
+		start = now;
+	return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec)*1e-9;
+}
+// }}}
+
+// backpressure()
+// {{{
+// Sets the stream sink's TREADY pattern.  See rtl/streamcounter.v for the
+// meaning of each mode and its argument.
+void	backpressure(AXI_TB<MAINTB> *tb, unsigned mode, unsigned arg,
+		unsigned seed = 1) {
+	tb->writeio(R_STREAMSINK_BPSEED, seed);
+	tb->writeio(R_STREAMSINK_BPARG,  arg);
+	tb->writeio(R_STREAMSINK_BPCTRL, mode);
+}
+// }}}
+
+// sinkstats()
+// {{{
+// Reads and prints the stream sink's arrival statistics: the latency from
+// the MM2S start to its first beat, the longest gap in TVALID, the number of
+// clocks the sink stalled, and a histogram of the clocks between beats.
+void	sinkstats(AXI_TB<MAINTB> *tb) {
+	static const char *const	bins[] = { "0", "1", "2-3", "4-15", "16+" };
+	unsigned	hist[5], total = 0;
+
+	for(int k=0; k<5; k++) {
+		hist[k] = tb->readio(R_STREAMSINK_HIST0 + 4*k);
+		total += hist[k];
+	}
+
+	printf("\tLATENCY: %u clocks\n", tb->readio(R_STREAMSINK_LATENCY));
+	printf("\tMAXGAP:  %u clocks\n", tb->readio(R_STREAMSINK_MAXGAP));
+	printf("\tSTALLS:  %u clocks\n", tb->readio(R_STREAMSINK_STALLS));
+	printf("\tGAPS:   ");
+	for(int k=0; k<5; k++)
+		printf(" %s:%u(%.1f%%)", bins[k], hist[k],
+			(total > 0) ? 100.0 * hist[k] / total : 0.0);
+	printf("\n");
+}
+// }}}
+
+// load_bptrace()
+// {{{
+// Reads a TREADY trace, one '0' or '1' character per clock, from the given
+// file and loads it into the stream sink for replay.  All other characters
+// are ignored.  Returns the number of clocks in the trace, or zero on error.
+unsigned	load_bptrace(AXI_TB<MAINTB> *tb, const char *fname) {
+	FILE		*fp;
+	unsigned	nbits = 0, word = 0;
+	int		ch;
+
+	fp = fopen(fname, "r");
+	if (NULL == fp) {
+		fprintf(stderr, "ERR: Cannot open backpressure trace, %s\n",
+			fname);
+		return 0;
+	}
+
+	// Writing BPCTRL resets the trace write pointer
+	tb->writeio(R_STREAMSINK_BPCTRL, BP_NONE);
+	while(nbits < BP_MAXTRACE && (ch = fgetc(fp)) != EOF) {
+		if (ch != '0' && ch != '1')
+			continue;
+		if (ch == '1')
+			word |= 1u << (nbits & 31);
+		nbits++;
+		if ((nbits & 31) == 0) {
+			tb->writeio(R_STREAMSINK_BPTRACE, word);
+			word = 0;
+		}
+	} if (nbits & 31)
+		tb->writeio(R_STREAMSINK_BPTRACE, word);
+	fclose(fp);
+
+	if (nbits == 0)
+		fprintf(stderr, "ERR: No trace found in %s\n", fname);
+	return nbits;
+}
+// }}}
+
+// crc32()
+// {{{
+// The same CRC-32 the stream checker keeps, computed over a buffer in memory
+unsigned	crc32(const void *buf, unsigned len) {
+	const unsigned char	*ptr = (const unsigned char *)buf;
+	unsigned		crc = 0xffffffff;
+
+	for(unsigned k=0; k<len; k++) {
+		crc ^= ptr[k];
+		for(int b=0; b<8; b++)
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xedb88320 : 0);
+	}
+
+	return ~crc;
+}
+// }}}
+
+// checkstream()
+// {{{
+// Restarts the stream checker, expecting the given sequence from seed
+void	checkstream(AXI_TB<MAINTB> *tb, unsigned mode, unsigned seed = 0) {
+	tb->writeio(R_STREAMCHK_SEED, seed);
+	tb->writeio(R_STREAMCHK_CTRL, mode);
+}
+// }}}
+
+// verifystream()
+// {{{
+// Reads the stream checker's results, and compares them against the words
+// (and their CRC) that the MM2S should have sent.  Returns true if the stream
+// matched.
+bool	verifystream(AXI_TB<MAINTB> *tb, unsigned nwords, unsigned crc) {
+	unsigned	words, errors, ctrl, chkcrc;
+
+	ctrl   = tb->readio(R_STREAMCHK_CTRL);
+	words  = tb->readio(R_STREAMCHK_WORDS);
+	errors = tb->readio(R_STREAMCHK_ERRORS);
+	chkcrc = tb->readio(R_STREAMCHK_CRC);
+
+	printf("\tCHECK:   %u words, %u errors, CRC 0x%08x\n",
+		words, errors, chkcrc);
+	if (ctrl & CHK_ERR)
+		printf("\tFIRST:   Word %u was 0x%08x, not 0x%08x\n",
+			tb->readio(R_STREAMCHK_ERRIDX),
+			tb->readio(R_STREAMCHK_ERRDATA),
+			tb->readio(R_STREAMCHK_ERREXP));
+
+	if (words != nwords || errors != 0 || chkcrc != crc) {
+		printf("\tERR: Stream mismatch, expected %u words, CRC 0x%08x\n",
+			nwords, crc);
+		return false;
+	} return true;
+}
+// }}}
+
+// streamsrc()
+// {{{
+// Sets the rate, burst pattern, and packet length of the stream source feeding
+// the S2MM, and restarts its counter at zero.  See rtl/streamsource.v.  All
+// zeros returns the source to its default of one single-beat packet per clock.
+void	streamsrc(AXI_TB<MAINTB> *tb, unsigned rate, unsigned burst,
+		unsigned pktlen) {
+	tb->writeio(R_STREAMSRC_RATE,   rate);
+	tb->writeio(R_STREAMSRC_BURST,  burst);
+	tb->writeio(R_STREAMSRC_PKTLEN, pktlen);
+	tb->writeio(R_STREAMSRC_RESTART, 0);
+	tb->writeio(R_STREAMSRC_BEATS,  0);
+}
+// }}}
+
+// Concurrent contention test
+// {{{
+// Runs the MM2S, the S2MM, and the DMA all at once, each starting at its
+// own offset (in clocks) from the first, and reports how the interconnect
+// divided the AXI RAM's bandwidth between them.
+typedef	struct	{
+	const char	*m_name;
+	unsigned	m_len, m_offset;
+} CONTEND;
+
+// parse_contend()
+// {{{
+// Spec is a comma separated list of <master>=<length>[@<offset>], as in
+// "mm2s=65536@0,dma=4096@200".  A length of zero leaves a master out.
+bool	parse_contend(const char *spec, CONTEND *c) {
+	char	*str = strdup(spec), *tok, *ptr;
+	bool	ok = true;
+
+	for(tok=strtok(str, ","); tok && ok; tok=strtok(NULL, ",")) {
+		char	*eq = strchr(tok, '=');
+		int	m;
+
+		if (!eq) {
+			ok = false;
+			break;
+		} *eq++ = '\0';
+
+		for(m=0; m<AXIMON::NMASTERS; m++)
+			if (0 == strcasecmp(tok, c[m].m_name))
+				break;
+		if (m >= AXIMON::NMASTERS) {
+			ok = false;
+			break;
+		}
+
+		c[m].m_len = strtoul(eq, &ptr, 0);
+		if (*ptr == '@')
+			c[m].m_offset = strtoul(ptr+1, &ptr, 0);
+		if (*ptr != '\0' || c[m].m_len > CONTEND_MAXLEN)
+			ok = false;
+	}
+
+	if (!ok)
+		fprintf(stderr, "ERR: Cannot parse contention spec, %s\n", spec);
+	free(str);
+	return ok;
+}
+// }}}
+
+bool	contend(AXI_TB<MAINTB> *tb, const CONTEND *c) {
+	// {{{
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL },
+			cmd[AXIMON::NMASTERS]
+				= { MM2S_START_CMD, S2MM_START_CMD, DMA_START_CMD },
+			busy[AXIMON::NMASTERS]
+				= { MM2S_BUSY, S2MM_BUSY, DMA_BUSY_BIT };
+	AXIMON		mon(tb->m_tb->m_core);
+	int		order[AXIMON::NMASTERS];
+	unsigned long	start;
+	bool		fail = false;
+	char		name[32];
+
+	// Set up the memory and the masters
+	// {{{
+	tb->CLEARRAM(-1);
+	for(unsigned k=0; k<c[AXIMON::MM2S].m_len/4; k++)
+		tb->TBRAM[CONTEND_MM2S_ADDR/4 + k] = k;
+	for(unsigned k=0; k<c[AXIMON::DMA].m_len/4; k++)
+		tb->TBRAM[CONTEND_DMA_SRC/4 + k] = k ^ 0x5a5a0000;
+
+	if (c[AXIMON::MM2S].m_len) {
+		tb->write64(R_MM2SADDRLO, (uint64_t)CONTEND_MM2S_ADDR + R_AXIRAM);
+		tb->write64(R_MM2SLENLO,  (uint64_t)c[AXIMON::MM2S].m_len);
+		tb->writeio(R_STREAMSINK_BEATS, 0);
+		checkstream(tb, CHK_COUNTER);
+	} if (c[AXIMON::S2MM].m_len) {
+		tb->write64(R_S2MMADDRLO, (uint64_t)CONTEND_S2MM_ADDR + R_AXIRAM);
+		tb->write64(R_S2MMLENLO,  (uint64_t)c[AXIMON::S2MM].m_len);
+		streamsrc(tb, 0, 0, 0);
+	} if (c[AXIMON::DMA].m_len) {
+		tb->write64(R_AXIDMASRCLO, (uint64_t)CONTEND_DMA_SRC + R_AXIRAM);
+		tb->write64(R_AXIDMADSTLO, (uint64_t)CONTEND_DMA_DST + R_AXIRAM);
+		tb->write64(R_AXIDMALENLO, (uint64_t)c[AXIMON::DMA].m_len);
+	}
+	// }}}
+
+	// Start each master in order of its offset
+	// {{{
+	for(int m=0; m<AXIMON::NMASTERS; m++) {
+		int	k = m;
+
+		for(; k>0 && c[order[k-1]].m_offset > c[m].m_offset; k--)
+			order[k] = order[k-1];
+		order[k] = m;
+	}
+
+	mon.clear();
+	tb->addmon(&mon);
+	mark("AXI-contend");
+	start = tb->tickcount();
+	for(int k=0; k<AXIMON::NMASTERS; k++) {
+		int	m = order[k];
+
+		if (c[m].m_len == 0)
+			continue;
+		while(tb->tickcount() - start < c[m].m_offset)
+			tb->idle();
+		tb->writeio(ctrl[m], cmd[m]);
+	}
+
+	for(int m=0; m<AXIMON::NMASTERS; m++) {
+		if (c[m].m_len == 0)
+			continue;
+		while(tb->readio(ctrl[m]) & busy[m])
+			;
+	}
+	tb->delmon(&mon);
+	// }}}
+
+	printf("Contention Check:\n");
+	for(int m=0; m<AXIMON::NMASTERS; m++)
+		printf("\t%-5s LEN: 0x%08x, OFFSET: %u\n", c[m].m_name,
+			c[m].m_len, c[m].m_offset);
+	mon.report(stdout, BUSBYTES);
+	for(int m=0; m<AXIMON::NMASTERS; m++) {
+		if (!mon.active(m))
+			continue;
+		snprintf(name, sizeof(name), "CONTEND-%s", c[m].m_name);
+		perfline(name, mon.bytes(m, BUSBYTES), mon.window(m));
+	}
+
+	// Check what each master moved.  Any verifier failures are reported,
+	// and fail the run, from verifier->finish().
+	if (c[AXIMON::MM2S].m_len && !verifystream(tb,
+			c[AXIMON::MM2S].m_len/4,
+			crc32(&tb->TBRAM[CONTEND_MM2S_ADDR/4],
+				c[AXIMON::MM2S].m_len)))
+		fail = true;
+	if (c[AXIMON::S2MM].m_len) {
+		if (tb->readio(R_S2MMCTRL) & S2MM_ERR) {
+			printf("\tERR: The S2MM ended in an error\n");
+			fail = true;
+		}
+		verifier->increment("Contention S2MM", tb->TBRAM,
+			CONTEND_S2MM_ADDR/4, c[AXIMON::S2MM].m_len/4);
+	}
+	if (c[AXIMON::DMA].m_len && (tb->readio(R_AXIDMACTRL) & DMA_ERR_BIT)) {
+		printf("\tERR: The DMA ended in an error\n");
+		fail = true;
+	}
+	verifier->match("Contention DMA", tb->TBRAM, CONTEND_DMA_DST/4,
+		CONTEND_DMA_SRC/4, c[AXIMON::DMA].m_len/4);
+
+	return !fail;
+}
+// }}}
+// }}}
+
+// Worst case search
+// {{{
+// Runs randomly chosen (mode, load, src, dst, len) cases through the movers,
+// keeps the slowest, and then shrinks each of those into the simplest case
+// that's still as slow.  Each case is scored against the same transfer, with
+// the same load, but starting from 4kB aligned addresses, so that the score
+// measures what the addresses cost--boundary splits, realignment--rather
+// than how short the transfer was.
+#define	WC_NONE			AXIMON::NMASTERS	// No concurrent load
+#define	WC_REGION		0x00080000	// DMA dst is in the second
+#define	WC_MAXLEN		0x00004000
+#define	WC_KEEP			4
+#define	WC_SHRINK		0.9	// Accept 90% of the original score
+#define	WC_TIMEOUT		200000
+
+typedef	struct	{
+	int		m_mode, m_load;
+	unsigned	m_src, m_dst, m_len;
+	double		m_rate, m_score;
+} WCASE;
+
+static	const char	*wcname[AXIMON::NMASTERS+1]
+				= { "mm2s", "s2mm", "dma", "none" };
+// Set if a mover never went idle, even once aborted.  Nothing after can be
+// trusted, so this ends the search.
+static	bool	wcstuck = false;
+
+// wcrand()
+// {{{
+// A repeatable xorshift generator, so that a seed always produces the same
+// cases, independent of anything else calling rand()
+static	unsigned	wcseed = 1;
+unsigned	wcrand(void) {
+	wcseed ^= wcseed << 13;
+	wcseed ^= wcseed >> 17;
+	wcseed ^= wcseed << 5;
+	return wcseed;
+}
+// }}}
+
+// moverset()
+// {{{
+// Programs master m without starting it.  The MM2S reads from src, the S2MM
+// writes to dst, and the DMA copies from src to dst.  Both are bus addresses.
+void	moverset(AXI_TB<MAINTB> *tb, int m, uint64_t src, uint64_t dst,
+		unsigned len) {
+	switch(m) {
+	case AXIMON::MM2S:
+		tb->write64(R_MM2SADDRLO, src);
+		tb->write64(R_MM2SLENLO,  (uint64_t)len);
+		break;
+	case AXIMON::S2MM:
+		tb->write64(R_S2MMADDRLO, dst);
+		tb->write64(R_S2MMLENLO,  (uint64_t)len);
+		break;
+	case AXIMON::DMA:
+		tb->write64(R_AXIDMASRCLO, src);
+		tb->write64(R_AXIDMADSTLO, dst);
+		tb->write64(R_AXIDMALENLO, (uint64_t)len);
+		break;
+	default: break;
+	}
+}
+// }}}
+
+// moverstart()
+// {{{
+// Starts master m, as last programmed
+void	moverstart(AXI_TB<MAINTB> *tb, int m) {
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL },
+			startcmd[AXIMON::NMASTERS]
+				= { MM2S_START_CMD, S2MM_START_CMD, DMA_START_CMD };
+
+	tb->writeio(ctrl[m], startcmd[m]);
+}
+// }}}
+
+// moverat()
+// {{{
+// Programs and starts master m, as in moverset()
+void	moverat(AXI_TB<MAINTB> *tb, int m, uint64_t src, uint64_t dst,
+		unsigned len) {
+	moverset(tb, m, src, dst, len);
+	moverstart(tb, m);
+}
+// }}}
+
+// mover()
+// {{{
+// As moverat(), with src and dst given as offsets into the AXI RAM
+void	mover(AXI_TB<MAINTB> *tb, int m, unsigned src, unsigned dst,
+		unsigned len) {
+	moverat(tb, m, (uint64_t)src + R_AXIRAM, (uint64_t)dst + R_AXIRAM, len);
+}
+// }}}
+
+// moverbusy()
+// {{{
+bool	moverbusy(AXI_TB<MAINTB> *tb, int m) {
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL },
+			busy[AXIMON::NMASTERS]
+				= { MM2S_BUSY, S2MM_BUSY, DMA_BUSY_BIT };
+
+	return (tb->readio(ctrl[m]) & busy[m]) != 0;
+}
+// }}}
+
+// moverabort()
+// {{{
+// Aborts master m, and then waits no more than timeout clocks for it to go
+// idle.  Returns true if it did.
+bool	moverabort(AXI_TB<MAINTB> *tb, int m, unsigned long timeout) {
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL },
+			abortcmd[AXIMON::NMASTERS]
+				= { MM2S_ABORT_CMD, S2MM_ABORT_CMD, DMA_ABORT_CMD };
+	unsigned long	start = tb->tickcount();
+
+	tb->writeio(ctrl[m], abortcmd[m]);
+	while(moverbusy(tb, m))
+		if (tb->tickcount() - start > timeout)
+			return false;
+	return true;
+}
+// }}}
+
+// wcrun()
+// {{{
+// Runs one case, src and dst as given, and returns the rate the mode under
+// test achieved in bytes per clock, from its first request to its last beat.
+// Zero means the case never finished, and any mover still running by then has
+// been aborted.
+double	wcrun(AXI_TB<MAINTB> *tb, const WCASE &w, unsigned src, unsigned dst) {
+	AXIMON		mon(tb->m_tb->m_core);
+	unsigned long	start;
+	bool		timeout = false;
+
+	mon.clear();
+	tb->addmon(&mon);
+	if (w.m_load != WC_NONE) {
+		// Keep the load busy for (roughly) the entire case
+		unsigned	ln = w.m_len * 4;
+
+		if (ln > CONTEND_MAXLEN)
+			ln = CONTEND_MAXLEN;
+		ln = BUSALIGN(ln);
+		mover(tb, w.m_load,
+			(w.m_load == AXIMON::DMA) ? CONTEND_DMA_SRC
+						: CONTEND_MM2S_ADDR,
+			(w.m_load == AXIMON::DMA) ? CONTEND_DMA_DST
+						: CONTEND_S2MM_ADDR, ln);
+	}
+
+	mover(tb, w.m_mode, src, dst, w.m_len);
+	start = tb->tickcount();
+	while(moverbusy(tb, w.m_mode) && !timeout)
+		timeout = (tb->tickcount() - start > WC_TIMEOUT);
+	while(w.m_load != WC_NONE && moverbusy(tb, w.m_load) && !timeout)
+		timeout = (tb->tickcount() - start > WC_TIMEOUT);
+	tb->delmon(&mon);
+
+	if (timeout) {
+		// Stop anything still running, so it can't spill into the
+		// next case
+		if (moverbusy(tb, w.m_mode)
+				&& !moverabort(tb, w.m_mode, WC_TIMEOUT))
+			wcstuck = true;
+		if (w.m_load != WC_NONE && moverbusy(tb, w.m_load)
+				&& !moverabort(tb, w.m_load, WC_TIMEOUT))
+			wcstuck = true;
+	}
+
+	if (timeout || mon.window(w.m_mode) == 0) {
+		printf("WORST: %s, len 0x%x from 0x%08x to 0x%08x, "
+			"did not complete\n", wcname[w.m_mode], w.m_len,
+			src, dst);
+		return 0.0;
+	}
+
+	return w.m_len / (double)mon.window(w.m_mode);
+}
+// }}}
+
+// wcscore()
+// {{{
+// Scores a case as the slowdown from its aligned twin.  Greater is worse.
+// Returns false if either run failed to complete.
+bool	wcscore(AXI_TB<MAINTB> *tb, WCASE &w) {
+	double	base = 0.0;
+
+	w.m_rate = (wcstuck) ? 0.0 : wcrun(tb, w, w.m_src, w.m_dst);
+	if (!wcstuck)
+		base = wcrun(tb, w, 0, WC_REGION);
+	if (w.m_rate <= 0.0 || base <= 0.0) {
+		w.m_score = 0.0;
+		return false;
+	}
+
+	w.m_score = base / w.m_rate;
+	return true;
+}
+// }}}
+
+// wcrandom()
+// {{{
+// Generates a random case.  Addresses favor the bytes either side of a 4kB
+// boundary, and lengths favor powers of two plus or minus one, since that's
+// where the edge cases are.  The MM2S and S2MM only get whole bus words.
+void	wcrandom(WCASE &w) {
+	unsigned	r;
+
+	w.m_mode = wcrand() % AXIMON::NMASTERS;
+	w.m_load = wcrand() % AXIMON::NMASTERS;
+	if (w.m_load == w.m_mode || (wcrand() & 1))
+		w.m_load = WC_NONE;
+
+	for(int k=0; k<2; k++) {
+		unsigned	*a = (k == 0) ? &w.m_src : &w.m_dst;
+
+		r = wcrand();
+		*a = r % (WC_REGION - WC_MAXLEN);
+		if (r & 0x80000000) // Just shy of a 4kB boundary
+			*a = (*a | 0x0fff) - ((r >> 20) & 0x3f);
+	} w.m_dst += WC_REGION;
+
+	r = wcrand();
+	if (r & 1) {
+		// 2^n, 2^n-1, or 2^n+1
+		w.m_len = 1u << ((r >> 1) % 15);
+		w.m_len += ((r >> 5) % 3) - 1;
+	} else
+		w.m_len = (r >> 1) % WC_MAXLEN;
+	if (w.m_len == 0 || w.m_len > WC_MAXLEN)
+		w.m_len = WC_MAXLEN;
+
+	if (w.m_mode != AXIMON::DMA) {
+		w.m_src = BUSALIGN(w.m_src);
+		w.m_dst = BUSALIGN(w.m_dst);
+		w.m_len = BUSALIGN(w.m_len);
+		if (w.m_len == 0)
+			w.m_len = BUSBYTES;
+	}
+}
+// }}}
+
+// wcprint()
+// {{{
+void	wcprint(const char *prefix, const WCASE &w) {
+	printf("%s %-4s load=%-4s src=0x%08x dst=0x%08x len=0x%05x"
+		" %6.3f beats/clk, %5.2fx slower than aligned\n",
+		prefix, wcname[w.m_mode], wcname[w.m_load],
+		w.m_src, w.m_dst, w.m_len,
+		w.m_rate / BUSBYTES, w.m_score);
+}
+// }}}
+
+// wcshrink()
+// {{{
+// Reduces a slow case to a simpler reproducer: no load if the load doesn't
+// matter, the shortest length that's still slow, and then as few address
+// bits set as possible.  Each step is kept only if the result still scores
+// at least WC_SHRINK of the original.
+void	wcshrink(AXI_TB<MAINTB> *tb, WCASE &w) {
+	const	double	target = w.m_score * WC_SHRINK;
+	const	unsigned	align = (w.m_mode == AXIMON::DMA) ? 1 : BUSBYTES;
+	WCASE	t;
+
+	if (w.m_load != WC_NONE) {
+		t = w;
+		t.m_load = WC_NONE;
+		if (wcscore(tb, t) && t.m_score >= target)
+			w = t;
+	}
+
+	for(unsigned ln = w.m_len / 2; ln >= align; ln /= 2) {
+		t = w;
+		t.m_len = ln & -align;
+		if (!wcscore(tb, t) || t.m_score < target)
+			break;
+		w = t;
+	}
+
+	for(int k=0; k<2; k++) {
+		// The MM2S has no destination, nor the S2MM a source
+		if ((k == 0 && w.m_mode == AXIMON::S2MM)
+				|| (k == 1 && w.m_mode == AXIMON::MM2S))
+			continue;
+
+		for(int b=18; b>=0; b--) {
+			unsigned	*a, bit = 1u << b;
+
+			t = w;
+			a = (k == 0) ? &t.m_src : &t.m_dst;
+			if (bit < align || 0 == (*a & bit))
+				continue;
+			*a &= ~bit;
+			if (wcscore(tb, t) && t.m_score >= target)
+				w = t;
+		}
+	}
+}
+// }}}
+
+bool	worstcase(AXI_TB<MAINTB> *tb, unsigned ncases, unsigned seed) {
+	// {{{
+	WCASE	worst[WC_KEEP];
+	int	nworst = 0;
+	bool	fail = false;
+
+	wcseed = (seed) ? seed : 1;
+	tb->CLEARRAM(-1);
+	checkstream(tb, CHK_NONE);
+	mark("worst-case");
+
+	printf("Worst case search: %u cases, seed %u\n", ncases, seed);
+	for(unsigned n=0; n<ncases; n++) {
+		WCASE	w;
+		int	k;
+
+		wcrandom(w);
+		if (!wcscore(tb, w)) {
+			fail = true;
+			if (wcstuck)
+				break;
+			continue;
+		}
+
+		// Keep the list sorted, slowest first
+		for(k=nworst; k>0 && worst[k-1].m_score < w.m_score; k--)
+			if (k < WC_KEEP)
+				worst[k] = worst[k-1];
+		if (k < WC_KEEP) {
+			worst[k] = w;
+			if (nworst < WC_KEEP)
+				nworst++;
+		}
+	}
+
+	if (wcstuck) {
+		printf("ERR: A mover would not abort, ending the search\n");
+		return false;
+	}
+
+	for(int k=0; k<nworst; k++) {
+		wcprint("WORST:", worst[k]);
+		wcshrink(tb, worst[k]);
+		wcprint("REPRO:", worst[k]);
+	}
+
+	return !fail;
+}
+// }}}
+// }}}
+
+// Abort latency sweep
+// {{{
+// Aborts each mover once it has moved a given number of beats, for several
+// such numbers, and measures how long the mover took to go idle, how many
+// bursts it still had outstanding, and how much data still moved on the bus
+// and on the stream after the abort.
+#define	ABORT_LENGTH		32768
+#define	ABORT_SETTLE		64	// Clocks to watch after BUSY clears
+#define	ABORT_TIMEOUT		200000
+
+bool	abortsweep(AXI_TB<MAINTB> *tb) {
+	// {{{
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL },
+			abortcmd[AXIMON::NMASTERS]
+				= { MM2S_ABORT_CMD, S2MM_ABORT_CMD, DMA_ABORT_CMD },
+			busy[AXIMON::NMASTERS]
+				= { MM2S_BUSY, S2MM_BUSY, DMA_BUSY_BIT };
+	const	char	*name[AXIMON::NMASTERS] = { "MM2S", "S2MM", "DMA" };
+	// Abort points, in AXI beats since the start
+	const	unsigned	points[] = { 0, 1, 2, 15, 16, 17, 64, 255, 256,
+						1024, 4096 };
+	const	int	NPOINTS = sizeof(points)/sizeof(points[0]);
+	bool		fail = false;
+
+	tb->CLEARRAM(-1);
+	checkstream(tb, CHK_NONE);
+	mark("abort-sweep");
+	printf("Abort latency sweep:\n");
+	printf("\t%-5s %6s %8s %8s %8s %8s %8s\n", "", "BEAT",
+		"LATENCY", "DRAIN", "BURSTS", "AXI-B", "STRM-B");
+	for(int m=0; m<AXIMON::NMASTERS; m++) {
+		unsigned long	worst = 0;
+		unsigned	worst_point = 0;
+
+		for(int p=0; p<NPOINTS; p++) {
+			ABORTMON	mon(tb->m_tb->m_core, m);
+			unsigned long	start, latency;
+			bool		timeout = false;
+
+			// The DMA moves each beat twice, once each way
+			if (points[p] * ((m == AXIMON::DMA) ? 2:1) * BUSBYTES
+							>= ABORT_LENGTH)
+				continue;
+
+			tb->addmon(&mon);
+			mover(tb, m, CONTEND_DMA_SRC, CONTEND_DMA_DST,
+				ABORT_LENGTH);
+			start = tb->tickcount();
+			while(mon.m_beats < points[p] && !timeout) {
+				tb->idle();
+				timeout = (tb->tickcount()-start > ABORT_TIMEOUT);
+			}
+
+			mon.arm();
+			tb->writeio(ctrl[m], abortcmd[m]);
+			while((tb->readio(ctrl[m]) & busy[m]) && !timeout)
+				timeout = (tb->tickcount()-start > ABORT_TIMEOUT);
+			latency = tb->tickcount() - mon.m_abort;
+			tb->idle(ABORT_SETTLE);
+			tb->delmon(&mon);
+
+			if (timeout) {
+				printf("\tERR: %s abort at beat %u never "
+					"completed\n", name[m], points[p]);
+				fail = true;
+				continue;
+			}
+
+			printf("\t%-5s %6u %8lu %8lu %8lu %8lu %8lu\n",
+				name[m], points[p], latency, mon.drain(),
+				mon.m_at_bursts,
+				mon.beats_after() * BUSBYTES,
+				mon.stream_after() * BUSBYTES);
+			if (mon.outstanding() != 0) {
+				printf("\tERR: %s went idle with %lu bursts "
+					"still outstanding\n", name[m],
+					mon.outstanding());
+				fail = true;
+			}
+
+			if (latency > worst) {
+				worst = latency;
+				worst_point = points[p];
+			}
+		}
+
+		printf("\t%-5s worst abort latency: %lu clocks, at beat %u\n",
+			name[m], worst, worst_point);
+	}
+
+	return !fail;
+}
+// }}}
+// }}}
+
+// Continuous mode hand-off
+// {{{
+// Hands the MM2S, and then the S2MM, HANDOFF_NCMDS back to back continuous
+// mode commands, each of the same length, with the host waiting a given
+// number of clocks after each command completes before issuing the next.
+// Measures the idle clocks on the stream and on the AXI bus at each hand-off,
+// and finds the smallest command that still keeps the stream running at
+// (nearly) full rate.
+#define	HANDOFF_NCMDS		4
+#define	HANDOFF_FULL		0.99	// Stream efficiency counted as full rate
+#define	HANDOFF_SETTLE		256	// Clocks for the stream to drain
+#define	HANDOFF_TIMEOUT		200000
+
+bool	handoff(AXI_TB<MAINTB> *tb) {
+	// {{{
+	const	unsigned	lengths[] = { 64, 256, 1024, 4096, 16384 },
+				delays[]  = { 0, 16, 128, 425 };
+	const	int	NLENGTHS = sizeof(lengths)/sizeof(lengths[0]),
+			NDELAYS  = sizeof(delays)/sizeof(delays[0]);
+	bool	fail = false;
+
+	tb->CLEARRAM(-1);
+	checkstream(tb, CHK_NONE);
+	mark("handoff");
+	printf("Continuous hand-off:\n");
+	printf("\t%-5s %5s %6s %14s %14s %6s\n", "", "DELAY", "LEN",
+		"STREAM AVG/MAX", "AXI AVG/MAX", "EFF");
+	for(int m=AXIMON::MM2S; m<=AXIMON::S2MM; m++) {
+		const	bool	mm2s = (m == AXIMON::MM2S);
+		const	char	*name = (mm2s) ? "MM2S" : "S2MM";
+		const	unsigned	ctrl = (mm2s) ? R_MM2SCTRL : R_S2MMCTRL,
+				busy = (mm2s) ? MM2S_BUSY : S2MM_BUSY,
+				err  = (mm2s) ? MM2S_ERR : S2MM_ERR,
+				cmd  = (mm2s) ? (MM2S_START_CMD|MM2S_CONTINUOUS)
+					: (S2MM_START_CMD|S2MM_CONTINUOUS);
+
+		for(int d=0; d<NDELAYS; d++) {
+			unsigned	sustain = 0;
+
+			for(int l=0; l<NLENGTHS; l++) {
+				unsigned	ln = BUSALIGN(lengths[l]);
+				unsigned long	start;
+				bool		timeout = false;
+
+				if (ln < BUSBYTES)
+					ln = BUSBYTES;
+
+				GAPMON	mon(tb->m_tb->m_core, m, ln / BUSBYTES);
+
+				// Only the first command sets the address.
+				// The rest pick up where the last left off.
+				if (mm2s)
+					tb->write64(R_MM2SADDRLO,
+						(uint64_t)CONTEND_MM2S_ADDR + R_AXIRAM);
+				else
+					tb->write64(R_S2MMADDRLO,
+						(uint64_t)CONTEND_S2MM_ADDR + R_AXIRAM);
+
+				tb->addmon(&mon);
+				start = tb->tickcount();
+				for(int c=0; c<HANDOFF_NCMDS && !timeout; c++) {
+					unsigned	status;
+
+					tb->write64((mm2s) ? R_MM2SLENLO
+						: R_S2MMLENLO, (uint64_t)ln);
+					tb->writeio(ctrl, cmd);
+					while(((status = tb->readio(ctrl)) & busy)
+								&& !timeout)
+						timeout = (tb->tickcount() - start
+							> HANDOFF_TIMEOUT);
+					if (status & err) {
+						printf("\tERR: %s, ERR flag set\n",
+							name);
+						fail = true;
+					}
+					if (delays[d] > 0)
+						tb->idle(delays[d]);
+				}
+				tb->idle(HANDOFF_SETTLE);
+				tb->delmon(&mon);
+
+				if (timeout) {
+					printf("\tERR: %s, %u byte commands "
+						"never completed\n", name, ln);
+					fail = true;
+					break;
+				}
+
+				printf("\t%-5s %5u %6u %7.1f/%-6lu %7.1f/%-6lu %6.3f\n",
+					name, delays[d], ln,
+					mon.average(mon.m_stream),
+					mon.m_stream.m_worst,
+					mon.average(mon.m_axi),
+					mon.m_axi.m_worst,
+					mon.efficiency(mon.m_stream));
+				if (sustain == 0 && mon.efficiency(mon.m_stream)
+							>= HANDOFF_FULL)
+					sustain = ln;
+			}
+
+			if (sustain)
+				printf("\t%-5s %5u clocks between commands: full "
+					"rate from %u bytes per command\n",
+					name, delays[d], sustain);
+			else
+				printf("\t%-5s %5u clocks between commands: never"
+					" full rate, up to %u bytes\n",
+					name, delays[d],
+					BUSALIGN(lengths[NLENGTHS-1]));
+		}
+	}
+
+	return !fail;
+}
+// }}}
+// }}}
+
+// Command latency
+// {{{
+// Programs each mover to move a single bus word, and counts the clocks from
+// the write of its start command until it's idle again.  Prints one machine
+// readable line per mover, as in "LATENCY: <mover> <width> <clocks>", for
+// sim/configs.sh.  A mover that never goes idle gets an ERR line instead.
+#define	LATENCY_TIMEOUT		20000
+
+bool	cmdlatency(AXI_TB<MAINTB> *tb) {
+	// {{{
+	const	char	*name[AXIMON::NMASTERS] = { "MM2S", "S2MM", "DMA" };
+	bool	fail = false;
+
+	checkstream(tb, CHK_NONE);
+	mark("latency");
+	for(int m=0; m<AXIMON::NMASTERS; m++) {
+		unsigned long	start;
+		bool		timeout = false;
+
+		moverset(tb, m, (uint64_t)CONTEND_DMA_SRC + R_AXIRAM,
+			(uint64_t)CONTEND_DMA_DST + R_AXIRAM, BUSBYTES);
+		start = tb->tickcount();
+		moverstart(tb, m);
+		while(moverbusy(tb, m) && !timeout)
+			timeout = (tb->tickcount()-start >= LATENCY_TIMEOUT);
+
+		if (timeout) {
+			printf("ERR: %s, a single word took more than %d "
+				"clocks\n", name[m], LATENCY_TIMEOUT);
+			moverabort(tb, m, LATENCY_TIMEOUT);
+			fail = true;
+		} else
+			printf("LATENCY: %-20s %3d %10lu\n", name[m],
+				AXIBUS_WIDTH, tb->tickcount() - start);
+	}
+
+	return !fail;
+}
+// }}}
+// }}}
+
+// Bus error recovery
+// {{{
+// Fails one burst of a transfer, with SLVERR and then DECERR, for each mover
+// and direction (the DMA both reads and writes).  Measures the clocks from
+// the error response reaching the mover until its BUSY bit drops with the
+// error flagged.  A clean transfer then follows--its start command also
+// clears the error--and the clocks it takes (RECOVER) are compared to the
+// same transfer from a mover that never saw an error (BASE).  Both count from
+// the start command.  Any -e rules are set aside while this runs.
+#define	ERR_LENGTH		32768
+#define	ERR_RECOVER_LEN		4096
+#define	ERR_TIMEOUT		200000
+
+// errclean()
+// {{{
+// Runs a clean ERR_RECOVER_LEN transfer through master m, and returns the
+// clocks from its start command until it's idle.  Zero means it never
+// finished, or finished with its error flag set.
+unsigned long	errclean(AXI_TB<MAINTB> *tb, int m, unsigned errbit) {
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL };
+	unsigned long	start, clocks;
+	bool		timeout = false;
+
+	moverset(tb, m, (uint64_t)CONTEND_DMA_SRC + R_AXIRAM,
+		(uint64_t)CONTEND_DMA_DST + R_AXIRAM, ERR_RECOVER_LEN);
+	start = tb->tickcount();
+	moverstart(tb, m);
+	while(moverbusy(tb, m) && !timeout)
+		timeout = (tb->tickcount()-start > ERR_TIMEOUT);
+	clocks = tb->tickcount() - start;
+
+	if (timeout) {
+		moverabort(tb, m, ERR_TIMEOUT);
+		return 0;
+	} else if (tb->readio(ctrl[m]) & errbit)
+		return 0;
+	return clocks;
+}
+// }}}
+
+bool	errrecover(AXI_TB<MAINTB> *tb) {
+	// {{{
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL },
+			abortcmd[AXIMON::NMASTERS]
+				= { MM2S_ABORT_CMD, S2MM_ABORT_CMD, DMA_ABORT_CMD },
+			busy[AXIMON::NMASTERS]
+				= { MM2S_BUSY, S2MM_BUSY, DMA_BUSY_BIT },
+			errbit[AXIMON::NMASTERS]
+				= { MM2S_ERR, S2MM_ERR, DMA_ERR_BIT };
+	const	char	*name[AXIMON::NMASTERS] = { "MM2S", "S2MM", "DMA" };
+	const	struct { int m; bool wr; } cases[] = {
+			{ AXIMON::MM2S, false }, { AXIMON::S2MM, true },
+			{ AXIMON::DMA,  false }, { AXIMON::DMA,  true } };
+	const	unsigned	resps[] = { ERRSIM::SLVERR, ERRSIM::DECERR };
+	// Which burst to fail.  ERR_LENGTH spans 4kB boundaries, so every
+	// transfer has at least this many bursts
+	const	unsigned long	bursts[] = { 1, 4 };
+	ERRSIM		model, *saved = errsim;
+	unsigned long	baseline[AXIMON::NMASTERS];
+	bool		fail = false;
+
+	tb->CLEARRAM(-1);
+	checkstream(tb, CHK_NONE);
+	mark("error-recovery");
+	errsim = &model;
+
+	// The same clean transfer, for each mover, without any error first
+	for(int m=0; m<AXIMON::NMASTERS; m++) {
+		baseline[m] = errclean(tb, m, errbit[m]);
+		if (baseline[m] == 0) {
+			printf("\tERR: %s, the error free baseline transfer "
+				"failed\n", name[m]);
+			fail = true;
+		}
+	}
+
+	printf("Bus error recovery:\n");
+	printf("\t%-5s %-5s %-6s %5s %8s %4s %8s %8s %8s\n", "", "", "RESP",
+		"BURST", "LATENCY", "CODE", "DRAIN", "RECOVER", "BASE");
+	for(auto &c : cases)
+	for(unsigned resp : resps)
+	for(unsigned long nth : bursts) {
+		const	int	m = c.m;
+		const	unsigned	base = (c.wr) ? CONTEND_DMA_DST
+							: CONTEND_DMA_SRC;
+		ABORTMON	mon(tb->m_tb->m_core, m);
+		unsigned long	start, flagged, latency, recover;
+		unsigned	status;
+		bool		timeout = false;
+		char		code[8];
+
+		model.clear();
+		model.add(ERRSIM::rule(c.wr, base, base + ERR_LENGTH, nth,
+								resp));
+		tb->addmon(&mon);
+		mover(tb, m, CONTEND_DMA_SRC, CONTEND_DMA_DST, ERR_LENGTH);
+		start = tb->tickcount();
+		while((tb->readio(ctrl[m]) & busy[m]) && !timeout)
+			timeout = (tb->tickcount()-start > ERR_TIMEOUT);
+		flagged = tb->tickcount();
+		status  = tb->readio(ctrl[m]);
+		tb->idle(ABORT_SETTLE);
+		tb->delmon(&mon);
+
+		if (timeout) {
+			printf("\tERR: %s never stopped after a %s error\n",
+				name[m], (c.wr) ? "write" : "read");
+			tb->writeio(ctrl[m], abortcmd[m]);
+			while(tb->readio(ctrl[m]) & busy[m])
+				;
+			fail = true;
+			continue;
+		} if (mon.m_error == 0 || 0 == (status & errbit[m])) {
+			printf("\tERR: %s, %s error on burst %lu %s\n",
+				name[m], (c.wr) ? "write" : "read", nth,
+				(mon.m_error == 0) ? "never arrived"
+						: "wasn't flagged");
+			fail = true;
+			continue;
+		} if (mon.outstanding() != 0) {
+			printf("\tERR: %s stopped with %lu bursts still "
+				"outstanding\n", name[m], mon.outstanding());
+			fail = true;
+		}
+		latency = flagged - mon.m_error;
+
+		if (m == AXIMON::DMA)
+			strcpy(code, "-");
+		else
+			sprintf(code, "%d", (status >> 23) & 0x07);
+
+		// Now clean: how soon is the mover usable again?
+		model.clear();
+		recover = errclean(tb, m, errbit[m]);
+
+		printf("\t%-5s %-5s %-6s %5lu %8lu %4s %8lu %8lu %8lu\n",
+			name[m], (c.wr) ? "write" : "read",
+			(resp == ERRSIM::DECERR) ? "DECERR" : "SLVERR", nth,
+			latency, code, mon.drain(), recover, baseline[m]);
+		if (recover == 0) {
+			printf("\tERR: %s didn't recover from the error\n",
+				name[m]);
+			fail = true;
+		}
+	}
+
+	errsim = saved;
+	return !fail;
+}
+// }}}
+// }}}
+
+// Parallel slaves
+// {{{
+// Runs each pair of transfers twice: first with everything in the AXI RAM
+// (shared), and then with one side moved to the second AXI RAM (split).  If
+// the crossbar really serves separate slaves at once, the split run should
+// move the same bytes in fewer clocks.  The DMA alone, copying from one RAM
+// to the other, measures the same thing for a single master.
+#define	XS_LENGTH		32768
+#define	XS_TIMEOUT		400000
+// Offsets, within either RAM, of each mover's source or destination
+#define	XS_MM2S_SRC		0x00000000
+#define	XS_S2MM_DST		0x00100000
+#define	XS_DMA_SRC		0x00200000
+#define	XS_DMA_DST		0x00300000
+// Which addresses are moved to the second RAM for the split run
+#define	XS_ASRC			1
+#define	XS_ADST			2
+#define	XS_BSRC			4
+#define	XS_BDST			8
+
+typedef	struct	{
+	const char	*m_name;
+	int		m_a, m_b;	// m_b is AXIMON::NMASTERS if unused
+	unsigned	m_split;
+} XSCASE;
+
+// xsaddr()
+// {{{
+// The bus address of mover m's source (or destination) when in the second RAM
+// or not
+uint64_t	xsaddr(int m, bool dst, bool ram2) {
+	unsigned	offset;
+
+	if (m == AXIMON::DMA)
+		offset = (dst) ? XS_DMA_DST : XS_DMA_SRC;
+	else
+		offset = (m == AXIMON::MM2S) ? XS_MM2S_SRC : XS_S2MM_DST;
+	return (uint64_t)offset + ((ram2) ? R_AXIRAM2 : R_AXIRAM);
+}
+// }}}
+
+bool	xslave(AXI_TB<MAINTB> *tb) {
+	// {{{
+	const	XSCASE	cases[] = {
+			{ "dma",       AXIMON::DMA,  AXIMON::NMASTERS, XS_ADST },
+			{ "mm2s+s2mm", AXIMON::MM2S, AXIMON::S2MM,     XS_BDST },
+			{ "mm2s+dma",  AXIMON::MM2S, AXIMON::DMA,
+							XS_BSRC | XS_BDST },
+			{ "s2mm+dma",  AXIMON::S2MM, AXIMON::DMA,
+							XS_BSRC | XS_BDST } };
+	uint32_t	*ram[2] = { tb->TBRAM, tb->m_tb->axiram2_words() };
+	bool		fail = false;
+	char		name[48];
+
+	checkstream(tb, CHK_NONE);
+	mark("parallel-slaves");
+
+	printf("Parallel slaves:\n");
+	printf("\t%-10s %-6s %10s %10s %8s %10s %8s\n", "CASE", "RAMS",
+		"A BYTES/CK", "B BYTES/CK", "CLOCKS", "TOTAL B/CK", "SPEEDUP");
+	for(const XSCASE &c : cases) {
+		double	shared = 0.0;
+
+		for(int split=0; split<2; split++) {
+			const	unsigned sp = (split) ? c.m_split : 0;
+			const	bool	two = (c.m_b != AXIMON::NMASTERS);
+			AXIMON		mon(tb->m_tb->m_core);
+			unsigned long	start, clocks, bytes;
+			bool		timeout = false;
+			double		total;
+
+			// Set up both RAMs
+			// {{{
+			tb->CLEARRAM(-1);
+			tb->m_tb->axiram2_clear(-1);
+			for(int r=0; r<2; r++)
+			for(unsigned k=0; k<XS_LENGTH/4; k++) {
+				ram[r][XS_MM2S_SRC/4 + k] = k;
+				ram[r][XS_DMA_SRC/4 + k]  = k ^ 0x5a5a0000;
+			}
+			// }}}
+
+			mon.clear();
+			tb->addmon(&mon);
+			start = tb->tickcount();
+			moverat(tb, c.m_a, xsaddr(c.m_a, false, sp & XS_ASRC),
+				xsaddr(c.m_a, true, sp & XS_ADST), XS_LENGTH);
+			if (two)
+				moverat(tb, c.m_b,
+					xsaddr(c.m_b, false, sp & XS_BSRC),
+					xsaddr(c.m_b, true,  sp & XS_BDST),
+					XS_LENGTH);
+			while(moverbusy(tb, c.m_a) && !timeout)
+				timeout = (tb->tickcount()-start > XS_TIMEOUT);
+			while(two && moverbusy(tb, c.m_b) && !timeout)
+				timeout = (tb->tickcount()-start > XS_TIMEOUT);
+			clocks = tb->tickcount() - start;
+			tb->delmon(&mon);
+
+			if (timeout) {
+				printf("\tERR: %s (%s) never completed\n",
+					c.m_name, (split) ? "split" : "shared");
+				fail = true;
+				continue;
+			}
+
+			bytes = mon.bytes(c.m_a, BUSBYTES);
+			if (two)
+				bytes += mon.bytes(c.m_b, BUSBYTES);
+			total = bytes / (double)clocks;
+			if (!split)
+				shared = total;
+
+			printf("\t%-10s %-6s %10.3f ", c.m_name,
+				(split) ? "split" : "shared",
+				mon.bandwidth(c.m_a, BUSBYTES));
+			if (two)
+				printf("%10.3f", mon.bandwidth(c.m_b, BUSBYTES));
+			else
+				printf("%10s", "-");
+			printf(" %8lu %10.3f", clocks, total);
+			if (split && shared > 0.0)
+				printf(" %7.2fx", total / shared);
+			printf("\n");
+
+			snprintf(name, sizeof(name), "XS-%s-%s", c.m_name,
+				(split) ? "split" : "shared");
+			perfline(name, bytes, clocks);
+
+			// Check any DMA copy, wherever it went
+			for(int m : { c.m_a, c.m_b }) {
+				const	bool	b = (m == c.m_b);
+
+				if (m != AXIMON::DMA)
+					continue;
+				snprintf(name, sizeof(name), "Parallel %s (%s)",
+					c.m_name, (split) ? "split" : "shared");
+				verifier->match(name,
+					ram[(sp & ((b) ? XS_BDST : XS_ADST)) ? 1:0],
+					XS_DMA_DST/4, XS_DMA_SRC/4, XS_LENGTH/4,
+					ram[(sp & ((b) ? XS_BSRC : XS_ASRC)) ? 1:0]);
+			}
+		}
+	}
+
+	return !fail;
+}
+// }}}
+// }}}
+
+// QoS arbitration
+// {{{
+// Streams QOS_LENGTH bytes through the MM2S, first alone and then while the
+// DMA copies a larger block across the same AXI RAM, with each of the two
+// given the greater QoS in turn.  Reports how the RAM's bandwidth was divided,
+// along with the stream's first beat latency and longest gap, to show what
+// the QoS gates (built with make QOS=1 in rtl/) buy the favored master.
+// Without them, the QoS values are ignored and the three loaded cases should
+// match.
+#define	QOS_LENGTH		32768
+#define	QOS_LOAD		(4*QOS_LENGTH)
+#define	QOS_LEAD		64	// Clocks the DMA runs before the MM2S
+#define	QOS_TIMEOUT		400000
+
+typedef	struct	{
+	const char	*m_name;
+	bool		m_load;
+	unsigned	m_mm2s, m_dma;	// QoS values
+} QOSCASE;
+
+bool	qosbench(AXI_TB<MAINTB> *tb) {
+	// {{{
+	const	QOSCASE	cases[] = {
+			{ "alone",     false, 0, 0 },
+			{ "equal",     true,  0, 0 },
+			{ "mm2s-high", true,  8, 0 },
+			{ "dma-high",  true,  0, 8 } };
+	bool		fail = false;
+	char		name[32];
+
+	// Set up the memory
+	// {{{
+	tb->CLEARRAM(-1);
+	for(unsigned k=0; k<QOS_LENGTH/4; k++)
+		tb->TBRAM[CONTEND_MM2S_ADDR/4 + k] = k;
+	for(unsigned k=0; k<QOS_LOAD/4; k++)
+		tb->TBRAM[CONTEND_DMA_SRC/4 + k] = k ^ 0x5a5a0000;
+	// }}}
+
+	checkstream(tb, CHK_NONE);
+	mark("qos");
+
+	printf("QoS arbitration:\n");
+	printf("\t%-10s %4s %4s %10s %10s %8s %8s %8s\n", "CASE", "MM2S",
+		"DMA", "MM2S B/CK", "DMA B/CK", "CLOCKS", "LATENCY", "MAXGAP");
+	for(const QOSCASE &c : cases) {
+		AXIMON		mon(tb->m_tb->m_core);
+		unsigned long	start, clocks;
+		unsigned	latency, maxgap;
+		bool		timeout = false;
+
+		tb->m_tb->qos_set(c.m_mm2s, 0, c.m_dma);
+
+		mon.clear();
+		tb->addmon(&mon);
+		if (c.m_load) {
+			mover(tb, AXIMON::DMA, CONTEND_DMA_SRC, CONTEND_DMA_DST,
+				QOS_LOAD);
+			tb->idle(QOS_LEAD);
+		}
+
+		// Writing to the beat counter clears the sink's statistics
+		tb->writeio(R_STREAMSINK_BEATS, 0);
+		start = tb->tickcount();
+		mover(tb, AXIMON::MM2S, CONTEND_MM2S_ADDR, 0, QOS_LENGTH);
+		while(moverbusy(tb, AXIMON::MM2S) && !timeout)
+			timeout = (tb->tickcount()-start > QOS_TIMEOUT);
+		clocks = tb->tickcount() - start;
+
+		// The load has done its job once the MM2S is through
+		if (c.m_load && moverbusy(tb, AXIMON::DMA)) {
+			tb->writeio(R_AXIDMACTRL, DMA_ABORT_CMD);
+			while(moverbusy(tb, AXIMON::DMA) && !timeout)
+				timeout = (tb->tickcount()-start > QOS_TIMEOUT);
+		}
+		tb->delmon(&mon);
+
+		if (timeout) {
+			printf("\tERR: QoS case %s never completed\n",
+				c.m_name);
+			fail = true;
+			continue;
+		}
+
+		latency = tb->readio(R_STREAMSINK_LATENCY);
+		maxgap  = tb->readio(R_STREAMSINK_MAXGAP);
+		printf("\t%-10s %4u %4u %10.3f ", c.m_name, c.m_mm2s,
+			c.m_dma, mon.bandwidth(AXIMON::MM2S, BUSBYTES));
+		if (c.m_load)
+			printf("%10.3f", mon.bandwidth(AXIMON::DMA, BUSBYTES));
+		else
+			printf("%10s", "-");
+		printf(" %8lu %8u %8u\n", clocks, latency, maxgap);
+
+		snprintf(name, sizeof(name), "QOS-%s", c.m_name);
+		perfline(name, mon.bytes(AXIMON::MM2S, BUSBYTES), clocks);
+		// QOS: <case> <latency> <maxgap>
+		printf("QOS: %s %u %u\n", c.m_name, latency, maxgap);
+	}
+
+	tb->m_tb->qos_set(0, 0, 0);
+	return !fail;
+}
+// }}}
+// }}}
+
+// 4GB crossing
+// {{{
+// Runs each mover across the 4GB boundary within the AXI RAM, so that the
+// upper half of every address register, and the carry into it, gets used.
+// The host writes the source and reads back the results.  A dense RAM repeats
+// every RAMSIZE bytes across its span, so the movers are still checked there,
+// but only a sparse RAM (make SPARSE=1) keeps each of these addresses apart.
+#define	HI_LENGTH		32768
+#define	HI_SRC			0x0ffffc000ul	// Crosses 4GB halfway through
+#define	HI_DST			0x123456000ul
+#define	HI_TIMEOUT		400000
+
+// hiaddrok()
+// {{{
+// Checks an idle mover's 64-bit address register.  It should read back either
+// the address it was given, or the one just past the last byte it moved.
+bool	hiaddrok(AXI_TB<MAINTB> *tb, int m, const char *which, unsigned reg,
+		uint64_t addr) {
+	uint64_t	v = tb->read64(reg);
+
+	if (v == addr || v == addr + HI_LENGTH)
+		return true;
+	printf("\tERR: The %s %s address reads back as 0x%09lx, "
+		"not 0x%09lx\n", wcname[m], which, (unsigned long)v,
+		(unsigned long)addr);
+	return false;
+}
+// }}}
+
+// hirun()
+// {{{
+// Runs master m from src to dst, as in moverat(), and waits for it to finish.
+// Returns false if it timed out, ended in an error, or lost the upper half of
+// any address it was given.
+bool	hirun(AXI_TB<MAINTB> *tb, int m, uint64_t src, uint64_t dst) {
+	const	unsigned	ctrl[AXIMON::NMASTERS]
+				= { R_MM2SCTRL, R_S2MMCTRL, R_AXIDMACTRL },
+			err[AXIMON::NMASTERS]
+				= { MM2S_ERR, S2MM_ERR, DMA_ERR_BIT };
+	unsigned long	start, clocks;
+	bool		timeout = false;
+	char		name[32];
+
+	moverat(tb, m, src, dst, HI_LENGTH);
+	start = tb->tickcount();
+	while(moverbusy(tb, m) && !timeout)
+		timeout = (tb->tickcount() - start > HI_TIMEOUT);
+	clocks = tb->tickcount() - start;
+
+	if (timeout) {
+		printf("\tERR: The %s never finished\n", wcname[m]);
+		moverabort(tb, m, HI_TIMEOUT);
+		return false;
+	} if (tb->readio(ctrl[m]) & err[m]) {
+		printf("\tERR: The %s ended in an error\n", wcname[m]);
+		return false;
+	}
+
+	printf("\t%-5s COUNTS: 0x%08lx\n", wcname[m], clocks);
+	switch(m) {
+	case AXIMON::MM2S:
+		if (!hiaddrok(tb, m, "source", R_MM2SADDRLO, src))
+			return false;
+		break;
+	case AXIMON::S2MM:
+		if (!hiaddrok(tb, m, "destination", R_S2MMADDRLO, dst))
+			return false;
+		break;
+	case AXIMON::DMA:
+		if (!hiaddrok(tb, m, "source", R_AXIDMASRCLO, src)
+			|| !hiaddrok(tb, m, "destination", R_AXIDMADSTLO, dst))
+			return false;
+		break;
+	default: break;
+	}
+
+	snprintf(name, sizeof(name), "4GB-%s", wcname[m]);
+	perfline(name, HI_LENGTH, clocks);
+	return true;
+}
+// }}}
+
+bool	hiaddr(AXI_TB<MAINTB> *tb) {
+	// {{{
+	const	unsigned	NW = HI_LENGTH / 4;
+	uint32_t	*src = new uint32_t[NW], *dst = new uint32_t[NW];
+	bool		fail = false;
+
+	mark("4GB");
+	printf("4GB crossing check:\n");
+	for(unsigned k=0; k<NW; k++)
+		src[k] = k;
+	tb->writei(R_AXIRAM + HI_SRC, NW, src);
+
+	// The MM2S, reading across 4GB into the stream checker
+	tb->writeio(R_STREAMSINK_BEATS, 0);
+	checkstream(tb, CHK_COUNTER);
+	if (!hirun(tb, AXIMON::MM2S, R_AXIRAM + HI_SRC, 0)
+			|| !verifystream(tb, NW, crc32(src, HI_LENGTH)))
+		fail = true;
+	checkstream(tb, CHK_NONE);
+
+	// The DMA, copying from across 4GB to somewhere above it
+	if (!hirun(tb, AXIMON::DMA, R_AXIRAM + HI_SRC, R_AXIRAM + HI_DST))
+		fail = true;
+	tb->readi(R_AXIRAM + HI_DST, NW, dst);
+	verifier->match("4GB DMA", dst, 0, 0, NW, src);
+
+	// The S2MM, writing a counter back across 4GB
+	streamsrc(tb, 0, 0, 0);
+	if (!hirun(tb, AXIMON::S2MM, 0, R_AXIRAM + HI_SRC))
+		fail = true;
+	tb->readi(R_AXIRAM + HI_SRC, NW, dst);
+	verifier->increment("4GB S2MM", dst, 0, NW);
+
+	delete[] src;
+	delete[] dst;
+	return !fail;
+}
+// }}}
+// }}}
+
 void	usage(void) {
 	// {{{
 	fprintf(stderr, "USAGE: main_tb <options>\n");
 	fprintf(stderr,
+"\t-a\tCounts bit toggles on every AXI port's address and data buses,\n"
+"\t\tand the clocks each port is quiet, reported at exit\n"
+"\t-b <filename>\n"
+"\t\tAdds a stream sink backpressure test, replaying the TREADY\n"
+"\t\ttrace (a string of 0s and 1s, one per clock) in <filename>\n"
+"\t-c <spec>\n"
+"\t\tSets the lengths and start offsets for the concurrent test, as\n"
+"\t\tin mm2s=65536@0,s2mm=32768@100,dma=0.  Zero skips a master.\n"
 "\t-d\tSets the debugging flag\n"
+"\t-e <rule>\n"
+"\t\tFails the AXI RAM bursts matching <rule> with a bus error, as\n"
+"\t\tin w,addr=0x200000-0x210000,rate=0.01,resp=decerr.  May be\n"
+"\t\trepeated.  See sim/errsim.h.\n"
+"\t-f\tFails one burst of each mover with a bus error, and measures\n"
+"\t\thow long the mover takes to stop, and to recover\n"
+"\t-g\tMeasures the gaps between back to back continuous mode\n"
+"\t\tcommands, for several command lengths and host delays\n"
+"\t-i <clocks>\n"
+"\t\tSets the sample period for -s.  The default is 256 clocks.\n"
+"\t-j <filename>\n"
+"\t\tWrites every AXI burst, on every crossbar port, to <filename>\n"
+"\t\tas a Chrome trace (JSON), for chrome://tracing or Perfetto\n"
+"\t-k\tAborts each mover at several points within a transfer, and\n"
+"\t\tmeasures how long it takes to stop\n"
+"\t-l\tMeasures the clocks each mover takes to move a single word,\n"
+"\t\tas LATENCY: lines for sim/configs.sh\n"
+"\t-m <model>\n"
+"\t\tPlaces a DRAM timing model, such as ddr3, in front of the AXI\n"
+"\t\tRAM.  Without this, the RAM responds as fast as it can.\n"
+"\t-o <model>\n"
+"\t\tHolds reads and write responses at the AXI RAM for a random\n"
+"\t\ttime by ID, so they return out of order across IDs, as in\n"
+"\t\tr2=0-400,*=0-32.  See sim/reordersim.h.\n"
+"\t-p\tProfiles the host: CPU cycles, instructions, and cache and branch\n"
+"\t\tmisses, by clock tick sub-step and by test, reported at exit\n"
+"\t-q\tRuns the MM2S against a DMA load at several QoS settings.  Build\n"
+"\t\tthe design with make QOS=1 for the QoS values to matter.\n"
+"\t-r <count>[:<seed>]\n"
+"\t\tRuns <count> random cases through the movers, keeps the slowest,\n"
+"\t\tand reduces each to a small reproducer\n"
+"\t-s <filename>\n"
+"\t\tSamples the number of beats on each stream and AXI port every\n"
+"\t\t-i clocks, and writes the time series to <filename> (CSV)\n"
 "\t-t <filename>\n"
 "\t\tTurns on tracing, sends the trace to <filename>--assumed to\n"
 "\t\tbe a vcd file\n"
-);
+"\t-u\tRuns each mover across the 4GB boundary, to check its upper\n"
+"\t\taddress register\n"
+"\t-v\tChecks the RAM after each test on the simulation thread, rather\n"
+"\t\tthan on a separate worker thread while the simulation continues\n"
+"\t-w <clocks>\n"
+"\t\tReports any AXI channel stalled for more than <clocks>, along\n"
+"\t\twith every burst still in flight.  The default is %lu clocks.\n"
+"\t\tZero turns the watchdog off.\n"
+"\t-x\tRuns pairs of movers against one AXI RAM, and then against two,\n"
+"\t\tto measure the crossbar's bandwidth to separate slaves\n"
+, WATCHCOUNT);
 }
 // }}}
 
@@ -104,23 +1696,91 @@ int	main(int argc, char **argv) {
 	Verilated::commandArgs(argc, argv);
 
 	const	char *trace_file = NULL; // "trace.vcd";
+	const	char *bptrace_file = NULL;
+	const	char *sample_file = NULL;
+	unsigned long	sample_period = 256;
+	FILE	*sample_fp = NULL;
+	const	char *timeline_file = NULL;
+	FILE	*timeline_fp = NULL;
+	AXITRACE	*timeline = NULL;
+	unsigned long	watch_clocks = WATCHCOUNT;
+	AXIWATCH	*watch = NULL;
+	TOGGLEMON	*toggles = NULL;
+	bool	toggle_flag = false;
+	bool	handoff_flag = false;
+	bool	abort_flag = false;
+	bool	errrecover_flag = false;
+	bool	hiaddr_flag = false;
+	bool	latency_flag = false;
+	bool	sync_verify = false;
+	bool	xslave_flag = false;
+	bool	qos_flag = false;
 	bool	debug_flag = false;
+	bool	hostprof_flag = false;
 	bool	fail = false;
 	AXI_TB<MAINTB>	*tb = new AXI_TB<MAINTB>;
 	unsigned long	start_counts;
+	unsigned	worst_cases = 0, worst_seed = 1;
+	char		*ptr;
+	CONTEND		contention[AXIMON::NMASTERS] = {
+				{ "mm2s", CONTEND_LENGTH, 0 },
+				{ "s2mm", CONTEND_LENGTH, 0 },
+				{ "dma",  CONTEND_LENGTH, 0 } };
 	// }}}
 
+	// Start the clock for the SPEED: line
+	elapsed();
+
 	// Process arguments
 	// {{{
 	for(int argn=1; argn < argc; argn++) {
-		if (argv[argn][0] == '-') for(int j=1;
+		if (argv[argn][0] == '+')
+			continue;	// +verilator+... arguments
+		else if (argv[argn][0] == '-') for(int j=1;
 					(j<512)&&(argv[argn][j]);j++) {
 			switch(tolower(argv[argn][j])) {
+			case 'a': toggle_flag = true; break;
 			case 'd': debug_flag = true;
 				if (trace_file == NULL)
 					trace_file = "trace.vcd";
 				break;
 			case 't': trace_file = argv[++argn]; j=1000; break;
+			case 'b': bptrace_file = argv[++argn]; j=1000; break;
+			case 'c': if (!parse_contend(argv[++argn], contention))
+					exit(EXIT_FAILURE);
+				j=1000; break;
+			case 'm': dramsim = DRAMSIM::create(argv[++argn]);
+				if (!dramsim)
+					exit(EXIT_FAILURE);
+				j=1000; break;
+			case 'e': if (!errsim)
+					errsim = new ERRSIM;
+				if (!errsim->parse(argv[++argn]))
+					exit(EXIT_FAILURE);
+				j=1000; break;
+			case 'i': sample_period = strtoul(argv[++argn], NULL, 0);
+				j=1000; break;
+			case 'o': reordersim = REORDERSIM::create(argv[++argn]);
+				if (!reordersim)
+					exit(EXIT_FAILURE);
+				j=1000; break;
+			case 'p': hostprof_flag = true; break;
+			case 'r': worst_cases = strtoul(argv[++argn], &ptr, 0);
+				if (*ptr == ':')
+					worst_seed = strtoul(ptr+1, NULL, 0);
+				j=1000; break;
+			case 's': sample_file = argv[++argn]; j=1000; break;
+			case 'v': sync_verify = true; break;
+			case 'j': timeline_file = argv[++argn]; j=1000; break;
+			case 'w': watch_clocks = strtoul(argv[++argn], NULL, 0);
+				j=1000; break;
+			case 'g': handoff_flag = true; break;
+			case 'k': abort_flag = true; break;
+			case 'f': errrecover_flag = true; break;
+			case 'u': hiaddr_flag = true; break;
+			case 'l': latency_flag = true; break;
+			case 'x': xslave_flag = true; break;
+			case 'q': qos_flag = true; break;
 			case 'h': usage(); exit(0); break;
 			default:
 				fprintf(stderr, "ERR: Unexpected flag, -%c\n\n",
@@ -138,24 +1798,60 @@ int	main(int argc, char **argv) {
 
 	// Setup
 	// {{{
+	if (hostprof_flag) {
+		hostprof = new HOSTPROF();
+		hostprof->phase("setup");
+	}
 	if (debug_flag) {
 		printf("Opening Bus-master with\n");
 		// printf("\tDebug Access port = %d\n", FPGAPORT);
 		printf("\tVCD File         = %s\n", trace_file);
 	} if (trace_file)
 		tb->opentrace(trace_file);
+	printf("MEMORY: %s\n", (dramsim) ? dramsim->name() : "ideal");
+	printf("ORDER:  %s\n", (reordersim) ? reordersim->name() : "in order");
+	if (sample_file) {
+		sample_fp = fopen(sample_file, "w");
+		if (NULL == sample_fp) {
+			fprintf(stderr, "ERR: Cannot open %s\n", sample_file);
+			exit(EXIT_FAILURE);
+		}
+		sampler = new AXISAMPLE(tb->m_tb->m_core, sample_fp,
+				sample_period);
+		tb->addmon(sampler);
+	} if (timeline_file) {
+		timeline_fp = fopen(timeline_file, "w");
+		if (NULL == timeline_fp) {
+			fprintf(stderr, "ERR: Cannot open %s\n", timeline_file);
+			exit(EXIT_FAILURE);
+		}
+		timeline = new AXITRACE(tb->m_tb->m_core, timeline_fp);
+		tb->addmon(timeline);
+	} if (watch_clocks > 0) {
+		watch = new AXIWATCH(tb->m_tb->m_core, watch_clocks,
+				&tb->m_bomb);
+		tb->addmon(watch);
+	} if (toggle_flag) {
+		toggles = new TOGGLEMON(tb->m_tb->m_core, BUSBYTES);
+		tb->addmon(toggles);
+	}
 	// }}}
+	verifier = new VERIFIER(!sync_verify);
+
+	// The RAM's timing model is selected on reset
 	tb->reset();
 
 	//
 	// Test the AXIMM2S
 	// {{{
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	for(int k=0; k<MM2S_LENGTHW; k++)
 		tb->TBRAM[k+MM2S_START_ADDRW] = k;
 	tb->write64(R_MM2SADDRLO, (uint64_t)MM2S_START_ADDR + R_AXIRAM);
 	tb->write64(R_MM2SLENLO,  (uint64_t)MM2S_LENGTH);
 	tb->writeio(R_STREAMSINK_BEATS, 0);
+	checkstream(tb, CHK_COUNTER);
+	mark("AXIMM2S");
 	start_counts = tb->tickcount();
 	tb->writeio(R_MM2SCTRL, MM2S_START_CMD);
 	while((tb->readio(R_MM2SCTRL) & MM2S_BUSY)==0)
@@ -166,14 +1862,21 @@ int	main(int argc, char **argv) {
 	printf("\tBEATS:  0x%08x\n", tb->readio(R_STREAMSINK_BEATS));
 	printf("\tCLOCKS: 0x%08x\n", tb->readio(R_STREAMSINK_CLOCKS));
 	printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
+	sinkstats(tb);
+	if (!verifystream(tb, MM2S_LENGTHW,
+			crc32(&tb->TBRAM[MM2S_START_ADDRW], MM2S_LENGTH)))
+		fail = true;
+	perfline("AXIMM2S", tb->readio(R_STREAMSINK_BEATS) * (unsigned long)BUSBYTES,
+		tb->readio(R_STREAMSINK_CLOCKS));
 
 	// Try aborting an AXIMM2S transaction
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	for(int k=0; k<MM2S_LENGTHW; k++)
 		tb->TBRAM[k+MM2S_START_ADDRW] = k;
 	tb->write64(R_MM2SADDRLO, (uint64_t)MM2S_START_ADDR + R_AXIRAM);
 	tb->write64(R_MM2SLENLO,  (uint64_t)MM2S_LENGTH);
 	tb->writeio(R_STREAMSINK_BEATS, 0);
+	mark("AXIMM2S-abort");
 	start_counts = tb->tickcount();
 	tb->writeio(R_MM2SCTRL, MM2S_START_CMD);
 	while((tb->readio(R_MM2SCTRL) & MM2S_BUSY)==0)
@@ -189,13 +1892,14 @@ int	main(int argc, char **argv) {
 	printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
 
 	// Try an unaligned AXIMM2S transaction
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	for(int k=0; k<MM2S_LENGTHW; k++)
 		tb->TBRAM[k+MM2S_START_ADDRW] = k;
 	tb->write64(R_MM2SADDRLO, (uint64_t)MM2S_START_ADDR + R_AXIRAM + 3);
 	if ((tb->readio(R_MM2SADDRLO) & 0x03)==3) {
 		tb->write64(R_MM2SLENLO,  (uint64_t)MM2S_LENGTH);
 		tb->writeio(R_STREAMSINK_BEATS, 0);
+		mark("AXIMM2S-unaligned");
 		start_counts = tb->tickcount();
 		tb->writeio(R_MM2SCTRL, MM2S_START_CMD);
 		while((tb->readio(R_MM2SCTRL) & MM2S_BUSY)==0)
@@ -206,16 +1910,22 @@ int	main(int argc, char **argv) {
 		printf("\tBEATS:  0x%08x\n", tb->readio(R_STREAMSINK_BEATS));
 		printf("\tCLOCKS: 0x%08x\n", tb->readio(R_STREAMSINK_CLOCKS));
 		printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
+		// As with the aligned test, measured by the stream sink
+		perfline("AXIMM2S-unaligned", tb->readio(R_STREAMSINK_BEATS)
+				* (unsigned long)BUSBYTES,
+			tb->readio(R_STREAMSINK_CLOCKS));
 	} else
 		printf("AXIMM2S (unaligned) Check: No unaligned support (0x%08x)\n", tb->readio(R_MM2SADDRLO));
 
 	// Try a continuous transaction
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	for(int k=0; k<MM2S_LENGTHW; k++)
 		tb->TBRAM[k+MM2S_START_ADDRW] = k;
 	tb->write64(R_MM2SADDRLO, (uint64_t)MM2S_START_ADDR + R_AXIRAM);
 	tb->write64(R_MM2SLENLO, (uint64_t) MM2S_LENGTH);
 	tb->writeio(R_STREAMSINK_BEATS, 0);
+	checkstream(tb, CHK_COUNTER);
+	mark("AXIMM2S-continuous");
 	start_counts = tb->tickcount();
 	tb->writeio(R_MM2SCTRL, MM2S_START_CMD | MM2S_CONTINUOUS);
 	while((tb->readio(R_MM2SCTRL) & MM2S_BUSY)==0)
@@ -226,6 +1936,9 @@ int	main(int argc, char **argv) {
 	printf("\tBEATS:  0x%08x\n", tb->readio(R_STREAMSINK_BEATS));
 	printf("\tCLOCKS: 0x%08x\n", tb->readio(R_STREAMSINK_CLOCKS));
 	printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
+	if (!verifystream(tb, MM2S_LENGTHW,
+			crc32(&tb->TBRAM[MM2S_START_ADDRW], MM2S_LENGTH)))
+		fail = true;
 	for(int k=0; k<MM2S_LENGTHW; k++)
 		tb->TBRAM[k+MM2S_START_ADDRW] = k + 0x100;
 	tb->idle(425);
@@ -242,15 +1955,89 @@ int	main(int argc, char **argv) {
 	printf("\tBEATS:  0x%08x\n", tb->readio(R_STREAMSINK_BEATS));
 	printf("\tCLOCKS: 0x%08x\n", tb->readio(R_STREAMSINK_CLOCKS));
 	printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
+	// The second half of the stream starts over at 0x100, so the checker
+	// should flag the first word following the hand-off
+	if ((tb->readio(R_STREAMCHK_CTRL) & CHK_ERR)
+			&& tb->readio(R_STREAMCHK_ERRIDX) == MM2S_LENGTHW
+			&& tb->readio(R_STREAMCHK_ERRDATA) == 0x100)
+		printf("\tCHECK:   Hand-off found at word %u\n", MM2S_LENGTHW);
+	else {
+		printf("\tERR: Continuous hand-off not found at word %u\n",
+			MM2S_LENGTHW);
+		fail = true;
+	}
+
+	// Repeat the AXIMM2S test against a stream sink that stalls
+	{
+		const struct {
+			const char	*m_name;
+			unsigned	m_mode, m_arg;
+		} bptests[] = {
+			{ "AXIMM2S-bp-duty75",  BP_DUTY,   BPARG(3, 4) },
+			{ "AXIMM2S-bp-duty50",  BP_DUTY,   BPARG(1, 2) },
+			{ "AXIMM2S-bp-duty10",  BP_DUTY,   BPARG(1,10) },
+			{ "AXIMM2S-bp-rand50",  BP_RANDOM, BPARG(0x8000, 0) },
+			{ "AXIMM2S-bp-burst16", BP_BURST,  BPARG(16,16) },
+			{ "AXIMM2S-bp-burst256",BP_BURST,  BPARG(256,256) },
+			{ "AXIMM2S-bp-replay",  BP_REPLAY, 0 }
+		};
+		const int	NBPTESTS = sizeof(bptests)/sizeof(bptests[0]);
+		unsigned	tracelen = 0;
+
+		if (bptrace_file)
+			tracelen = load_bptrace(tb, bptrace_file);
+
+		tb->CLEARRAM(-1);
+		for(int k=0; k<MM2S_LENGTHW; k++)
+			tb->TBRAM[k+MM2S_START_ADDRW] = k;
+
+		for(int t=0; t<NBPTESTS; t++) {
+			unsigned	mode = bptests[t].m_mode;
+
+			if (mode == BP_REPLAY) {
+				if (tracelen == 0)
+					continue;
+				// Replay length goes in BPCTRL[31:16]
+				mode |= tracelen << 16;
+			}
+
+			backpressure(tb, mode, bptests[t].m_arg);
+			tb->write64(R_MM2SADDRLO, (uint64_t)MM2S_START_ADDR + R_AXIRAM);
+			tb->write64(R_MM2SLENLO,  (uint64_t)MM2S_LENGTH);
+			tb->writeio(R_STREAMSINK_BEATS, 0);
+			checkstream(tb, CHK_COUNTER);
+			mark(bptests[t].m_name);
+			start_counts = tb->tickcount();
+			tb->writeio(R_MM2SCTRL, MM2S_START_CMD);
+			while((tb->readio(R_MM2SCTRL) & MM2S_BUSY)==0)
+				;
+			while(tb->readio(R_MM2SCTRL) & MM2S_BUSY)
+				;
+			printf("%s Check:\n", bptests[t].m_name);
+			printf("\tBEATS:  0x%08x\n", tb->readio(R_STREAMSINK_BEATS));
+			printf("\tCLOCKS: 0x%08x\n", tb->readio(R_STREAMSINK_CLOCKS));
+			printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
+			sinkstats(tb);
+			if (!verifystream(tb, MM2S_LENGTHW, crc32(
+				&tb->TBRAM[MM2S_START_ADDRW], MM2S_LENGTH)))
+				fail = true;
+			perfline(bptests[t].m_name,
+				tb->readio(R_STREAMSINK_BEATS) * (unsigned long)BUSBYTES,
+				tb->readio(R_STREAMSINK_CLOCKS));
+		}
+
+		backpressure(tb, BP_NONE, 0);
+	}
 	// }}}
 
 
 	//
 	// Test the AXIS2MM
 	// {{{
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	tb->write64(R_S2MMADDRLO, (uint64_t)S2MM_START_ADDR + R_AXIRAM);
 	tb->write64(R_S2MMLENLO,  (uint64_t)S2MM_LENGTH);
+	mark("AXIS2MM");
 	start_counts = tb->tickcount();
 	tb->writeio(R_S2MMCTRL, S2MM_START_CMD);
 	while((tb->readio(R_S2MMCTRL) & S2MM_BUSY)==0)
@@ -261,23 +2048,19 @@ int	main(int argc, char **argv) {
 	// printf("\tBEATS:  0x%08x\n", tb->readio(R_STREAMSINK_BEATS));
 	// printf("\tCLOCKS: 0x%08x\n", tb->readio(R_STREAMSINK_CLOCKS));
 	printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
+	perfline("AXIS2MM", S2MM_LENGTH, tb->tickcount()-start_counts);
 	printf("\tERR-CODE: %d\n", (tb->readio(R_S2MMCTRL)>>23)&0x07);
-	for(unsigned k=0; k<0x30>>2; k++)
-		if (tb->TBRAM[k] != (unsigned)(-1)) {
-			printf("Pre-corruption: AXIRAM[%d] = 0x%08x\n", k, tb->TBRAM[k]);
-			fail = true;
-		}
-	for(unsigned k=1 +(0x30>>2); k<(0x30>>2)+(16384>>2); k++)
-		if (tb->TBRAM[k] != tb->TBRAM[k-1]+1) {
-			printf("Result: AXIRAM[%d] = 0x%08x != 0x%08x + 1\n", k, tb->TBRAM[k], tb->TBRAM[k-1]);
-			fail = true;
-		}
+	verifier->fill("Pre-corruption", tb->TBRAM, 0, S2MM_START_ADDRW,
+		(unsigned)(-1));
+	verifier->increment("Result", tb->TBRAM, S2MM_START_ADDRW,
+		16384>>2);
 
 	// Try it again--this time aborting the transaction midway
 	start_counts = tb->tickcount();
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	tb->write64(R_S2MMADDRLO, (uint64_t)S2MM_START_ADDR + R_AXIRAM);
 	tb->write64(R_S2MMLENLO,  (uint64_t)S2MM_LENGTH);
+	mark("AXIS2MM-abort");
 	start_counts = tb->tickcount();
 	tb->writeio(R_S2MMCTRL, S2MM_START_CMD);
 	while((tb->readio(R_S2MMCTRL) & S2MM_BUSY)==0)
@@ -295,7 +2078,7 @@ int	main(int argc, char **argv) {
 /*
  * Doesn't work: all addresses are mapped
 	start_counts = tb->tickcount();
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	tb->writeio(R_S2MMADDR, R_AXIRAM /2);
 	tb->writeio(R_S2MMLEN,  S2MM_LENGTH);
 	start_counts = tb->tickcount();
@@ -314,14 +2097,17 @@ int	main(int argc, char **argv) {
 		printf("AXIS2MM (continuous):\n");
 		unsigned	requested = 0, read_data;
 		uint64_t	mskl, incl, next_len;
+		// Stop on this test's own failures, not those of any before it
+		bool		cfail = false;
 
-		memset(tb->TBRAM, -1, RAMSIZE);
+		tb->CLEARRAM(-1);
 		tb->write64(R_S2MMLENLO,  (uint64_t)-1);
 		mskl = tb->read64(R_S2MMLENLO);
 		incl = (~mskl + 1ul) & mskl;
 		tb->write64(R_S2MMADDRLO, (uint64_t)S2MM_START_ADDR + R_AXIRAM);
+		mark("AXIS2MM-continuous");
 		start_counts = tb->tickcount();
-		while(requested < S2MM_LENGTH && !fail) {
+		while(requested < S2MM_LENGTH && !cfail) {
 			next_len = (unsigned)rand() + incl;
 			next_len &= (unsigned)mskl;
 			next_len &= 255;
@@ -339,15 +2125,93 @@ int	main(int argc, char **argv) {
 
 			if (S2MM_CONTINUOUS != (read_data & S2MM_CONTINUOUS)) {
 				printf("ERROR: Continuous flag dropped!\n");
-				fail = true;
+				cfail = true;
 			} if (0 != (read_data & S2MM_ERR)) {
 				printf("ERROR: ERR flag set!\n");
-				fail = true;
+				cfail = true;
 			}
 			if (rand() & 1) {
 				tb->idle(425);
 			}
 		}
+
+		if (cfail)
+			fail = true;
+	}
+
+	// Repeat the AXIS2MM test at lower ingress rates, and with packets
+	{
+		const struct {
+			const char	*m_name;
+			unsigned	m_rate, m_burst, m_pktlen;
+			bool		m_continuous;
+		} srctests[] = {
+			{ "AXIS2MM-rate75",      SRC_RATE(3, 4), 0, 0, false },
+			{ "AXIS2MM-rate50",      SRC_RATE(1, 2), 0, 0, false },
+			{ "AXIS2MM-rate10",      SRC_RATE(1,10), 0, 0, false },
+			{ "AXIS2MM-burst16",     0, SRC_BURST(16,16), 0, false },
+			{ "AXIS2MM-burst256",    0, SRC_BURST(256,256), 0, false },
+			{ "AXIS2MM-pkt16",       0, 0,  16, false },
+			{ "AXIS2MM-pkt256",      0, 0, 256, false },
+			{ "AXIS2MM-cont",        0, 0,   0, true },
+			{ "AXIS2MM-cont-rate50", SRC_RATE(1, 2), 0, 64, true }
+		};
+		const int	NSRCTESTS = sizeof(srctests)/sizeof(srctests[0]);
+		const int	NCHUNKS = 4;
+
+		for(int t=0; t<NSRCTESTS; t++) {
+			unsigned	status = 0;
+
+			tb->CLEARRAM(-1);
+			streamsrc(tb, srctests[t].m_rate, srctests[t].m_burst,
+					srctests[t].m_pktlen);
+			tb->write64(R_S2MMADDRLO, (uint64_t)S2MM_START_ADDR + R_AXIRAM);
+			mark(srctests[t].m_name);
+			start_counts = tb->tickcount();
+			if (srctests[t].m_continuous) {
+				// The same transfer, but handed to the S2MM in
+				// pieces, each picking up where the last ended
+				for(int c=0; c<NCHUNKS; c++) {
+					tb->write64(R_S2MMLENLO,
+						(uint64_t)S2MM_LENGTH/NCHUNKS);
+					tb->writeio(R_S2MMCTRL,
+						S2MM_START_CMD|S2MM_CONTINUOUS);
+					while((tb->readio(R_S2MMCTRL) & S2MM_BUSY)==0)
+						;
+					while((status = tb->readio(R_S2MMCTRL)) & S2MM_BUSY)
+						;
+					if (status & S2MM_ERR)
+						break;
+				}
+			} else {
+				tb->write64(R_S2MMLENLO,  (uint64_t)S2MM_LENGTH);
+				tb->writeio(R_S2MMCTRL, S2MM_START_CMD);
+				while((tb->readio(R_S2MMCTRL) & S2MM_BUSY)==0)
+					;
+				while((status = tb->readio(R_S2MMCTRL)) & S2MM_BUSY)
+					;
+			}
+
+			printf("%s Check:\n", srctests[t].m_name);
+			printf("\tCOUNTS:  0x%08lx\n", tb->tickcount()-start_counts);
+			printf("\tBEATS:   0x%08x\n", tb->readio(R_STREAMSRC_BEATS));
+			printf("\tPACKETS: 0x%08x\n", tb->readio(R_STREAMSRC_PACKETS));
+			printf("\tSTALLS:  0x%08x\n", tb->readio(R_STREAMSRC_STALLS));
+			printf("\tERR-CODE: %d\n", (status>>23)&0x07);
+			perfline(srctests[t].m_name, S2MM_LENGTH,
+				tb->tickcount()-start_counts);
+
+			if (status & S2MM_ERR) {
+				printf("ERROR: %s, ERR flag set!\n",
+					srctests[t].m_name);
+				fail = true;
+			}
+
+			verifier->increment(srctests[t].m_name, tb->TBRAM,
+				S2MM_START_ADDRW, S2MM_LENGTHW);
+		}
+
+		streamsrc(tb, 0, 0, 0);
 	}
 	// }}}
 
@@ -356,10 +2220,12 @@ int	main(int argc, char **argv) {
 	// Test the AXIDMA
 	// {{{
 	printf("Running AXI DMA test\n");
-	memset(tb->TBRAM, -1, RAMSIZE);
+	tb->CLEARRAM(-1);
 	tb->write64(R_AXIDMASRCLO,  (uint64_t)DMA_SRC_ADDR + R_AXIRAM);
 	tb->write64(R_AXIDMADSTLO,  (uint64_t)DMA_DST_ADDR + R_AXIRAM);
 	tb->write64(R_AXIDMALENLO,  (uint64_t)DMA_LENGTH);
+	mark("AXIDMA");
+	start_counts = tb->tickcount();
 	tb->writeio(R_AXIDMACTRL, DMA_START_CMD);
 	while((tb->readio(R_AXIDMACTRL) & DMA_BUSY_BIT)==0)
 		;
@@ -370,15 +2236,142 @@ int	main(int argc, char **argv) {
 			if (throttle++ > 2000)
 				printf("TICKCOUNT = %ld\n", tb->tickcount());
 		}
-		if (tb->tickcount() >= 400000)
-			return EXIT_FAILURE;
+		if (tb->tickcount() - start_counts >= DMA_TIMEOUT) {
+			printf("AXIDMA timed out at clock %lu\n",
+				tb->tickcount());
+			if (watch)
+				watch->dump(tb->tickcount());
+			fail = true;
+			break;
+		}
+	}
+
+	if (tb->readio(R_AXIDMACTRL) & DMA_BUSY_BIT) {
+		// Stop it, so that it doesn't run into the tests that follow
+		start_counts = tb->tickcount();
+		tb->writeio(R_AXIDMACTRL, DMA_ABORT_CMD);
+		while((tb->readio(R_AXIDMACTRL) & DMA_BUSY_BIT)
+				&& tb->tickcount() - start_counts < DMA_TIMEOUT)
+			;
+	} else {
+		printf("AXIDMA Check:\n");
+		printf("\tCOUNTS: 0x%08lx\n", tb->tickcount()-start_counts);
+		perfline("AXIDMA", DMA_LENGTH, tb->tickcount()-start_counts);
 	}
 	// }}}
-	printf("AXIDMA Check:\n");
+
+	//
+	// How long does it take to move a single word?
+	if (latency_flag && !cmdlatency(tb))
+		fail = true;
+
+	//
+	// How much is lost between continuous commands?
+	if (handoff_flag && !handoff(tb))
+		fail = true;
+
+	//
+	// How quickly does each mover respond to an abort?
+	if (abort_flag && !abortsweep(tb))
+		fail = true;
+
+	//
+	// How quickly does each mover recover from a bus error?
+	if (errrecover_flag && !errrecover(tb))
+		fail = true;
+
+	//
+	// All three at once
+	if (!contend(tb, contention))
+		fail = true;
+
+	//
+	// Pairs of movers, against one RAM and then against two
+	if (xslave_flag && !xslave(tb))
+		fail = true;
+
+	// The MM2S under a DMA load, at several QoS settings
+	if (qos_flag && !qosbench(tb))
+		fail = true;
+
+	//
+	// Every mover, across 4GB
+	if (hiaddr_flag && !hiaddr(tb))
+		fail = true;
+
+	//
+	// Random cases, looking for the slowest
+	if (worst_cases > 0 && !worstcase(tb, worst_cases, worst_seed))
+		fail = true;
+
+	//
+	// The host software scenario, as also run against the transaction
+	// level model by tlm_tb
+	mark("scenario");
+	if (!scenario(tb, BUSBYTES))
+		fail = true;
+
+	//
+	// Collect the results of every RAM check
+	mark("verify");
+	if (!verifier->finish(stdout))
+		fail = true;
+	delete verifier;
+	verifier = NULL;
+
+	if (dramsim)
+		dramsim->report(stdout);
+	if (reordersim)
+		reordersim->report(stdout);
+	if (errsim)
+		errsim->report(stdout);
+#ifdef	AXIRAM_SPARSE
+	printf("SPARSE: %lu pages in use, %lu bytes allocated\n",
+		getsparsemem()->pages(),
+		(unsigned long)getsparsemem()->footprint());
+#endif
 
 	VerilatedCov::write("logs/coverage.dat");
+	if (sampler) {
+		tb->delmon(sampler);
+		delete sampler;
+		fclose(sample_fp);
+	} if (timeline) {
+		tb->delmon(timeline);
+		delete timeline;
+		fclose(timeline_fp);
+	} if (watch) {
+		tb->delmon(watch);
+		delete watch;
+	} if (toggles) {
+		tb->delmon(toggles);
+		toggles->report(stdout);
+		delete toggles;
+	}
+
+	if (hostprof) {
+		hostprof->report(stdout);
+		delete hostprof;
+		hostprof = NULL;
+	}
+
+	{
+		double	secs = elapsed();
+
+		printf("SPEED: %lu clocks in %.2f seconds, %.0f clocks/second\n",
+			tb->tickcount(), secs,
+			(secs > 0) ? tb->tickcount() / secs : 0.0);
+	}
+
+	if (tb->bombed()) {
+		printf("ERR: The stall watchdog tripped\n");
+		fail = true;
+	}
 	tb->close();
 	delete tb;
+	delete dramsim;
+	delete reordersim;
+	delete errsim;
 
 	if (fail) {
 		printf("TEST FAIL!\n");
@@ -36,17 +36,58 @@
 ////////////////////////////////////////////////////////////////////////////////
 //
 // }}}
+#ifndef	AXI_TB_H
+#define	AXI_TB_H
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <vector>
+#include <algorithm>
 
 #include <verilated.h>
 #include <verilated_vcd_c.h>
 #include "testb.h"
 #include "devbus.h"
+#include "hostprof.h"
+
+//
+// Bus lane access
+// {{{
+// The host port, S_AXI_*, is as wide as the AXI bus.  Verilator presents a
+// port of up to 32-bits as an IData (uint32_t), up to 64-bits as a QData
+// (uint64_t), and anything wider as an array of 32-bit words.  These helpers
+// move one 32-bit value into (or out of) a given 32-bit lane of such a port,
+// whatever its width may be.
+//
+inline	void	setlane(uint32_t &w, unsigned, uint32_t v) { w = v; }
+inline	void	setlane(uint64_t &w, unsigned lane, uint32_t v) {
+	w &= ~(0x0ffffffffull << (32*lane));
+	w |= ((uint64_t)v) << (32*lane);
+}
+template<class W>	inline	void	setlane(W &w, unsigned lane, uint32_t v) {
+	w[lane] = v;
+}
+
+inline	uint32_t	getlane(const uint32_t &w, unsigned) { return w; }
+inline	uint32_t	getlane(const uint64_t &w, unsigned lane) {
+	return (uint32_t)(w >> (32*lane));
+}
+template<class W>	inline	uint32_t getlane(const W &w, unsigned lane) {
+	return w[lane];
+}
+// }}}
 
 //
-// Number of clocks before deciding a peripheral is broken
-const int	BOMBCOUNT = 32;
+// TICKMON
+// {{{
+// Anything that wants to watch the design, once per clock, following each
+// clock edge.  See AXI_TB::addmon().
+class	TICKMON {
+public:
+	virtual	~TICKMON(void) {}
+	virtual	void	tick(unsigned long clk) = 0;
+};
+// }}}
 
 template <class TB>	class	AXI_TB : public DEVBUS {
 	// {{{
@@ -55,6 +96,7 @@ template <class TB>	class	AXI_TB : public DEVBUS {
 	bool	m_interrupt;
 #endif
 	VerilatedVcdC	*m_trace;
+	std::vector<TICKMON *>	m_monitors;
 public:
 	TB		*m_tb;
 	typedef	uint32_t	BUSW;
@@ -129,11 +171,35 @@ public:
 	// {{{
 #define	TICK	m_tb->tick
 	void	tick(void) {
-		m_tb->tick_clk();
+		{
+			HOSTPROF_SCOPE(HOSTPROF::S_CLOCK);
+			m_tb->tick_clk();
+		}
 #ifdef	INTERRUPTWIRE
 		if (m_tb->m_core->INTERRUPTWIRE)
 			m_interrupt = true;
 #endif
+		if (!m_monitors.empty()) {
+			HOSTPROF_SCOPE(HOSTPROF::S_MONITORS);
+			unsigned long	clk = tickcount();
+
+			for(TICKMON *mon : m_monitors)
+				mon->tick(clk);
+		}
+	}
+	// }}}
+
+	// addmon(), delmon()
+	// {{{
+	// Attach (or detach) a monitor, to be called after every clock.  The
+	// monitor still belongs to the caller.
+	void	addmon(TICKMON *mon) {
+		m_monitors.push_back(mon);
+	}
+
+	void	delmon(TICKMON *mon) {
+		m_monitors.erase(std::remove(m_monitors.begin(),
+				m_monitors.end(), mon), m_monitors.end());
 	}
 	// }}}
 
@@ -161,6 +227,23 @@ public:
 	}
 	// }}}
 
+	// buslanes(), lane(), lanestrb()
+	// {{{
+	// The number of 32-bit lanes in the (possibly wide) host bus, and which
+	// of those lanes (and strobes) a 32-bit access to address a will use.
+	unsigned	buslanes(void) const {
+		return sizeof(m_tb->m_core->S_AXI_WDATA) / sizeof(uint32_t);
+	}
+
+	unsigned	lane(const BUSA a) const {
+		return (a >> 2) & (buslanes()-1);
+	}
+
+	uint64_t	lanestrb(const BUSA a) const {
+		return 0x0full << (4*lane(a));
+	}
+	// }}}
+
 	// idle() -- pass a tick w/o doing anything
 	// {{{
 	void	idle(const unsigned counts = 1) {
@@ -185,10 +268,10 @@ public:
 	//
 	// readio()
 	// {{{
-	BUSW readio(BUSW a) {
+	BUSW readio(BUSA a) {
 		BUSW		result;
 
-		// printf("AXI-READM(%08x)\n", a);
+		// printf("AXI-READM(%09lx)\n", a);
 
 		m_tb->m_core->S_AXI_ARVALID = 1;
 		m_tb->m_core->S_AXI_ARADDR  = a;
@@ -204,7 +287,7 @@ public:
 		while(!m_tb->m_core->S_AXI_RVALID) // || !RVALID
 			tick();
 
-		result = m_tb->m_core->S_AXI_RDATA;
+		result = getlane(m_tb->m_core->S_AXI_RDATA, lane(a));
 		if (m_tb->m_core->S_AXI_RRESP & 2)
 			m_buserr = true;
 		assert(m_tb->m_core->S_AXI_RRESP == 0);
@@ -217,7 +300,7 @@ public:
 
 	// read64()
 	// {{{
-	uint64_t read64(BUSW a) {
+	uint64_t read64(BUSA a) {
 		uint64_t	result;
 		uint32_t	buf[2];
 
@@ -230,10 +313,10 @@ public:
 
 	// readv()
 	// {{{
-	void	readv(const BUSW a, int len, BUSW *buf, const int inc=1) {
+	void	readv(const BUSA a, int len, BUSW *buf, const int inc=1) {
 		int		cnt, rdidx;
 
-		printf("AXI-READM(%08x, %d)\n", a, len);
+		// printf("AXI-READM(%09lx, %d)\n", a, len);
 		m_tb->m_core->S_AXI_ARVALID = 1;
 		m_tb->m_core->S_AXI_ARADDR  = a & -4;
 		//
@@ -250,9 +333,11 @@ public:
 			tick();
 			m_tb->m_core->S_AXI_ARADDR += (inc&s)?4:0;
 			cnt += s;
-			if (m_tb->m_core->S_AXI_RVALID)
-				buf[rdidx++] = m_tb->m_core->S_AXI_RDATA;
-			if (m_tb->m_core->S_AXI_RVALID
+			if (m_tb->m_core->S_AXI_RVALID) {
+				buf[rdidx] = getlane(m_tb->m_core->S_AXI_RDATA,
+					lane(a + ((inc) ? 4*rdidx : 0)));
+				rdidx++;
+			} if (m_tb->m_core->S_AXI_RVALID
 					&& m_tb->m_core->S_AXI_RRESP != 0)
 				m_buserr = true;
 		} while(cnt < len);
@@ -261,8 +346,11 @@ public:
 
 		while(rdidx < len) {
 			tick();
-			if ((m_tb->m_core->S_AXI_RVALID)&&(m_tb->m_core->S_AXI_RREADY))
-				buf[rdidx++] = m_tb->m_core->S_AXI_RDATA;
+			if ((m_tb->m_core->S_AXI_RVALID)&&(m_tb->m_core->S_AXI_RREADY)) {
+				buf[rdidx] = getlane(m_tb->m_core->S_AXI_RDATA,
+					lane(a + ((inc) ? 4*rdidx : 0)));
+				rdidx++;
+			}
 			if (m_tb->m_core->S_AXI_RVALID && m_tb->m_core->S_AXI_RRESP != 0)
 				m_buserr = true;
 		}
@@ -276,14 +364,14 @@ public:
 
 	// readi()
 	// {{{
-	void	readi(const BUSW a, const int len, BUSW *buf) {
+	void	readi(const BUSA a, const int len, BUSW *buf) {
 		readv(a, len, buf, 1);
 	}
 	// }}}
 
 	// readz()
 	// {{{
-	void	readz(const BUSW a, const int len, BUSW *buf) {
+	void	readz(const BUSA a, const int len, BUSW *buf) {
 		readv(a, len, buf, 0);
 	}
 	// }}}
@@ -296,16 +384,16 @@ public:
 	//
 	// writeio()
 	// {{{
-	void	writeio(const BUSW a, const BUSW v) {
-		// printf("AXI-WRITEM(%08x) <= %08x\n", a, v);
+	void	writeio(const BUSA a, const BUSW v) {
+		// printf("AXI-WRITEM(%09lx) <= %08x\n", a, v);
 		m_tb->m_core->S_AXI_ARVALID = 0;
 		m_tb->m_core->S_AXI_RREADY  = 0;
 
 		m_tb->m_core->S_AXI_AWVALID = 1;
 		m_tb->m_core->S_AXI_WVALID  = 1;
 		m_tb->m_core->S_AXI_AWADDR  = a & (-4);
-		m_tb->m_core->S_AXI_WDATA   = v;
-		m_tb->m_core->S_AXI_WSTRB   = 0x0f;
+		setlane(m_tb->m_core->S_AXI_WDATA, lane(a), v);
+		m_tb->m_core->S_AXI_WSTRB   = lanestrb(a);
 
 		while((m_tb->m_core->S_AXI_AWVALID)
 			&&(m_tb->m_core->S_AXI_WVALID)) {
@@ -333,9 +421,9 @@ public:
 
 	// write64()
 	// {{{
-	void	write64(const BUSW a, const uint64_t v) {
+	void	write64(const BUSA a, const uint64_t v) {
 		uint32_t	buf[2];
-		// printf("AXI-WRITE64(%08x) <= %016lx\n", a, v);
+		// printf("AXI-WRITE64(%09lx) <= %016lx\n", a, v);
 		buf[0] = (uint32_t)v;
 		buf[1] = (uint32_t)(v >> 32);
 		writei(a, 2, buf);
@@ -344,22 +432,28 @@ public:
 
 	// writev()
 	// {{{
-	void	writev(const BUSW a, const int ln, const BUSW *buf, const int inc=1) {
+	void	writev(const BUSA a, const int ln, const BUSW *buf, const int inc=1) {
 		unsigned nacks = 0, awcnt = 0, wcnt = 0;
 
-		// printf("AXI-WRITEM(%08x, %d, ...)\n", a, ln);
+		// printf("AXI-WRITEM(%09lx, %d, ...)\n", a, ln);
 		m_tb->m_core->S_AXI_AWVALID = 1;
 		m_tb->m_core->S_AXI_AWADDR  = a & -4;
 		m_tb->m_core->S_AXI_WVALID = 1;
-		m_tb->m_core->S_AXI_WSTRB  = 0x0f;
-		m_tb->m_core->S_AXI_WDATA  = buf[0];
+		m_tb->m_core->S_AXI_WSTRB  = lanestrb(a);
+		setlane(m_tb->m_core->S_AXI_WDATA, lane(a), buf[0]);
 		m_tb->m_core->S_AXI_BREADY = 1;
 		m_tb->m_core->S_AXI_RREADY = 0;
 
 		do {
 			int	awready, wready;
 
-			m_tb->m_core->S_AXI_WDATA   = buf[wcnt];
+			if (wcnt < (unsigned)ln) {
+				BUSA	wa = a + ((inc) ? 4*wcnt : 0);
+
+				setlane(m_tb->m_core->S_AXI_WDATA, lane(wa),
+								buf[wcnt]);
+				m_tb->m_core->S_AXI_WSTRB = lanestrb(wa);
+			}
 
 			m_tb->m_core->S_AXI_AWVALID = (awcnt < (unsigned)ln);
 			m_tb->m_core->S_AXI_WVALID  = (wcnt < (unsigned)ln);
@@ -413,14 +507,14 @@ public:
 
 	// writei()
 	// {{{
-	void	writei(const BUSW a, const int ln, const BUSW *buf) {
+	void	writei(const BUSA a, const int ln, const BUSW *buf) {
 		writev(a, ln, buf, 1);
 	}
 	// }}}
 
 	// writez()
 	// {{{
-	void	writez(const BUSW a, const int ln, const BUSW *buf) {
+	void	writez(const BUSA a, const int ln, const BUSW *buf) {
 		writev(a, ln, buf, 0);
 	}
 	// }}}
@@ -508,4 +602,4 @@ public:
 	// }}}
 // }}}
 };
-
+#endif	// AXI_TB_H
@@ -0,0 +1,350 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/aximon.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Watches the internal AXI bus, clock by clock, to measure how
+//		the data movers share it.  For each master (MM2S, S2MM, and
+//	the DMA) this records the number of requests, the number of data
+//	beats, how long requests waited on the interconnect (xVALID && !xREADY
+//	at the master), and the span of clocks over which the master was
+//	active.  At the AXI RAM, it counts the clocks with a data beat, and
+//	which ID each such beat belonged to.  Each master's IDs are learned
+//	from the requests it makes, rather than assumed, so that the RAM's
+//	beats can be charged to the right master.
+//
+//	The signals are read directly from the Verilated model.  rtl/main.vlt
+//	keeps them there.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	AXIMON_H
+#define	AXIMON_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <deque>
+
+#include "verilated.h"
+#include "Vmain.h"
+#include "axi_tb.h"
+
+// Compatibility definitions for Verilator 3.8 to 3.9
+#ifndef	VVAR
+#ifdef	ROOT_VERILATOR
+#include "Vmain___024root.h"
+
+#define	VVAR(A)	rootp->main__DOT_ ## A
+#elif	defined(NEW_VERILATOR)
+#define	VVAR(A)	main__DOT_ ## A
+#else
+#define	VVAR(A)	v__DOT_ ## A
+#endif
+#endif
+
+//
+// AXICHAN
+// {{{
+// One request channel (AR or AW) together with its data channel (R or W)
+class	AXICHAN {
+	CData	*m_avalid, *m_aready, *m_aid, *m_alen, *m_dvalid, *m_dready;
+public:
+	unsigned long	m_requests, m_beats, m_expected, m_waits;
+	unsigned long	m_first, m_last;
+	unsigned	m_ids;	// One bit for each AxID this channel has used
+
+	AXICHAN(void) {
+		m_avalid = m_aready = m_aid = m_alen = NULL;
+		m_dvalid = m_dready = NULL;
+		clear();
+	}
+
+	void	bind(CData *avalid, CData *aready, CData *aid, CData *alen,
+			CData *dvalid, CData *dready) {
+		m_avalid = avalid; m_aready = aready; m_aid = aid;
+		m_alen = alen; m_dvalid = dvalid; m_dready = dready;
+	}
+
+	void	clear(void) {
+		m_requests = m_beats = m_expected = m_waits = 0;
+		m_first = m_last = 0;
+		m_ids = 0;
+	}
+
+	bool	bound(void) const { return m_avalid != NULL; }
+	bool	active(void) const { return m_requests > 0; }
+
+	void	tick(unsigned long clk) {
+		if (!m_avalid)
+			return;
+		if (*m_avalid) {
+			if (m_requests == 0 && m_waits == 0)
+				m_first = clk;
+			if (*m_aready) {
+				m_requests++;
+				m_expected += *m_alen + 1;
+				m_ids |= 1u << (*m_aid & 7);
+			} else
+				m_waits++;
+		}
+
+		if (*m_dvalid && *m_dready) {
+			m_beats++;
+			m_last = clk;
+		}
+	}
+};
+// }}}
+
+//
+// AXIMON
+// {{{
+class	AXIMON : public TICKMON {
+public:
+	enum { MM2S = 0, S2MM, DMA, NMASTERS };
+
+	typedef	struct {
+		const char	*m_name;
+		AXICHAN		m_rd, m_wr;
+	} MASTER;
+
+	MASTER		m_master[NMASTERS];
+
+	// At the AXI RAM
+	// Read and write beats are kept apart, since a read and a write may
+	// share an ID
+	unsigned long	m_ram_busy, m_ram_rbeats[8], m_ram_wbeats[8];
+private:
+	CData	*m_ram_awvalid, *m_ram_awready, *m_ram_awid,
+		*m_ram_wvalid, *m_ram_wready, *m_ram_wlast,
+		*m_ram_rvalid, *m_ram_rready, *m_ram_rid;
+	// The W channel carries no ID.  Since write data follows the order of
+	// the write addresses, keep the AWIDs to know who each W beat is for.
+	std::deque<unsigned>	m_awids;
+
+	unsigned long	first(const MASTER &m) const;
+	unsigned long	last(const MASTER &m) const;
+public:
+	AXIMON(Vmain *core) {
+		// {{{
+		m_master[MM2S].m_name = "MM2S";
+		m_master[MM2S].m_rd.bind(&core->VVAR(_axi_mm2s_arvalid),
+			&core->VVAR(_axi_mm2s_arready),
+			&core->VVAR(_axi_mm2s_arid),
+			&core->VVAR(_axi_mm2s_arlen),
+			&core->VVAR(_axi_mm2s_rvalid),
+			&core->VVAR(_axi_mm2s_rready));
+
+		m_master[S2MM].m_name = "S2MM";
+		m_master[S2MM].m_wr.bind(&core->VVAR(_axi_s2mm_awvalid),
+			&core->VVAR(_axi_s2mm_awready),
+			&core->VVAR(_axi_s2mm_awid),
+			&core->VVAR(_axi_s2mm_awlen),
+			&core->VVAR(_axi_s2mm_wvalid),
+			&core->VVAR(_axi_s2mm_wready));
+
+		m_master[DMA].m_name = "DMA";
+		m_master[DMA].m_rd.bind(&core->VVAR(_axi_dma_arvalid),
+			&core->VVAR(_axi_dma_arready),
+			&core->VVAR(_axi_dma_arid),
+			&core->VVAR(_axi_dma_arlen),
+			&core->VVAR(_axi_dma_rvalid),
+			&core->VVAR(_axi_dma_rready));
+		m_master[DMA].m_wr.bind(&core->VVAR(_axi_dma_awvalid),
+			&core->VVAR(_axi_dma_awready),
+			&core->VVAR(_axi_dma_awid),
+			&core->VVAR(_axi_dma_awlen),
+			&core->VVAR(_axi_dma_wvalid),
+			&core->VVAR(_axi_dma_wready));
+
+		m_ram_awvalid = &core->VVAR(_axi_axiram_awvalid);
+		m_ram_awready = &core->VVAR(_axi_axiram_awready);
+		m_ram_awid    = &core->VVAR(_axi_axiram_awid);
+		m_ram_wvalid  = &core->VVAR(_axi_axiram_wvalid);
+		m_ram_wready  = &core->VVAR(_axi_axiram_wready);
+		m_ram_wlast   = &core->VVAR(_axi_axiram_wlast);
+		m_ram_rvalid  = &core->VVAR(_axi_axiram_rvalid);
+		m_ram_rready  = &core->VVAR(_axi_axiram_rready);
+		m_ram_rid     = &core->VVAR(_axi_axiram_rid);
+
+		clear();
+	}
+	// }}}
+
+	void	clear(void) {
+		// {{{
+		for(int m=0; m<NMASTERS; m++) {
+			m_master[m].m_rd.clear();
+			m_master[m].m_wr.clear();
+		}
+		m_ram_busy = 0;
+		for(int k=0; k<8; k++)
+			m_ram_rbeats[k] = m_ram_wbeats[k] = 0;
+		m_awids.clear();
+	}
+	// }}}
+
+	virtual	void	tick(unsigned long clk) {
+		// {{{
+		bool	busy = false;
+
+		for(int m=0; m<NMASTERS; m++) {
+			m_master[m].m_rd.tick(clk);
+			m_master[m].m_wr.tick(clk);
+		}
+
+		if (*m_ram_awvalid && *m_ram_awready)
+			m_awids.push_back(*m_ram_awid & 7);
+		if (*m_ram_rvalid && *m_ram_rready) {
+			m_ram_rbeats[*m_ram_rid & 7]++;
+			busy = true;
+		} if (*m_ram_wvalid && *m_ram_wready) {
+			// W may arrive on the same clock as its AW
+			if (!m_awids.empty()) {
+				m_ram_wbeats[m_awids.front()]++;
+				if (*m_ram_wlast)
+					m_awids.pop_front();
+			}
+			busy = true;
+		}
+
+		if (busy)
+			m_ram_busy++;
+	}
+	// }}}
+
+	// Bytes moved by a master, counting both reads and writes
+	unsigned long	bytes(int m, unsigned busbytes) const {
+		return (m_master[m].m_rd.m_beats + m_master[m].m_wr.m_beats)
+				* (unsigned long)busbytes;
+	}
+
+	// Number of clocks from a master's first request to its last beat
+	unsigned long	window(int m) const {
+		if (!active(m))
+			return 0;
+		return last(m_master[m]) - first(m_master[m]) + 1;
+	}
+
+	bool	active(int m) const {
+		return m_master[m].m_rd.active() || m_master[m].m_wr.active();
+	}
+
+	// Bytes per clock achieved by master m while it was active
+	double	bandwidth(int m, unsigned busbytes) const {
+		unsigned long	w = window(m);
+		return (w > 0) ? bytes(m, busbytes) / (double)w : 0.0;
+	}
+
+	double	jain(unsigned busbytes) const;
+	void	report(FILE *fp, unsigned busbytes) const;
+};
+
+inline	unsigned long	AXIMON::first(const MASTER &m) const {
+	if (!m.m_wr.active())
+		return m.m_rd.m_first;
+	if (!m.m_rd.active())
+		return m.m_wr.m_first;
+	return (m.m_rd.m_first < m.m_wr.m_first) ? m.m_rd.m_first : m.m_wr.m_first;
+}
+
+inline	unsigned long	AXIMON::last(const MASTER &m) const {
+	return (m.m_rd.m_last > m.m_wr.m_last) ? m.m_rd.m_last : m.m_wr.m_last;
+}
+
+// jain()
+// {{{
+// Jain's fairness index across the active masters: (sum x)^2 / (n sum x^2),
+// where x is each master's bandwidth.  1.0 is a perfectly even split, 1/n
+// means one master had it all.
+inline	double	AXIMON::jain(unsigned busbytes) const {
+	double	sum = 0, sumsq = 0;
+	int	n = 0;
+
+	for(int m=0; m<NMASTERS; m++) {
+		double	x;
+
+		if (!active(m))
+			continue;
+		x = bandwidth(m, busbytes);
+		sum += x;
+		sumsq += x * x;
+		n++;
+	}
+
+	if (n == 0 || sumsq == 0)
+		return 0.0;
+	return (sum * sum) / (n * sumsq);
+}
+// }}}
+
+// report()
+// {{{
+inline	void	AXIMON::report(FILE *fp, unsigned busbytes) const {
+	unsigned long	total = 0;
+
+	// A read and a write beat may share a clock, so each master's share
+	// of the RAM is taken from the RAM's beats, not its busy clocks
+	for(int k=0; k<8; k++)
+		total += m_ram_rbeats[k] + m_ram_wbeats[k];
+
+	fprintf(fp, "%-6s %10s %8s %10s %8s %8s %8s %8s\n",
+		"MASTER", "BYTES", "CLOCKS", "BYTES/CLK", "RAM-SHR",
+		"REQS", "WAITS", "WAIT/RQ");
+	for(int m=0; m<NMASTERS; m++) {
+		const MASTER	&ms = m_master[m];
+		unsigned long	beats = 0, reqs, waits;
+
+		if (!active(m))
+			continue;
+		for(int k=0; k<8; k++) {
+			if (ms.m_rd.m_ids & (1u << k))
+				beats += m_ram_rbeats[k];
+			if (ms.m_wr.m_ids & (1u << k))
+				beats += m_ram_wbeats[k];
+		}
+
+		reqs  = ms.m_rd.m_requests + ms.m_wr.m_requests;
+		waits = ms.m_rd.m_waits + ms.m_wr.m_waits;
+
+		fprintf(fp, "%-6s %10lu %8lu %10.3f %7.1f%% %8lu %8lu %8.2f\n",
+			ms.m_name, bytes(m, busbytes), window(m),
+			bandwidth(m, busbytes),
+			(total > 0) ? 100.0 * beats / total : 0.0,
+			reqs, waits, (reqs > 0) ? waits / (double)reqs : 0.0);
+	}
+
+	fprintf(fp, "RAM busy: %lu clocks, %lu beats\n", m_ram_busy, total);
+	fprintf(fp, "Jain's fairness index: %.4f\n", jain(busbytes));
+}
+// }}}
+// }}}
+#endif	// AXIMON_H
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/axisample.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Samples the design's throughput every so many clocks, and
+//		writes the result to a file as a time series.  Each row of the
+//	(CSV) file holds the number of beats, within one sample period, of
+//
+//	- the stream into the stream sink (from the MM2S),
+//	- the stream out of the stream source (into the S2MM),
+//	- each master's read and write data channels, and
+//	- the AXI RAM's read and write data channels, from every master.
+//
+//	The first column is the clock at the end of the period.  Lines that
+//	start with '#' mark where each test began, so that a plot can be
+//	labeled.  Ramp-up, steady state, and tail effects--such as the gap
+//	between two continuous MM2S commands--can then be seen and measured.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	AXISAMPLE_H
+#define	AXISAMPLE_H
+
+#include <stdio.h>
+
+#include "aximon.h"
+
+class	AXISAMPLE : public TICKMON {
+	AXIMON		m_mon;
+	CData		*m_sink_tvalid, *m_sink_tready,
+			*m_src_tvalid,  *m_src_tready;
+	FILE		*m_fp;
+	unsigned long	m_period, m_start, m_clk;
+	bool		m_started;
+
+	// Running totals, and the totals as of the last sample
+	enum { SINK = 0, SRC, MM2S_RD, S2MM_WR, DMA_RD, DMA_WR, RAM_RD,
+		RAM_WR, NCOLUMNS };
+	unsigned long	m_total[NCOLUMNS], m_last[NCOLUMNS];
+
+	void	totals(void) {
+		// {{{
+		m_total[MM2S_RD]  = m_mon.m_master[AXIMON::MM2S].m_rd.m_beats;
+		m_total[S2MM_WR]  = m_mon.m_master[AXIMON::S2MM].m_wr.m_beats;
+		m_total[DMA_RD]   = m_mon.m_master[AXIMON::DMA].m_rd.m_beats;
+		m_total[DMA_WR]   = m_mon.m_master[AXIMON::DMA].m_wr.m_beats;
+		m_total[RAM_RD] = m_total[RAM_WR] = 0;
+		for(int k=0; k<8; k++) {
+			m_total[RAM_RD] += m_mon.m_ram_rbeats[k];
+			m_total[RAM_WR] += m_mon.m_ram_wbeats[k];
+		}
+	}
+	// }}}
+
+	void	sample(unsigned long clk) {
+		// {{{
+		totals();
+		fprintf(m_fp, "%lu", clk);
+		for(int k=0; k<NCOLUMNS; k++) {
+			fprintf(m_fp, ",%lu", m_total[k] - m_last[k]);
+			m_last[k] = m_total[k];
+		}
+		fprintf(m_fp, "\n");
+	}
+	// }}}
+public:
+	AXISAMPLE(Vmain *core, FILE *fp, unsigned long period)
+			: m_mon(core) {
+		// {{{
+		m_sink_tvalid = &core->VVAR(_streamsink_tvalid);
+		m_sink_tready = &core->VVAR(_streamsink_tready);
+		m_src_tvalid  = &core->VVAR(_streamsrc_tvalid);
+		m_src_tready  = &core->VVAR(_streamsrc_tready);
+
+		m_fp = fp;
+		m_period = (period > 0) ? period : 1;
+		m_start = m_clk = 0;
+		m_started = false;
+		for(int k=0; k<NCOLUMNS; k++)
+			m_total[k] = m_last[k] = 0;
+
+		fprintf(m_fp, "# Beats per %lu clocks\n", m_period);
+		fprintf(m_fp, "clock,sink,source,mm2s_rd,s2mm_wr,dma_rd,dma_wr,ram_rd,ram_wr\n");
+	}
+	// }}}
+
+	// Writes out whatever is left of the last period
+	~AXISAMPLE(void) {
+		if (m_started && m_clk > m_start)
+			sample(m_clk);
+	}
+
+	// Labels the time series at the current clock
+	void	mark(const char *label) {
+		fprintf(m_fp, "# %lu %s\n", m_clk, label);
+	}
+
+	virtual	void	tick(unsigned long clk) {
+		// {{{
+		m_mon.tick(clk);
+
+		if (*m_sink_tvalid && *m_sink_tready)
+			m_total[SINK]++;
+		if (*m_src_tvalid && *m_src_tready)
+			m_total[SRC]++;
+
+		m_clk = clk;
+		if (!m_started) {
+			m_started = true;
+			m_start = clk;
+		} else if (clk - m_start >= m_period) {
+			sample(clk);
+			m_start = clk;
+		}
+	}
+	// }}}
+};
+#endif	// AXISAMPLE_H
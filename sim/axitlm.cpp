@@ -0,0 +1,591 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/axitlm.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A transaction level model of the design, behind the DEVBUS
+//		interface.  See axitlm.h for a description.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "axitlm.h"
+
+// MM2S and S2MM control register bits
+// {{{
+#define	CTRL_BUSY		0x80000000
+#define	CTRL_ERR		0x40000000
+#define	CTRL_COMPLETE		0x20000000
+#define	CTRL_CONTINUOUS		0x10000000
+#define	CTRL_NOINC		0x08000000
+#define	CTRL_ERRCODE(C)		(((C)&7)<<23)
+#define	CTRL_LGFIFO(L)		(((L)&0x1f)<<16)
+#define	MM2S_ABORT_KEY		0x6d
+#define	S2MM_ABORT_KEY		0x26
+#define	LGFIFO			9
+// Error codes, as found in CTRL_ERRCODE
+#define	ERR_BUS			1
+// }}}
+
+// AXI DMA control register bits
+// {{{
+#define	DMA_BUSY		0x01	// Write a 1 to start
+#define	DMA_INT			0x02	// Write a 1 to clear
+#define	DMA_INTEN		0x04
+#define	DMA_ABORTED		0x08
+#define	DMA_ERR			0x10	// Write a 1 to clear
+#define	DMA_ABORT_KEY		0x6d	// Written to bits [15:8]
+// }}}
+
+// C_AXI_ADDR_WIDTH, as in rtl/main.v, which also sets the width of the length
+// registers
+#define	LGLEN			25
+
+// The control bus, as a 256 byte region
+#define	CTRLBUS(A)		(((A) & ~0x0ff) == (R_STREAMSINK_BEATS & ~0x0ff))
+
+AXITLM::AXITLM(unsigned busbytes) {
+	// {{{
+	m_ram = new uint8_t[RAMSIZE];
+	memset(m_ram, 0, RAMSIZE);
+
+	m_busbytes = (busbytes >= 4) ? busbytes : 4;
+	m_step     = 4096;
+	m_lenmask  = ((1ull << LGLEN)-1) & ~(uint64_t)(m_busbytes-1);
+
+	memset(&m_mm2s, 0, sizeof(m_mm2s));
+	memset(&m_s2mm, 0, sizeof(m_s2mm));
+	memset(&m_dma,  0, sizeof(m_dma));
+	memset(&m_sink, 0, sizeof(m_sink));
+	memset(&m_src,  0, sizeof(m_src));
+
+	m_interrupt = false;
+	m_buserr    = false;
+	m_accesses  = 0;
+}
+// }}}
+
+AXITLM::~AXITLM(void) {
+	delete[] m_ram;
+}
+
+uint8_t	*AXITLM::ram(uint64_t addr, uint64_t len) {
+	// {{{
+	if (addr < R_AXIRAM || addr + len > (uint64_t)R_AXIRAM + RAMSIZE)
+		return NULL;
+	return &m_ram[addr - R_AXIRAM];
+}
+// }}}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Copy engines
+// {{{
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+
+void	AXITLM::step(void) {
+	// {{{
+	if (m_mm2s.m_busy)
+		mm2s_step();
+	if (m_s2mm.m_busy)
+		s2mm_step();
+	if (m_dma.m_busy)
+		dma_step();
+}
+// }}}
+
+void	AXITLM::finish(STREAMDMA &d) {
+	// {{{
+	d.m_busy     = false;
+	d.m_complete = true;
+	// In continuous mode, the next transfer picks up where this one
+	// left off.  Otherwise, the address returns to where it started.
+	if (d.m_continuous && !d.m_err)
+		d.m_addr = d.m_cur;
+	m_interrupt = true;
+}
+// }}}
+
+void	AXITLM::mm2s_step(void) {
+	// {{{
+	STREAMDMA	&d = m_mm2s;
+	uint64_t	n = (d.m_left < m_step) ? d.m_left : m_step;
+	uint8_t		*p = ram(d.m_cur, (d.m_noinc) ? m_busbytes : n);
+
+	if (p == NULL) {
+		d.m_err = true;
+		d.m_errcode = ERR_BUS;
+		finish(d);
+		return;
+	}
+
+	for(uint64_t k=0; k<n; k += m_busbytes) {
+		uint32_t	data;
+
+		memcpy(&data, (d.m_noinc) ? p : p+k, sizeof(data));
+
+		// Every beat goes straight into the sink, which never stalls
+		m_sink.m_beats++;
+		if (!m_sink.m_counting && data == 0)
+			m_sink.m_counting = true;
+		if (m_sink.m_counting)
+			m_sink.m_clocks++;
+		if (m_sink.m_beats > 1)
+			m_sink.m_hist0++;
+		if (k + m_busbytes >= d.m_left && !d.m_continuous)
+			m_sink.m_packets++;
+	}
+
+	if (!d.m_noinc)
+		d.m_cur += n;
+	d.m_left -= n;
+	if (d.m_left == 0)
+		finish(d);
+}
+// }}}
+
+void	AXITLM::s2mm_step(void) {
+	// {{{
+	STREAMDMA	&d = m_s2mm;
+	uint64_t	n = (d.m_left < m_step) ? d.m_left : m_step;
+	uint8_t		*p = ram(d.m_cur, (d.m_noinc) ? m_busbytes : n);
+	unsigned	lanes = m_busbytes / 4;
+
+	if (p == NULL) {
+		d.m_err = true;
+		d.m_errcode = ERR_BUS;
+		finish(d);
+		return;
+	}
+
+	for(uint64_t k=0; k<n; k += m_busbytes) {
+		uint8_t	*beat = (d.m_noinc) ? p : p+k;
+
+		// The source's data is a counter, one value per 32-bit lane
+		for(unsigned ik=0; ik<lanes; ik++) {
+			uint32_t	data = m_src.m_counter + ik;
+
+			memcpy(&beat[4*ik], &data, sizeof(data));
+		}
+		m_src.m_counter += lanes;
+
+		m_src.m_beats++;
+		if (m_src.m_pktlen <= 1 || ++m_src.m_pktbeat >= m_src.m_pktlen) {
+			m_src.m_packets++;
+			m_src.m_pktbeat = 0;
+		}
+	}
+
+	if (!d.m_noinc)
+		d.m_cur += n;
+	d.m_left -= n;
+	if (d.m_left == 0)
+		finish(d);
+}
+// }}}
+
+void	AXITLM::dma_step(void) {
+	// {{{
+	MEMDMA		&d = m_dma;
+	uint64_t	n = (d.m_left < m_step) ? d.m_left : m_step;
+	uint8_t		*src = ram(d.m_cursrc, n), *dst = ram(d.m_curdst, n);
+
+	if (src == NULL || dst == NULL) {
+		d.m_err = true;
+		n = d.m_left;
+	} else {
+		// Any alignment, and any overlap
+		memmove(dst, src, n);
+		d.m_cursrc += n;
+		d.m_curdst += n;
+	}
+
+	d.m_left -= n;
+	if (d.m_left == 0) {
+		d.m_busy = false;
+		d.m_int  = true;
+		if (d.m_inten)
+			m_interrupt = true;
+	}
+}
+// }}}
+// }}}
+////////////////////////////////////////////////////////////////////////////////
+//
+// Control registers
+// {{{
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+
+uint32_t	AXITLM::streamctrl(const STREAMDMA &d) const {
+	// {{{
+	return	((d.m_busy)       ? CTRL_BUSY       : 0)
+		| ((d.m_err)        ? CTRL_ERR        : 0)
+		| ((d.m_complete)   ? CTRL_COMPLETE   : 0)
+		| ((d.m_continuous) ? CTRL_CONTINUOUS : 0)
+		| ((d.m_noinc)      ? CTRL_NOINC      : 0)
+		| CTRL_ERRCODE(d.m_errcode) | CTRL_LGFIFO(LGFIFO);
+}
+// }}}
+
+void	AXITLM::streamctrl(STREAMDMA &d, uint32_t v, unsigned key) {
+	// {{{
+	if (d.m_busy) {
+		// Only the abort key means anything while busy
+		if ((v >> 24) == key) {
+			d.m_err = true;
+			finish(d);
+		}
+		return;
+	}
+
+	if (v & CTRL_ERR) {
+		d.m_err = false;
+		d.m_errcode = 0;
+	} if (v & CTRL_COMPLETE)
+		d.m_complete = false;
+	d.m_continuous = (v & CTRL_CONTINUOUS) != 0;
+	d.m_noinc      = (v & CTRL_NOINC) != 0;
+
+	// New transfers wait until any error has been cleared
+	if ((v & CTRL_BUSY) && !d.m_err && d.m_len > 0) {
+		d.m_busy     = true;
+		d.m_complete = false;
+		d.m_cur      = d.m_addr;
+		d.m_left     = d.m_len;
+	}
+}
+// }}}
+
+uint32_t	AXITLM::dmactrl(void) const {
+	// {{{
+	return	((m_dma.m_busy)  ? DMA_BUSY    : 0)
+		| ((m_dma.m_int)   ? DMA_INT     : 0)
+		| ((m_dma.m_inten) ? DMA_INTEN   : 0)
+		| ((m_dma.m_abort) ? DMA_ABORTED : 0)
+		| ((m_dma.m_err)   ? DMA_ERR     : 0);
+}
+// }}}
+
+void	AXITLM::dmactrl(uint32_t v) {
+	// {{{
+	MEMDMA	&d = m_dma;
+
+	if (d.m_busy) {
+		if (((v >> 8) & 0x0ff) == DMA_ABORT_KEY) {
+			d.m_busy  = false;
+			d.m_abort = true;
+			d.m_int   = true;
+			if (d.m_inten)
+				m_interrupt = true;
+		}
+		return;
+	}
+
+	if (v & DMA_ERR)
+		d.m_err = false;
+	if (v & DMA_INT)
+		d.m_int = false;
+	d.m_inten = (v & DMA_INTEN) != 0;
+
+	if ((v & DMA_BUSY) && !d.m_err && d.m_len > 0) {
+		d.m_busy   = true;
+		d.m_abort  = false;
+		d.m_cursrc = d.m_src;
+		d.m_curdst = d.m_dst;
+		d.m_left   = d.m_len;
+	}
+}
+// }}}
+
+void	AXITLM::sinkwrite(unsigned reg, uint32_t v) {
+	// {{{
+	switch(reg) {
+	case 4: m_sink.m_bpctrl = v; break;
+	case 5: m_sink.m_bparg  = v; break;
+	case 6: m_sink.m_bpseed = v; break;
+	case 7: m_sink.m_bptrace++; break;
+	default:
+		// Any other write clears the counters and statistics
+		m_sink.m_beats = m_sink.m_packets = m_sink.m_clocks = 0;
+		m_sink.m_hist0 = 0;
+		m_sink.m_counting = false;
+		break;
+	}
+}
+// }}}
+
+void	AXITLM::srcwrite(unsigned reg, uint32_t v) {
+	// {{{
+	switch(reg) {
+	case 0: m_src.m_rate   = v; break;
+	case 1: m_src.m_burst  = v; break;
+	case 2: m_src.m_pktlen = v; break;
+	case 3: m_src.m_counter = 0; break;
+	default:
+		m_src.m_beats = m_src.m_packets = 0;
+		break;
+	}
+
+	// Writes to any of the first four restart the packet pattern
+	if (reg < 4)
+		m_src.m_pktbeat = 0;
+}
+// }}}
+// }}}
+////////////////////////////////////////////////////////////////////////////////
+//
+// DEVBUS interface
+// {{{
+////////////////////////////////////////////////////////////////////////////////
+//
+//
+
+void	AXITLM::writeio(const BUSA a, const BUSW v) {
+	// {{{
+	uint8_t	*p;
+
+	if (NULL != (p = ram(a & -4, 4))) {
+		memcpy(p, &v, sizeof(v));
+	} else switch(a & -4) {
+	// AXI DMA
+	case R_AXIDMACTRL:	dmactrl(v); break;
+	case R_AXIDMASRCLO:	if (!m_dma.m_busy)
+			m_dma.m_src = (m_dma.m_src & ~0x0ffffffffull) | v;
+		break;
+	case R_AXIDMASRCHI:	if (!m_dma.m_busy)
+			m_dma.m_src = (m_dma.m_src & 0x0ffffffffull)
+					| ((uint64_t)v << 32);
+		break;
+	case R_AXIDMADSTLO:	if (!m_dma.m_busy)
+			m_dma.m_dst = (m_dma.m_dst & ~0x0ffffffffull) | v;
+		break;
+	case R_AXIDMADSTHI:	if (!m_dma.m_busy)
+			m_dma.m_dst = (m_dma.m_dst & 0x0ffffffffull)
+					| ((uint64_t)v << 32);
+		break;
+	case R_AXIDMALENLO:	if (!m_dma.m_busy)
+			m_dma.m_len = ((m_dma.m_len & ~0x0ffffffffull) | v)
+					& ((1ull << LGLEN)-1);
+		break;
+	case R_AXIDMALENHI:	if (!m_dma.m_busy)
+			m_dma.m_len = ((m_dma.m_len & 0x0ffffffffull)
+					| ((uint64_t)v << 32))
+					& ((1ull << LGLEN)-1);
+		break;
+	//
+	// MM2S, which only accepts aligned addresses
+	case R_MM2SCTRL:	streamctrl(m_mm2s, v, MM2S_ABORT_KEY); break;
+	case R_MM2SADDRLO:	if (!m_mm2s.m_busy)
+			m_mm2s.m_addr = ((m_mm2s.m_addr & ~0x0ffffffffull) | v)
+					& -(uint64_t)m_busbytes;
+		break;
+	case R_MM2SADDRHI:	if (!m_mm2s.m_busy)
+			m_mm2s.m_addr = (m_mm2s.m_addr & 0x0ffffffffull)
+					| ((uint64_t)v << 32);
+		break;
+	case R_MM2SLENLO:	if (!m_mm2s.m_busy)
+			m_mm2s.m_len = ((m_mm2s.m_len & ~0x0ffffffffull) | v)
+					& m_lenmask;
+		break;
+	case R_MM2SLENHI:	if (!m_mm2s.m_busy)
+			m_mm2s.m_len = ((m_mm2s.m_len & 0x0ffffffffull)
+					| ((uint64_t)v << 32)) & m_lenmask;
+		break;
+	//
+	// S2MM
+	case R_S2MMCTRL:	streamctrl(m_s2mm, v, S2MM_ABORT_KEY); break;
+	case R_S2MMADDRLO:	if (!m_s2mm.m_busy)
+			m_s2mm.m_addr = ((m_s2mm.m_addr & ~0x0ffffffffull) | v)
+					& -(uint64_t)m_busbytes;
+		break;
+	case R_S2MMADDRHI:	if (!m_s2mm.m_busy)
+			m_s2mm.m_addr = (m_s2mm.m_addr & 0x0ffffffffull)
+					| ((uint64_t)v << 32);
+		break;
+	case R_S2MMLENLO:	if (!m_s2mm.m_busy)
+			m_s2mm.m_len = ((m_s2mm.m_len & ~0x0ffffffffull) | v)
+					& m_lenmask;
+		break;
+	case R_S2MMLENHI:	if (!m_s2mm.m_busy)
+			m_s2mm.m_len = ((m_s2mm.m_len & 0x0ffffffffull)
+					| ((uint64_t)v << 32)) & m_lenmask;
+		break;
+	default:
+		if (a >= R_STREAMSINK_BEATS && a <= R_STREAMSINK_HIST4)
+			sinkwrite((a - R_STREAMSINK_BEATS) >> 2, v);
+		else if (a >= R_STREAMSRC_RATE && a <= R_STREAMSRC_STALLS)
+			srcwrite((a - R_STREAMSRC_RATE) >> 2, v);
+		else if (!CTRLBUS(a))
+			m_buserr = true;
+		break;
+	}
+
+	m_accesses++;
+	step();
+}
+// }}}
+
+DEVBUS::BUSW	AXITLM::readio(const BUSA a) {
+	// {{{
+	BUSW	v = 0;
+	uint8_t	*p;
+
+	if (NULL != (p = ram(a & -4, 4))) {
+		memcpy(&v, p, sizeof(v));
+	} else switch(a & -4) {
+	// AXI DMA
+	case R_AXIDMACTRL:	v = dmactrl(); break;
+	case R_AXIDMASRCLO:
+		v = (BUSW)((m_dma.m_busy) ? m_dma.m_cursrc : m_dma.m_src);
+		break;
+	case R_AXIDMASRCHI:
+		v = (BUSW)(((m_dma.m_busy) ? m_dma.m_cursrc : m_dma.m_src)>>32);
+		break;
+	case R_AXIDMADSTLO:
+		v = (BUSW)((m_dma.m_busy) ? m_dma.m_curdst : m_dma.m_dst);
+		break;
+	case R_AXIDMADSTHI:
+		v = (BUSW)(((m_dma.m_busy) ? m_dma.m_curdst : m_dma.m_dst)>>32);
+		break;
+	case R_AXIDMALENLO:
+		v = (BUSW)((m_dma.m_busy) ? m_dma.m_left : m_dma.m_len);
+		break;
+	case R_AXIDMALENHI:
+		v = (BUSW)(((m_dma.m_busy) ? m_dma.m_left : m_dma.m_len)>>32);
+		break;
+	//
+	// MM2S.  While busy, the address and length registers return the
+	// current address, and the number of bytes left to go
+	case R_MM2SCTRL:	v = streamctrl(m_mm2s); break;
+	case R_MM2SADDRLO:
+		v = (BUSW)((m_mm2s.m_busy) ? m_mm2s.m_cur : m_mm2s.m_addr);
+		break;
+	case R_MM2SADDRHI:
+		v = (BUSW)(((m_mm2s.m_busy) ? m_mm2s.m_cur : m_mm2s.m_addr)>>32);
+		break;
+	case R_MM2SLENLO:
+		v = (BUSW)((m_mm2s.m_busy) ? m_mm2s.m_left : m_mm2s.m_len);
+		break;
+	case R_MM2SLENHI:
+		v = (BUSW)(((m_mm2s.m_busy) ? m_mm2s.m_left : m_mm2s.m_len)>>32);
+		break;
+	//
+	// S2MM
+	case R_S2MMCTRL:	v = streamctrl(m_s2mm); break;
+	case R_S2MMADDRLO:
+		v = (BUSW)((m_s2mm.m_busy) ? m_s2mm.m_cur : m_s2mm.m_addr);
+		break;
+	case R_S2MMADDRHI:
+		v = (BUSW)(((m_s2mm.m_busy) ? m_s2mm.m_cur : m_s2mm.m_addr)>>32);
+		break;
+	case R_S2MMLENLO:
+		v = (BUSW)((m_s2mm.m_busy) ? m_s2mm.m_left : m_s2mm.m_len);
+		break;
+	case R_S2MMLENHI:
+		v = (BUSW)(((m_s2mm.m_busy) ? m_s2mm.m_left : m_s2mm.m_len)>>32);
+		break;
+	//
+	// Stream sink.  The stream is ideal, so there are never any gaps
+	// between beats, nor any stalls.
+	case R_STREAMSINK_BEATS:	v = m_sink.m_beats; break;
+	case R_STREAMSINK_PACKETS:	v = m_sink.m_packets; break;
+	case R_STREAMSINK_CLOCKS:	v = m_sink.m_clocks; break;
+	case R_STREAMSINK_BPCTRL:	v = m_sink.m_bpctrl; break;
+	case R_STREAMSINK_BPARG:	v = m_sink.m_bparg; break;
+	case R_STREAMSINK_BPSEED:	v = m_sink.m_bpseed; break;
+	case R_STREAMSINK_BPTRACE:	v = m_sink.m_bptrace; break;
+	case R_STREAMSINK_HIST0:	v = m_sink.m_hist0; break;
+	//
+	// Stream source
+	case R_STREAMSRC_RATE:		v = m_src.m_rate; break;
+	case R_STREAMSRC_BURST:		v = m_src.m_burst; break;
+	case R_STREAMSRC_PKTLEN:	v = m_src.m_pktlen; break;
+	case R_STREAMSRC_BEATS:		v = m_src.m_beats; break;
+	case R_STREAMSRC_PACKETS:	v = m_src.m_packets; break;
+	default:
+		if (!CTRLBUS(a))
+			m_buserr = true;
+		break;
+	}
+
+	m_accesses++;
+	step();
+	return v;
+}
+// }}}
+
+void	AXITLM::readi(const BUSA a, const int len, BUSW *buf) {
+	for(int k=0; k<len; k++)
+		buf[k] = readio(a + 4*k);
+}
+
+void	AXITLM::readz(const BUSA a, const int len, BUSW *buf) {
+	for(int k=0; k<len; k++)
+		buf[k] = readio(a);
+}
+
+void	AXITLM::writei(const BUSA a, const int len, const BUSW *buf) {
+	for(int k=0; k<len; k++)
+		writeio(a + 4*k, buf[k]);
+}
+
+void	AXITLM::writez(const BUSA a, const int len, const BUSW *buf) {
+	for(int k=0; k<len; k++)
+		writeio(a, buf[k]);
+}
+
+void	AXITLM::usleep(unsigned msec) {
+	// {{{
+	// Without a clock, each millisecond is taken to be 100 steps
+	for(unsigned long k=0; k < 100ul * msec && !m_interrupt; k++) {
+		if (!m_mm2s.m_busy && !m_s2mm.m_busy && !m_dma.m_busy)
+			break;
+		step();
+	}
+}
+// }}}
+
+void	AXITLM::wait(void) {
+	// {{{
+	// Nothing can interrupt once every engine is idle
+	while(!m_interrupt
+		&& (m_mm2s.m_busy || m_s2mm.m_busy || m_dma.m_busy))
+		step();
+}
+// }}}
+// }}}
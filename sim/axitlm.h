@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/axitlm.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A transaction level model of the design, behind the same DEVBUS
+//		interface as the Verilated model (AXI_TB).  Host software,
+//	drivers and test scenarios, can then be developed against this model
+//	at many times the speed of the clock by clock simulation, and then
+//	re-run, unchanged, against AXI_TB for timing.
+//
+//	The model includes the AXI RAM, and the register maps and copy
+//	semantics of the AXI DMA, the MM2S, the S2MM, the stream sink
+//	(rtl/streamcounter.v), and the stream source (rtl/streamsource.v).
+//	This includes the BUSY, ERR, and COMPLETE bits, continuous mode, the
+//	abort keys, and the interrupts.  Registers belonging to anything else
+//	on the control bus read as zero.  Accesses outside of the control bus
+//	and the RAM return a bus error.
+//
+//	There are no clocks.  Instead, every bus access lets each busy engine
+//	move up to one step of data, 4kB by default.  A transfer therefore
+//	stays BUSY across several accesses, so that software polling BUSY,
+//	or aborting a transfer midway, behaves as it does on the hardware.
+//	All streams are ideal: the sink never stalls, and the source always
+//	has data.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	AXITLM_H
+#define	AXITLM_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "devbus.h"
+#include "regdefs.h"
+
+class	AXITLM : public DEVBUS {
+public:
+	// MM2S or S2MM
+	typedef	struct {
+		uint64_t	m_addr, m_len;	// As last written
+		uint64_t	m_cur, m_left;	// While busy
+		bool		m_busy, m_err, m_complete, m_continuous,
+				m_noinc;
+		unsigned	m_errcode;
+	} STREAMDMA;
+
+	// The memory to memory DMA
+	typedef	struct {
+		uint64_t	m_src, m_dst, m_len;
+		uint64_t	m_cursrc, m_curdst, m_left;
+		bool		m_busy, m_err, m_abort, m_int, m_inten;
+	} MEMDMA;
+
+	// Stream sink, rtl/streamcounter.v
+	typedef	struct {
+		uint32_t	m_beats, m_packets, m_clocks, m_hist0;
+		uint32_t	m_bpctrl, m_bparg, m_bpseed, m_bptrace;
+		bool		m_counting;
+	} SINK;
+
+	// Stream source, rtl/streamsource.v
+	typedef	struct {
+		uint32_t	m_rate, m_burst, m_pktlen, m_counter, m_pktbeat;
+		uint32_t	m_beats, m_packets;
+	} SOURCE;
+
+private:
+	uint8_t		*m_ram;
+	unsigned	m_busbytes, m_step;
+	uint64_t	m_lenmask;
+	STREAMDMA	m_mm2s, m_s2mm;
+	MEMDMA		m_dma;
+	SINK		m_sink;
+	SOURCE		m_src;
+	bool		m_interrupt, m_buserr;
+	unsigned long	m_accesses;
+
+	uint8_t		*ram(uint64_t addr, uint64_t len);
+	void	step(void);
+	void	mm2s_step(void);
+	void	s2mm_step(void);
+	void	dma_step(void);
+	void	finish(STREAMDMA &d);
+
+	uint32_t	streamctrl(const STREAMDMA &d) const;
+	void	streamctrl(STREAMDMA &d, uint32_t v, unsigned key);
+	uint32_t	dmactrl(void) const;
+	void	dmactrl(uint32_t v);
+	void	sinkwrite(unsigned reg, uint32_t v);
+	void	srcwrite(unsigned reg, uint32_t v);
+public:
+	AXITLM(unsigned busbytes = AXIBUS_WIDTH/8);
+	~AXITLM(void);
+
+	// The number of bytes each engine may move per bus access
+	void	setstep(unsigned bytes) { m_step = (bytes > 0) ? bytes : 1; }
+	// The number of bus accesses so far, as a (rough) measure of time
+	unsigned long	accesses(void) const { return m_accesses; }
+
+	// A direct pointer into the RAM, for checking results
+	uint32_t	*words(void) { return (uint32_t *)m_ram; }
+
+	void	kill(void) {}
+	void	close(void) {}
+
+	void	writeio(const BUSA a, const BUSW v);
+	BUSW	readio(const BUSA a);
+	void	readi(const BUSA a, const int len, BUSW *buf);
+	void	readz(const BUSA a, const int len, BUSW *buf);
+	void	writei(const BUSA a, const int len, const BUSW *buf);
+	void	writez(const BUSA a, const int len, const BUSW *buf);
+
+	bool	poll(void) { return m_interrupt; }
+	void	usleep(unsigned msec);
+	void	wait(void);
+	bool	bus_err(void) const { return m_buserr; }
+	void	reset_err(void) { m_buserr = false; }
+	void	clear(void) { m_interrupt = false; }
+};
+
+#endif	// AXITLM_H
@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/axitrace.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Records the AXI traffic through each port of the crossbar,
+//		clock by clock, as a Chrome trace-event (JSON) file.  Such a
+//	file may be opened with chrome://tracing or https://ui.perfetto.dev.
+//
+//	Each port (the host, the MM2S, S2MM, and DMA masters, and the AXI RAM
+//	and control bus slaves) is drawn as its own process, with one track
+//	per AXI channel.  Each burst becomes one slice:
+//
+//	- AR and AW slices run from xVALID to the address handshake.  Their
+//		length is how long the request waited.
+//	- R and W slices run from the first data beat to the last.
+//	- B slices mark each write response.
+//
+//	Flow arrows connect each AR to its R burst, and each AW to its B
+//	response.  Times are given in clocks, so "1us" in the viewer is one
+//	clock.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	AXITRACE_H
+#define	AXITRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <deque>
+
+#include "aximon.h"
+
+//
+// AXIADDR
+// {{{
+// An address from the Verilated model, whether it fits in 32-bits or not
+class	AXIADDR {
+	IData	*m_w;
+	QData	*m_q;
+public:
+	AXIADDR(void) : m_w(NULL), m_q(NULL) {}
+	void	bind(IData *a) { m_w = a; m_q = NULL; }
+	void	bind(QData *a) { m_q = a; m_w = NULL; }
+	uint64_t	get(void) const {
+		return (m_q) ? (uint64_t)*m_q : (m_w) ? (uint64_t)*m_w : 0;
+	}
+};
+// }}}
+
+//
+// AXITRACE
+// {{{
+class	AXITRACE : public TICKMON {
+public:
+	enum { P_HOST = 0, P_MM2S, P_S2MM, P_DMA, P_AXIRAM, P_CTRL, P_AXIRAM2,
+		NPORTS };
+	enum { TRACK_AR = 1, TRACK_R, TRACK_AW, TRACK_W, TRACK_B };
+
+	typedef	struct {
+		uint64_t	m_addr;
+		unsigned	m_id, m_len, m_flow;
+		unsigned long	m_start;
+	} BURST;
+
+	typedef	struct {
+		CData	*arvalid, *arready, *arid, *arlen,
+			*rvalid, *rready, *rid, *rlast,
+			*awvalid, *awready, *awid, *awlen,
+			*wvalid, *wready, *wlast,
+			*bvalid, *bready, *bid;
+		AXIADDR	araddr, awaddr;
+
+		// Request state
+		bool		m_arwait, m_awwait;
+		unsigned long	m_arstart, m_awstart, m_wstart;
+		unsigned	m_wbeats, m_wahead;
+		std::deque<BURST>	m_rd[8], m_bq[8];
+		// Write data, with no ID, follows the order of the AWs
+		std::deque<BURST>	m_wq;
+	} PORT;
+
+private:
+	PORT		m_port[NPORTS];
+	FILE		*m_fp;
+	unsigned long	m_events;
+	unsigned	m_flow;
+
+	void	event(const char *fmt, ...)
+			__attribute__((format(printf, 2, 3)));
+	void	slice(int pid, int tid, const char *name,
+			unsigned long ts, unsigned long dur,
+			const BURST *b, unsigned beats);
+	void	flow(int pid, int tid, bool start, unsigned id,
+			unsigned long ts);
+	void	tickport(int pid, PORT &p, unsigned long clk);
+public:
+	AXITRACE(Vmain *core, FILE *fp);
+	~AXITRACE(void);
+
+	virtual	void	tick(unsigned long clk) {
+		for(int k=0; k<NPORTS; k++)
+			tickport(k, m_port[k], clk);
+	}
+};
+// }}}
+
+#define	AXITRACE_BIND(PT, P)	do {					\
+	(PT).arvalid = &core->VVAR(_axi_ ## P ## _arvalid);		\
+	(PT).arready = &core->VVAR(_axi_ ## P ## _arready);		\
+	(PT).arid    = &core->VVAR(_axi_ ## P ## _arid);		\
+	(PT).arlen   = &core->VVAR(_axi_ ## P ## _arlen);		\
+	(PT).araddr.bind(&core->VVAR(_axi_ ## P ## _araddr));		\
+	(PT).rvalid  = &core->VVAR(_axi_ ## P ## _rvalid);		\
+	(PT).rready  = &core->VVAR(_axi_ ## P ## _rready);		\
+	(PT).rid     = &core->VVAR(_axi_ ## P ## _rid);			\
+	(PT).rlast   = &core->VVAR(_axi_ ## P ## _rlast);		\
+	(PT).awvalid = &core->VVAR(_axi_ ## P ## _awvalid);		\
+	(PT).awready = &core->VVAR(_axi_ ## P ## _awready);		\
+	(PT).awid    = &core->VVAR(_axi_ ## P ## _awid);		\
+	(PT).awlen   = &core->VVAR(_axi_ ## P ## _awlen);		\
+	(PT).awaddr.bind(&core->VVAR(_axi_ ## P ## _awaddr));		\
+	(PT).wvalid  = &core->VVAR(_axi_ ## P ## _wvalid);		\
+	(PT).wready  = &core->VVAR(_axi_ ## P ## _wready);		\
+	(PT).wlast   = &core->VVAR(_axi_ ## P ## _wlast);		\
+	(PT).bvalid  = &core->VVAR(_axi_ ## P ## _bvalid);		\
+	(PT).bready  = &core->VVAR(_axi_ ## P ## _bready);		\
+	(PT).bid     = &core->VVAR(_axi_ ## P ## _bid);			\
+	} while(0)
+
+inline	AXITRACE::AXITRACE(Vmain *core, FILE *fp) {
+	// {{{
+	static const char *const	pname[NPORTS] = {
+			"Host", "MM2S", "S2MM", "DMA", "AXI RAM", "Control bus",
+			"AXI RAM 2" },
+				*tname[] = { "", "AR", "R", "AW", "W", "B" };
+
+	AXITRACE_BIND(m_port[P_HOST],   wbu);
+	AXITRACE_BIND(m_port[P_MM2S],   mm2s);
+	AXITRACE_BIND(m_port[P_S2MM],   s2mm);
+	AXITRACE_BIND(m_port[P_DMA],    dma);
+	AXITRACE_BIND(m_port[P_AXIRAM], axiram);
+	AXITRACE_BIND(m_port[P_CTRL],   controlbus);
+	AXITRACE_BIND(m_port[P_AXIRAM2], axiram2);
+
+	for(int k=0; k<NPORTS; k++) {
+		m_port[k].m_arwait = m_port[k].m_awwait = false;
+		m_port[k].m_arstart = m_port[k].m_awstart = 0;
+		m_port[k].m_wstart = 0;
+		m_port[k].m_wbeats = m_port[k].m_wahead = 0;
+	}
+
+	m_fp = fp;
+	m_events = 0;
+	m_flow = 0;
+
+	fprintf(m_fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	for(int k=0; k<NPORTS; k++) {
+		event("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+			"\"args\":{\"name\":\"%s\"}}", k+1, pname[k]);
+		event("{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":%d,"
+			"\"args\":{\"sort_index\":%d}}", k+1, k);
+		for(int t=TRACK_AR; t<=TRACK_B; t++)
+			event("{\"name\":\"thread_name\",\"ph\":\"M\","
+				"\"pid\":%d,\"tid\":%d,"
+				"\"args\":{\"name\":\"%s\"}}", k+1, t, tname[t]);
+	}
+}
+// }}}
+
+inline	AXITRACE::~AXITRACE(void) {
+	fprintf(m_fp, "\n]}\n");
+}
+
+inline	void	AXITRACE::event(const char *fmt, ...) {
+	// {{{
+	va_list	args;
+
+	if (m_events++ > 0)
+		fprintf(m_fp, ",\n");
+	va_start(args, fmt);
+	vfprintf(m_fp, fmt, args);
+	va_end(args);
+}
+// }}}
+
+inline	void	AXITRACE::slice(int pid, int tid, const char *name,
+		unsigned long ts, unsigned long dur,
+		const BURST *b, unsigned beats) {
+	// {{{
+	if (b)
+		event("{\"name\":\"%s %u\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+			"\"ts\":%lu,\"dur\":%lu,\"args\":{\"id\":%u,"
+			"\"addr\":\"0x%08llx\",\"len\":%u,\"beats\":%u}}",
+			name, b->m_id, pid+1, tid, ts, dur, b->m_id,
+			(unsigned long long)b->m_addr, b->m_len+1, beats);
+	else
+		event("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,"
+			"\"ts\":%lu,\"dur\":%lu,\"args\":{\"beats\":%u}}",
+			name, pid+1, tid, ts, dur, beats);
+}
+// }}}
+
+inline	void	AXITRACE::flow(int pid, int tid, bool start, unsigned id,
+		unsigned long ts) {
+	// {{{
+	if (start)
+		event("{\"name\":\"burst\",\"cat\":\"axi\",\"ph\":\"s\","
+			"\"id\":%u,\"pid\":%d,\"tid\":%d,\"ts\":%lu}",
+			id, pid+1, tid, ts);
+	else	// Bind to the slice enclosing ts
+		event("{\"name\":\"burst\",\"cat\":\"axi\",\"ph\":\"f\","
+			"\"bp\":\"e\",\"id\":%u,\"pid\":%d,\"tid\":%d,"
+			"\"ts\":%lu}", id, pid+1, tid, ts);
+}
+// }}}
+
+inline	void	AXITRACE::tickport(int pid, PORT &p, unsigned long clk) {
+	// {{{
+	// Read address
+	// {{{
+	if (*p.arvalid) {
+		if (!p.m_arwait) {
+			p.m_arwait = true;
+			p.m_arstart = clk;
+		}
+
+		if (*p.arready) {
+			BURST	b;
+
+			b.m_addr  = p.araddr.get();
+			b.m_id    = *p.arid & 7;
+			b.m_len   = *p.arlen;
+			b.m_flow  = m_flow++;
+			b.m_start = 0;
+			slice(pid, TRACK_AR, "AR", p.m_arstart,
+				clk - p.m_arstart + 1, &b, 0);
+			flow(pid, TRACK_AR, true, b.m_flow, clk);
+			p.m_rd[b.m_id].push_back(b);
+			p.m_arwait = false;
+		}
+	}
+	// }}}
+
+	// Read data, in order within each ID
+	// {{{
+	if (*p.rvalid && *p.rready && !p.m_rd[*p.rid & 7].empty()) {
+		BURST	&b = p.m_rd[*p.rid & 7].front();
+
+		if (b.m_start == 0)
+			b.m_start = clk;
+		if (*p.rlast) {
+			slice(pid, TRACK_R, "R", b.m_start, clk - b.m_start + 1,
+				&b, b.m_len + 1);
+			flow(pid, TRACK_R, false, b.m_flow, b.m_start);
+			p.m_rd[*p.rid & 7].pop_front();
+		}
+	}
+	// }}}
+
+	// Write address
+	// {{{
+	if (*p.awvalid) {
+		if (!p.m_awwait) {
+			p.m_awwait = true;
+			p.m_awstart = clk;
+		}
+
+		if (*p.awready) {
+			BURST	b;
+
+			b.m_addr  = p.awaddr.get();
+			b.m_id    = *p.awid & 7;
+			b.m_len   = *p.awlen;
+			b.m_flow  = m_flow++;
+			b.m_start = 0;
+			slice(pid, TRACK_AW, "AW", p.m_awstart,
+				clk - p.m_awstart + 1, &b, 0);
+			flow(pid, TRACK_AW, true, b.m_flow, clk);
+			if (p.m_wahead > 0)
+				p.m_wahead--;
+			else
+				p.m_wq.push_back(b);
+			p.m_bq[b.m_id].push_back(b);
+			p.m_awwait = false;
+		}
+	}
+	// }}}
+
+	// Write data
+	// {{{
+	if (*p.wvalid && *p.wready) {
+		if (p.m_wbeats++ == 0)
+			p.m_wstart = clk;
+		if (*p.wlast) {
+			// The AW may not have arrived yet
+			if (!p.m_wq.empty()) {
+				slice(pid, TRACK_W, "W", p.m_wstart,
+					clk - p.m_wstart + 1, &p.m_wq.front(),
+					p.m_wbeats);
+				p.m_wq.pop_front();
+			} else {
+				slice(pid, TRACK_W, "W", p.m_wstart,
+					clk - p.m_wstart + 1, NULL, p.m_wbeats);
+				p.m_wahead++;
+			}
+			p.m_wbeats = 0;
+		}
+	}
+	// }}}
+
+	// Write response
+	// {{{
+	if (*p.bvalid && *p.bready && !p.m_bq[*p.bid & 7].empty()) {
+		BURST	&b = p.m_bq[*p.bid & 7].front();
+
+		slice(pid, TRACK_B, "B", clk, 1, &b, 0);
+		flow(pid, TRACK_B, false, b.m_flow, clk);
+		p.m_bq[*p.bid & 7].pop_front();
+	}
+	// }}}
+}
+// }}}
+#endif	// AXITRACE_H
@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/axiwatch.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A stall watchdog.  Watches every AXI channel of every port of
+//		the crossbar, counting how long each xVALID has been held
+//	without its xREADY, and keeping track of every burst each port has
+//	outstanding.  Should any channel stall, or any port with bursts
+//	outstanding go without a single xVALID, for more than a given number
+//	of clocks, the watchdog reports which channel is stuck, for how long,
+//	and the state of every burst still in flight.
+//
+//	This is the diagnosis that's missing when a test simply times out.
+//
+//	WATCHCOUNT is the default limit.  It's several times longer than the
+//	longest test, the 10% duty cycle backpressure sweeps at about 82k
+//	clocks each, so that nothing short of a real hang trips it.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	AXIWATCH_H
+#define	AXIWATCH_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <deque>
+
+#include "axitrace.h"
+
+// The default stall limit, in clocks
+const unsigned long	WATCHCOUNT = 1ul << 18;
+
+//
+// AXIWATCH
+// {{{
+class	AXIWATCH : public TICKMON {
+public:
+	enum { CH_AR = 0, CH_R, CH_AW, CH_W, CH_B, NCHAN };
+
+	typedef	struct {
+		uint64_t	m_addr;
+		unsigned	m_id, m_len, m_beats;
+		unsigned long	m_start;
+	} BURST;
+
+	typedef	struct {
+		CData	*arvalid, *arready, *arid, *arlen,
+			*rvalid, *rready, *rid, *rlast,
+			*awvalid, *awready, *awid, *awlen,
+			*wvalid, *wready, *wlast,
+			*bvalid, *bready, *bid;
+		AXIADDR	araddr, awaddr;
+
+		// Clocks each channel has been waiting on xREADY
+		unsigned long	m_stall[NCHAN], m_worst[NCHAN];
+		// Clocks with bursts outstanding, yet nothing VALID
+		unsigned long	m_idle;
+		// Bursts in flight, in the order they were requested
+		std::deque<BURST>	m_rd, m_wr;
+		// Write data that arrived before its AW
+		unsigned	m_wahead, m_wearly;
+	} PORT;
+
+private:
+	PORT		m_port[AXITRACE::NPORTS];
+	FILE		*m_fp;
+	unsigned long	m_threshold;
+	unsigned	m_trips;
+	bool		*m_bomb;
+
+	void	tickport(int pid, PORT &p, unsigned long clk);
+	void	trip(int pid, const char *what, unsigned long clocks,
+			unsigned long clk);
+	void	dumpburst(const char *dir, const BURST &b, unsigned long clk);
+public:
+	AXIWATCH(Vmain *core, unsigned long threshold, bool *bomb = NULL,
+			FILE *fp = stdout);
+
+	virtual	void	tick(unsigned long clk) {
+		for(int k=0; k<AXITRACE::NPORTS; k++)
+			tickport(k, m_port[k], clk);
+	}
+
+	// Describe every port with anything waiting or outstanding
+	void	dump(unsigned long clk);
+
+	// How many times a stall has crossed the threshold
+	unsigned	trips(void) const { return m_trips; }
+};
+// }}}
+
+static const char *const	AXIWATCH_PNAME[AXITRACE::NPORTS] = {
+			"Host", "MM2S", "S2MM", "DMA", "AXI RAM", "Control bus",
+			"AXI RAM 2" },
+			*AXIWATCH_CNAME[AXIWATCH::NCHAN] = {
+			"AR", "R", "AW", "W", "B" };
+
+inline	AXIWATCH::AXIWATCH(Vmain *core, unsigned long threshold, bool *bomb,
+		FILE *fp) {
+	// {{{
+	AXITRACE_BIND(m_port[AXITRACE::P_HOST],   wbu);
+	AXITRACE_BIND(m_port[AXITRACE::P_MM2S],   mm2s);
+	AXITRACE_BIND(m_port[AXITRACE::P_S2MM],   s2mm);
+	AXITRACE_BIND(m_port[AXITRACE::P_DMA],    dma);
+	AXITRACE_BIND(m_port[AXITRACE::P_AXIRAM], axiram);
+	AXITRACE_BIND(m_port[AXITRACE::P_CTRL],   controlbus);
+	AXITRACE_BIND(m_port[AXITRACE::P_AXIRAM2], axiram2);
+
+	for(int k=0; k<AXITRACE::NPORTS; k++) {
+		for(int c=0; c<NCHAN; c++)
+			m_port[k].m_stall[c] = m_port[k].m_worst[c] = 0;
+		m_port[k].m_idle   = 0;
+		m_port[k].m_wahead = m_port[k].m_wearly = 0;
+	}
+
+	m_fp        = fp;
+	m_threshold = threshold;
+	m_bomb      = bomb;
+	m_trips     = 0;
+}
+// }}}
+
+inline	void	AXIWATCH::tickport(int pid, PORT &p, unsigned long clk) {
+	// {{{
+	bool	valid[NCHAN], ready[NCHAN], busy = false;
+
+	valid[CH_AR] = *p.arvalid;	ready[CH_AR] = *p.arready;
+	valid[CH_R]  = *p.rvalid;	ready[CH_R]  = *p.rready;
+	valid[CH_AW] = *p.awvalid;	ready[CH_AW] = *p.awready;
+	valid[CH_W]  = *p.wvalid;	ready[CH_W]  = *p.wready;
+	valid[CH_B]  = *p.bvalid;	ready[CH_B]  = *p.bready;
+
+	// VALID without READY, channel by channel
+	// {{{
+	for(int c=0; c<NCHAN; c++) {
+		if (valid[c] && !ready[c]) {
+			p.m_stall[c]++;
+			if (p.m_stall[c] > p.m_worst[c])
+				p.m_worst[c] = p.m_stall[c];
+			if (m_threshold > 0 && p.m_stall[c] == m_threshold) {
+				char	what[32];
+
+				sprintf(what, "%s VALID without READY",
+					AXIWATCH_CNAME[c]);
+				trip(pid, what, p.m_stall[c], clk);
+			}
+		} else
+			p.m_stall[c] = 0;
+
+		if (valid[c])
+			busy = true;
+	}
+	// }}}
+
+	// Read bursts, from AR to RLAST
+	// {{{
+	if (valid[CH_AR] && ready[CH_AR]) {
+		BURST	b;
+
+		b.m_addr  = p.araddr.get();
+		b.m_id    = *p.arid;
+		b.m_len   = *p.arlen;
+		b.m_beats = 0;
+		b.m_start = clk;
+		p.m_rd.push_back(b);
+	}
+
+	if (valid[CH_R] && ready[CH_R]) {
+		// Beats return in order within each ID
+		for(auto it = p.m_rd.begin(); it != p.m_rd.end(); it++) {
+			if (it->m_id != *p.rid)
+				continue;
+			it->m_beats++;
+			if (*p.rlast)
+				p.m_rd.erase(it);
+			break;
+		}
+	}
+	// }}}
+
+	// Write bursts, from AW to B
+	// {{{
+	if (valid[CH_AW] && ready[CH_AW]) {
+		BURST	b;
+
+		b.m_addr  = p.awaddr.get();
+		b.m_id    = *p.awid;
+		b.m_len   = *p.awlen;
+		b.m_beats = 0;
+		b.m_start = clk;
+		if (p.m_wahead > 0) {
+			// All of its data has already gone by
+			b.m_beats = b.m_len + 1;
+			p.m_wahead--;
+		} else {
+			b.m_beats = p.m_wearly;
+			p.m_wearly = 0;
+		}
+		p.m_wr.push_back(b);
+	}
+
+	if (valid[CH_W] && ready[CH_W]) {
+		// Write data follows the order of the AWs
+		auto	it = p.m_wr.begin();
+
+		while(it != p.m_wr.end() && it->m_beats > it->m_len)
+			it++;
+		if (it != p.m_wr.end())
+			it->m_beats++;
+		else if (*p.wlast) {
+			p.m_wahead++;
+			p.m_wearly = 0;
+		} else
+			p.m_wearly++;
+	}
+
+	if (valid[CH_B] && ready[CH_B]) {
+		for(auto it = p.m_wr.begin(); it != p.m_wr.end(); it++) {
+			if (it->m_id != *p.bid)
+				continue;
+			p.m_wr.erase(it);
+			break;
+		}
+	}
+	// }}}
+
+	// Bursts outstanding, but nothing even VALID
+	// {{{
+	if (!busy && (!p.m_rd.empty() || !p.m_wr.empty())) {
+		p.m_idle++;
+		if (m_threshold > 0 && p.m_idle == m_threshold)
+			trip(pid, "Idle with bursts outstanding", p.m_idle,
+				clk);
+	} else
+		p.m_idle = 0;
+	// }}}
+}
+// }}}
+
+inline	void	AXIWATCH::trip(int pid, const char *what,
+		unsigned long clocks, unsigned long clk) {
+	// {{{
+	m_trips++;
+	if (m_bomb)
+		*m_bomb = true;
+
+	fprintf(m_fp, "WATCHDOG: %s: %s for %lu clocks, at clock %lu\n",
+		AXIWATCH_PNAME[pid], what, clocks, clk);
+	dump(clk);
+}
+// }}}
+
+inline	void	AXIWATCH::dumpburst(const char *dir, const BURST &b,
+		unsigned long clk) {
+	// {{{
+	fprintf(m_fp, "\t\t%s ID %u, ADDR 0x%08llx, %3u of %3u beats, "
+		"%lu clocks old\n", dir, b.m_id, (unsigned long long)b.m_addr,
+		b.m_beats, b.m_len+1, clk - b.m_start);
+}
+// }}}
+
+inline	void	AXIWATCH::dump(unsigned long clk) {
+	// {{{
+	for(int k=0; k<AXITRACE::NPORTS; k++) {
+		PORT	&p = m_port[k];
+		bool	waiting = false;
+
+		for(int c=0; c<NCHAN; c++)
+			if (p.m_stall[c] > 0)
+				waiting = true;
+		if (!waiting && p.m_rd.empty() && p.m_wr.empty())
+			continue;
+
+		fprintf(m_fp, "\t%-12s %2lu reads, %2lu writes outstanding, "
+			"idle for %lu clocks\n", AXIWATCH_PNAME[k],
+			(unsigned long)p.m_rd.size(),
+			(unsigned long)p.m_wr.size(), p.m_idle);
+		for(int c=0; c<NCHAN; c++)
+			if (p.m_stall[c] > 0)
+				fprintf(m_fp, "\t\t%-2s VALID && !READY for "
+					"%lu clocks (worst %lu)\n",
+					AXIWATCH_CNAME[c], p.m_stall[c],
+					p.m_worst[c]);
+		for(const BURST &b : p.m_rd)
+			dumpburst("RD", b, clk);
+		for(const BURST &b : p.m_wr)
+			dumpburst("WR", b, clk);
+	}
+	fflush(m_fp);
+}
+// }}}
+#endif	// AXIWATCH_H
@@ -0,0 +1,120 @@
+#!/bin/bash
+################################################################################
+##
+## Filename:	sim/buswidths.sh
+## {{{
+## Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+##
+## Purpose:	To measure how the throughput of the various data movers
+##		scales with the width of the AXI bus.  For each requested
+##	width, this script copies the project into its own build directory,
+##	sets BUS.WIDTH within autodata/axibus.txt, rebuilds the design via
+##	AutoFPGA and Verilator, runs the simulation, and then collects the
+##	"PERF:" lines it produces into one table.
+##
+##	Usage:	buswidths.sh [width ...]
+##
+##	The default widths are 32, 64, 128, 256, and 512.  Results are left
+##	in $BUILD (build/widths by default) under one directory per width.
+##	Any options in $MAIN_TB_ARGS, such as "-m ddr3", are passed on to
+##	each simulation.
+##
+## Creator:	Dan Gisselquist, Ph.D.
+##		Gisselquist Technology, LLC
+##
+################################################################################
+## }}}
+## Copyright (C) 2020-2025, Gisselquist Technology, LLC
+## {{{
+## This program is free software (firmware): you can redistribute it and/or
+## modify it under the terms of the GNU General Public License as published
+## by the Free Software Foundation, either version 3 of the License, or (at
+## your option) any later version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+## for more details.
+##
+## You should have received a copy of the GNU General Public License along
+## with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+## target there if the PDF file isn't present.)  If not, see
+## <http://www.gnu.org/licenses/> for a copy.
+## }}}
+## License:	GPL, v3, as defined and found on www.gnu.org,
+## {{{
+##		http://www.gnu.org/licenses/gpl.html
+##
+################################################################################
+##
+## }}}
+ROOT=`cd \`dirname $0\`/..; pwd`
+BUILD=${BUILD:-${ROOT}/build/widths}
+WIDTHS=${@:-"32 64 128 256 512"}
+
+for W in ${WIDTHS}
+do
+  D=${BUILD}/w${W}
+  echo "Building a ${W}-bit design in ${D}"
+
+  ## Start from a (clean) copy of the project
+  ## {{{
+  mkdir -p ${D}
+  for dir in autodata rtl sim sw
+  do
+    rsync -a --exclude obj_dir --exclude obj-pc --exclude logs \
+	--exclude main_tb --exclude '*.vcd' ${ROOT}/${dir} ${D}/
+  done
+  ln -sfn ${ROOT}/wb2axip ${D}/wb2axip
+  ## }}}
+
+  ## Regenerate the design at this width
+  ## {{{
+  sed -i -e "s/^@BUS.WIDTH=.*$/@BUS.WIDTH=${W}/" ${D}/autodata/axibus.txt
+  make --no-print-directory -C ${D}/autodata || exit 1
+  cp ${D}/autodata/toplevel.v	${D}/rtl/toplevel.v
+  cp ${D}/autodata/main.v	${D}/rtl/main.v
+  cp ${D}/autodata/regdefs.h	${D}/sw/regdefs.h
+  cp ${D}/autodata/regdefs.cpp	${D}/sw/regdefs.cpp
+  cp ${D}/autodata/rtl.make.inc	${D}/rtl/make.inc
+  cp ${D}/autodata/testb.h	${D}/sim/testb.h
+  cp ${D}/autodata/main_tb.cpp	${D}/sim/main_tb.cpp
+  ## }}}
+
+  ## Build and run the simulation
+  ## {{{
+  make --no-print-directory -C ${D}/rtl || exit 1
+  make --no-print-directory -C ${D}/sim main_tb || exit 1
+  mkdir -p ${D}/sim/logs
+  ( cd ${D}/sim; ./main_tb ${MAIN_TB_ARGS} ) > ${D}/main_tb.log
+  if ! tail -1 ${D}/main_tb.log | grep -q SUCCESS
+  then
+    echo "WARNING: The ${W}-bit simulation did not succeed"
+  fi
+  ## }}}
+done
+
+## Report
+## {{{
+## Each PERF: line reads, "PERF: <test> <width> <bytes> <clocks>".
+echo
+cat `for W in ${WIDTHS}; do echo ${BUILD}/w${W}/main_tb.log; done` \
+  | grep "^PERF:" | awk '
+	{
+		if (!($2 in seen)) { seen[$2] = 1; tests[nt++] = $2; }
+		if (!($3 in wseen)) { wseen[$3] = 1; widths[nw++] = $3; }
+		rate[$2, $3] = ($5 > 0) ? $4 / $5 : 0;
+	}
+	END {
+		printf("%-20s", "Bytes/clock");
+		for(w=0; w<nw; w++)
+			printf(" %8s", widths[w] "-bit");
+		printf("\n");
+		for(t=0; t<nt; t++) {
+			printf("%-20s", tests[t]);
+			for(w=0; w<nw; w++)
+				printf(" %8.3f", rate[tests[t], widths[w]]);
+			printf("\n");
+		}
+	}'
+## }}}
@@ -0,0 +1,206 @@
+#!/bin/bash
+################################################################################
+##
+## Filename:	sim/configs.sh
+## {{{
+## Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+##
+## Purpose:	To measure how the parameters of the design's components--the
+##		crossbar, the DMA, the stream sink--affect its performance.
+##	For each configuration listed in sim/configs.txt, this script copies
+##	the project into its own build directory, sets that configuration's
+##	parameters within rtl/main.v, rebuilds the design via Verilator, runs
+##	the simulation, and then compares the "PERF:", "LATENCY:", and
+##	"SPEED:" lines of every configuration in one table.  A configuration
+##	whose simulation doesn't end in SUCCESS is left out of that table.
+##
+##	Usage:	configs.sh [name ...]
+##
+##	The default is every configuration in $CONFIGS (sim/configs.txt by
+##	default).  Results are left in $BUILD (build/configs by default)
+##	under one directory per configuration.  Each simulation is run with -l,
+##	for its LATENCY: lines, along with any options in $MAIN_TB_ARGS, such
+##	as "-m ddr3".
+##
+## Creator:	Dan Gisselquist, Ph.D.
+##		Gisselquist Technology, LLC
+##
+################################################################################
+## }}}
+## Copyright (C) 2020-2025, Gisselquist Technology, LLC
+## {{{
+## This program is free software (firmware): you can redistribute it and/or
+## modify it under the terms of the GNU General Public License as published
+## by the Free Software Foundation, either version 3 of the License, or (at
+## your option) any later version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+## for more details.
+##
+## You should have received a copy of the GNU General Public License along
+## with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+## target there if the PDF file isn't present.)  If not, see
+## <http://www.gnu.org/licenses/> for a copy.
+## }}}
+## License:	GPL, v3, as defined and found on www.gnu.org,
+## {{{
+##		http://www.gnu.org/licenses/gpl.html
+##
+################################################################################
+##
+## }}}
+ROOT=`cd \`dirname $0\`/..; pwd`
+BUILD=${BUILD:-${ROOT}/build/configs}
+CONFIGS=${CONFIGS:-${ROOT}/sim/configs.txt}
+NAMES=${@:-`grep -v '^#' ${CONFIGS} | awk 'NF > 0 { print $1 }'`}
+PASSED=
+FAILED=
+
+for NAME in ${NAMES}
+do
+  D=${BUILD}/${NAME}
+  PARAMS=`grep -v '^#' ${CONFIGS} | awk -v n=${NAME} '$1 == n { $1 = ""; print }'`
+  if ! grep -v '^#' ${CONFIGS} | awk '{ print $1 }' | grep -qx ${NAME}
+  then
+    echo "ERR: No configuration named ${NAME} in ${CONFIGS}"
+    exit 1
+  fi
+  echo "Building the ${NAME} configuration in ${D}"
+
+  ## Start from a (clean) copy of the project
+  ## {{{
+  mkdir -p ${D}
+  for dir in rtl sim sw
+  do
+    rsync -a --exclude obj_dir --exclude obj-pc --exclude logs \
+	--exclude main_tb --exclude '*.vcd' ${ROOT}/${dir} ${D}/
+  done
+  ln -sfn ${ROOT}/wb2axip ${D}/wb2axip
+  ## }}}
+
+  ## Set this configuration's parameters
+  ## {{{
+  ## Each is changed within its instance's parameter list, from "#(" to the
+  ## "\t) <instance>" that closes it, or added to the top of that list
+  for P in ${PARAMS}
+  do
+    INST=${P%%.*} KEY=${P#*.}
+    PARAM=${KEY%%=*} VALUE=${KEY#*=}
+    INST=${INST} PARAM=${PARAM} VALUE=${VALUE} perl -0pi -e '
+	my ($i, $p, $v) = (quotemeta($ENV{INST}), quotemeta($ENV{PARAM}),
+			$ENV{VALUE});
+	s{(#\(\s*\n(?:(?!\n\t\)).)*?)\.$p\([^()\n]*\)((?:(?!\n\t\)).)*?\n\t\)\s*$i\b)}{$1.$ENV{PARAM}($v)$2}s
+	or s{(#\(\s*\n(?:\t\t// \{\{\{\n)?)((?:(?!\n\t\)).)*?\n\t\)\s*$i\b)}{$1\t\t.$ENV{PARAM}($v),\n$2}s
+	or die "No instance $ENV{INST} in main.v\n";' ${D}/rtl/main.v || exit 1
+    echo "  ${INST}.${PARAM} = ${VALUE}"
+  done
+  ## }}}
+
+  ## Build and run the simulation
+  ## {{{
+  make --no-print-directory -C ${D}/rtl || exit 1
+  make --no-print-directory -C ${D}/sim main_tb || exit 1
+  mkdir -p ${D}/sim/logs
+  ( cd ${D}/sim; ./main_tb -l ${MAIN_TB_ARGS} ) > ${D}/main_tb.log
+  if tail -1 ${D}/main_tb.log | grep -q SUCCESS
+  then
+    PASSED="${PASSED} ${NAME}"
+  else
+    echo "WARNING: The ${NAME} simulation did not succeed"
+    FAILED="${FAILED} ${NAME}"
+  fi
+  ## }}}
+done
+
+## Report
+## {{{
+## Each PERF: line reads, "PERF: <test> <width> <bytes> <clocks>", each
+## LATENCY: line, "LATENCY: <mover> <width> <clocks>", and the SPEED: line,
+## "SPEED: <clocks> clocks in <seconds> seconds, <rate> clocks/second".
+## With -a in $MAIN_TB_ARGS, each TOGGLE: line reads "TOGGLE: <port> <width>
+## <bytes> <toggles> <clocks> <quiet clocks>", and the CLKGATE: line,
+## "CLKGATE: DMA <width> <clocks> <gated clocks>".
+echo
+if [ -n "${FAILED}" ]
+then
+  echo "Left out, since their simulations failed:${FAILED}"
+  echo
+fi
+for NAME in ${PASSED}
+do
+  grep "^\(PERF\|LATENCY\|SPEED\|TOGGLE\|CLKGATE\):" \
+		${BUILD}/${NAME}/main_tb.log \
+	| sed -e "s/^/${NAME} /"
+done | awk '
+	{
+		if (!($1 in cseen)) { cseen[$1] = 1; configs[nc++] = $1; }
+	}
+	$2 == "PERF:" {
+		if (!($3 in tseen)) { tseen[$3] = 1; tests[nt++] = $3; }
+		rate[$3, $1] = ($6 > 0) ? $5 / $6 : 0;
+	}
+	$2 == "LATENCY:" {
+		if (!($3 in lseen)) { lseen[$3] = 1; movers[nl++] = $3; }
+		lat[$3, $1] = $5;
+	}
+	$2 == "SPEED:" { speed[$1] = $8 / 1000.0; }
+	$2 == "TOGGLE:" {
+		if (!($3 in pseen)) { pseen[$3] = 1; ports[np++] = $3; }
+		tgl[$3, $1]   = ($5 > 0) ? $6 / $5 : 0;
+		quiet[$3, $1] = ($7 > 0) ? 100.0 * $8 / $7 : 0;
+	}
+	$2 == "CLKGATE:" { gated[$1] = ($5 > 0) ? 100.0 * $6 / $5 : 0; }
+	function header(title) {
+		printf("%-20s", title);
+		for(c=0; c<nc; c++)
+			printf(" %10s", configs[c]);
+		printf("\n");
+	}
+	END {
+		header("Bytes/clock");
+		for(t=0; t<nt; t++) {
+			printf("%-20s", tests[t]);
+			for(c=0; c<nc; c++)
+				printf(" %10.3f", rate[tests[t], configs[c]]);
+			printf("\n");
+		}
+		printf("\n");
+		header("Latency (clocks)");
+		for(l=0; l<nl; l++) {
+			printf("%-20s", movers[l]);
+			for(c=0; c<nc; c++)
+				printf(" %10d", lat[movers[l], configs[c]]);
+			printf("\n");
+		}
+		printf("\n");
+		header("Simulation");
+		printf("%-20s", "kclocks/second");
+		for(c=0; c<nc; c++)
+			printf(" %10.1f", speed[configs[c]]);
+		printf("\n");
+		if (np == 0)
+			exit;
+		printf("\n");
+		header("Toggles/byte");
+		for(p=0; p<np; p++) {
+			printf("%-20s", ports[p]);
+			for(c=0; c<nc; c++)
+				printf(" %10.3f", tgl[ports[p], configs[c]]);
+			printf("\n");
+		}
+		printf("\n");
+		header("Quiet clocks (%)");
+		for(p=0; p<np; p++) {
+			printf("%-20s", ports[p]);
+			for(c=0; c<nc; c++)
+				printf(" %10.1f", quiet[ports[p], configs[c]]);
+			printf("\n");
+		}
+		printf("%-20s", "DMA clock gated (%)");
+		for(c=0; c<nc; c++)
+			printf(" %10.1f", gated[configs[c]]);
+		printf("\n");
+	}'
+## }}}
@@ -56,14 +56,16 @@ typedef	unsigned int	uint32;
 
 class	BUSERR {
 public:
-	uint32 addr;
-	BUSERR(const uint32 a) : addr(a) {};
+	unsigned long addr;
+	BUSERR(const unsigned long a) : addr(a) {};
 };
 
 class	DEVBUS {
 // {{{
 public:
 	typedef	uint32	BUSW;
+	// Addresses are wider than a bus word, since the AXI RAM sits above 4GB
+	typedef	unsigned long	BUSA;
 
 	virtual	void	kill(void) = 0;
 	virtual	void	close(void) = 0;
@@ -72,14 +74,14 @@ public:
 	//	a is the address of the value to be read as it exists on the
 	//		wishbone bus within the FPGA.
 	//	v is the singular value to write to this address
-	virtual	void	writeio(const BUSW a, const BUSW v) = 0;
+	virtual	void	writeio(const BUSA a, const BUSW v) = 0;
 
 	// Read a single value to a single address
 	//	a is the address of the value to be read as it exists on the
 	//		wishbone bus within the FPGA.
 	//	This function returns the value read from the device wishbone
 	//		at address a.
-	virtual	BUSW	readio(const BUSW a) = 0;
+	virtual	BUSW	readio(const BUSA a) = 0;
 
 	// Read a series of values from values from a block of memory
 	//	a is the address of the value to be read as it exists on the
@@ -90,7 +92,7 @@ public:
 	//	for(int i=0; i<len; i++)
 	//		buf[i] = readio(a+i);
 	// only it's faster in our implementation.
-	virtual	void	readi(const BUSW a, const int len, BUSW *buf) = 0;
+	virtual	void	readi(const BUSA a, const int len, BUSW *buf) = 0;
 
 	// Read a series of values from the same address in memory.  This
 	// call is identical to readi, save that the address is not incremented
@@ -99,7 +101,7 @@ public:
 	//		buf[i] = readio(a);
 	// only it's faster in our implementation.
 	//
-	virtual	void	readz(const BUSW a, const int len, BUSW *buf) = 0;
+	virtual	void	readz(const BUSA a, const int len, BUSW *buf) = 0;
 
 	// Write a series of values into a block of memory on the FPGA
 	//	a is the address of the value to be written as it exists on the
@@ -111,7 +113,7 @@ public:
 	//	for(int i=0; i<len; i++)
 	//		writeio(a+i, buf[i]);
 	// only it's faster in our implementation.
-	virtual	void	writei(const BUSW a, const int len, const BUSW *buf) = 0;
+	virtual	void	writei(const BUSA a, const int len, const BUSW *buf) = 0;
 	// Write a series of values into the same address on the FPGA bus.  This
 	// call is identical to writei, save that the address is not incremented
 	// from one write to the next.  It is equivalent to:
@@ -119,7 +121,7 @@ public:
 	//		writeio(a, buf[i]);
 	// only it's faster in our implementation.
 	//
-	virtual	void	writez(const BUSW a, const int len, const BUSW *buf) = 0;
+	virtual	void	writez(const BUSA a, const int len, const BUSW *buf) = 0;
 
 	// Query whether or not an interrupt has taken place
 	virtual	bool	poll(void) = 0;
@@ -0,0 +1,323 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/dramsim.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Implements the DRAM timing model described in dramsim.h, and
+//		the DPI functions through which rtl/memtiming.v uses it.
+//
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Vmain__Dpi.h"
+#include "dramsim.h"
+
+DRAMSIM	*dramsim = NULL;
+
+// Preset models
+// {{{
+// The presets assume a 64-bit wide rank and an AXI clock at one quarter of
+// the DRAM's clock, so (for example) an 11 clock CAS latency on a DDR3-1600
+// becomes three AXI clocks.
+static const struct {
+	const char	*m_name;
+	DRAMSIM::CONFIG	m_cfg;
+} presets[] = {
+	//		banks row  cl rcd rp wr turn ctrl  refi rfc jit   exp  seed
+	{ "ddr3",   {   8, 8192, 3, 3, 3, 4, 2, 10,  780, 26, 0, false, 1 } },
+	{ "ddr4",   {  16, 8192, 4, 4, 4, 4, 3, 12,  780, 35, 0, false, 1 } },
+	{ "lpddr4", {   8, 4096, 7, 5, 5, 5, 4, 16,  390, 28, 8, true,  1 } }
+};
+static const int	NPRESETS = sizeof(presets)/sizeof(presets[0]);
+// }}}
+
+DRAMSIM::DRAMSIM(const char *name, const CONFIG &cfg) {
+	// {{{
+	m_name = strdup(name);
+	m_cfg  = cfg;
+	if (m_cfg.m_banks < 1)
+		m_cfg.m_banks = 1;
+	if (m_cfg.m_row < 1)
+		m_cfg.m_row = 1;
+
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_bank = new BANK[m_cfg.m_banks];
+	for(unsigned k=0; k<m_cfg.m_banks; k++) {
+		m_bank[k].m_open  = -1;
+		m_bank[k].m_ready = 0;
+	}
+
+	m_next_cmd = 0;
+	m_next_refresh = m_cfg.m_refi;
+	m_data_free = 0;
+	m_last_wr = false;
+	m_rng = (m_cfg.m_seed) ? m_cfg.m_seed : 1;
+}
+// }}}
+
+DRAMSIM::~DRAMSIM(void) {
+	delete[] m_bank;
+	free(m_name);
+}
+
+unsigned	DRAMSIM::jitter(void) {
+	// {{{
+	double	u;
+
+	if (m_cfg.m_jitter == 0)
+		return 0;
+
+	// Xorshift32: cheap, and repeatable from run to run
+	m_rng ^= m_rng << 13;
+	m_rng ^= m_rng >> 17;
+	m_rng ^= m_rng << 5;
+
+	if (!m_cfg.m_exponential)
+		return m_rng % (m_cfg.m_jitter + 1);
+
+	u = (m_rng + 1.0) / 4294967297.0;
+	return (unsigned)(-log(u) * m_cfg.m_jitter);
+}
+// }}}
+
+uint64_t	DRAMSIM::request(uint64_t now, bool wr, uint64_t addr,
+			unsigned len, unsigned size) {
+	// {{{
+	unsigned	beats = len+1, bank, latency;
+	long		row;
+	uint64_t	t, release;
+
+	// Every beat costs one clock of the data bus, whatever its size
+	(void)size;
+	if (wr)
+		m_stats.m_writes++;
+	else
+		m_stats.m_reads++;
+
+	// Commands are issued in order, at most one per clock
+	t = now + m_cfg.m_ctrl;
+	if (t < m_next_cmd)
+		t = m_next_cmd;
+
+	// Refresh closes every bank, and holds them all for tRFC
+	while(m_cfg.m_refi > 0 && t >= m_next_refresh) {
+		for(unsigned k=0; k<m_cfg.m_banks; k++) {
+			m_bank[k].m_open = -1;
+			if (m_bank[k].m_ready < m_next_refresh + m_cfg.m_rfc)
+				m_bank[k].m_ready = m_next_refresh + m_cfg.m_rfc;
+		}
+		m_next_refresh += m_cfg.m_refi;
+		m_stats.m_refreshes++;
+	}
+
+	// Banks are interleaved on row boundaries
+	bank = (unsigned)((addr / m_cfg.m_row) % m_cfg.m_banks);
+	row  = (long)(addr / ((uint64_t)m_cfg.m_row * m_cfg.m_banks));
+
+	if (t < m_bank[bank].m_ready)
+		t = m_bank[bank].m_ready;
+
+	if (m_bank[bank].m_open == row) {
+		m_stats.m_hits++;
+		latency = m_cfg.m_cl;
+	} else if (m_bank[bank].m_open < 0) {
+		m_stats.m_misses++;
+		latency = m_cfg.m_rcd + m_cfg.m_cl;
+	} else {
+		m_stats.m_conflicts++;
+		latency = m_cfg.m_rp + m_cfg.m_rcd + m_cfg.m_cl;
+	}
+
+	if (!wr)
+		latency += jitter();
+	release = t + latency;
+
+	// The data bus is shared by reads and writes, and costs a turnaround
+	// every time it changes direction
+	if (release < m_data_free)
+		release = m_data_free;
+	if (wr != m_last_wr && m_stats.m_reads + m_stats.m_writes > 1) {
+		release += m_cfg.m_turn;
+		m_stats.m_turnarounds++;
+	}
+	m_data_free = release + beats;
+	m_last_wr = wr;
+
+	// A row hit may follow this burst's column command as soon as the
+	// burst has left the bank.  Writes must also wait out tWR.
+	m_bank[bank].m_open  = row;
+	m_bank[bank].m_ready = release - m_cfg.m_cl + beats
+				+ ((wr) ? m_cfg.m_wr : 0);
+	m_next_cmd = t + 1;
+
+	m_stats.m_latency += release - now;
+	return release;
+}
+// }}}
+
+void	DRAMSIM::report(FILE *fp) const {
+	// {{{
+	unsigned long	nreq = m_stats.m_reads + m_stats.m_writes;
+
+	fprintf(fp, "DRAM model: %s\n", m_name);
+	fprintf(fp, "\tREADS:       %10lu\n", m_stats.m_reads);
+	fprintf(fp, "\tWRITES:      %10lu\n", m_stats.m_writes);
+	fprintf(fp, "\tROW-HITS:    %10lu\n", m_stats.m_hits);
+	fprintf(fp, "\tROW-MISSES:  %10lu\n", m_stats.m_misses);
+	fprintf(fp, "\tCONFLICTS:   %10lu\n", m_stats.m_conflicts);
+	fprintf(fp, "\tREFRESHES:   %10lu\n", m_stats.m_refreshes);
+	fprintf(fp, "\tTURNAROUNDS: %10lu\n", m_stats.m_turnarounds);
+	if (nreq > 0)
+		fprintf(fp, "\tAVG-DELAY:   %10.2f\n",
+			m_stats.m_latency / (double)nreq);
+}
+// }}}
+
+DRAMSIM	*DRAMSIM::create(const char *spec) {
+	// {{{
+	char		*name, *params, *tok, *eq, *ptr;
+	CONFIG		cfg;
+	DRAMSIM		*model;
+	int		preset = -1;
+
+	name = strdup(spec);
+	params = strchr(name, ':');
+	if (params)
+		*params++ = '\0';
+
+	for(int k=0; k<NPRESETS; k++)
+		if (0 == strcmp(name, presets[k].m_name))
+			preset = k;
+	if (preset < 0) {
+		fprintf(stderr, "ERR: Unknown DRAM model, %s\n", name);
+		usage(stderr);
+		free(name);
+		return NULL;
+	}
+
+	cfg = presets[preset].m_cfg;
+	for(tok = (params) ? strtok(params, ",") : NULL; tok;
+			tok = strtok(NULL, ",")) {
+		unsigned long	v;
+
+		eq = strchr(tok, '=');
+		if (!eq) {
+			fprintf(stderr, "ERR: DRAM parameter %s has no value\n",
+				tok);
+			free(name);
+			return NULL;
+		} *eq++ = '\0';
+
+		if (0 == strcmp(tok, "dist")) {
+			if (0 == strcmp(eq, "exp"))
+				cfg.m_exponential = true;
+			else if (0 == strcmp(eq, "uniform"))
+				cfg.m_exponential = false;
+			else {
+				fprintf(stderr, "ERR: Unknown distribution, %s\n", eq);
+				free(name);
+				return NULL;
+			}
+			continue;
+		}
+
+		v = strtoul(eq, &ptr, 0);
+		if (*ptr != '\0') {
+			fprintf(stderr, "ERR: Bad value for DRAM parameter %s, %s\n",
+				tok, eq);
+			free(name);
+			return NULL;
+		}
+
+		if (0 == strcmp(tok, "banks"))		cfg.m_banks = v;
+		else if (0 == strcmp(tok, "row"))	cfg.m_row = v;
+		else if (0 == strcmp(tok, "cl"))	cfg.m_cl = v;
+		else if (0 == strcmp(tok, "rcd"))	cfg.m_rcd = v;
+		else if (0 == strcmp(tok, "rp"))	cfg.m_rp = v;
+		else if (0 == strcmp(tok, "wr"))	cfg.m_wr = v;
+		else if (0 == strcmp(tok, "turn"))	cfg.m_turn = v;
+		else if (0 == strcmp(tok, "ctrl"))	cfg.m_ctrl = v;
+		else if (0 == strcmp(tok, "refi"))	cfg.m_refi = v;
+		else if (0 == strcmp(tok, "rfc"))	cfg.m_rfc = v;
+		else if (0 == strcmp(tok, "jitter"))	cfg.m_jitter = v;
+		else if (0 == strcmp(tok, "seed"))	cfg.m_seed = v;
+		else {
+			fprintf(stderr, "ERR: Unknown DRAM parameter, %s\n", tok);
+			usage(stderr);
+			free(name);
+			return NULL;
+		}
+	}
+
+	model = new DRAMSIM(spec, cfg);
+	free(name);
+	return model;
+}
+// }}}
+
+void	DRAMSIM::usage(FILE *fp) {
+	// {{{
+	fprintf(fp, "DRAM models:");
+	for(int k=0; k<NPRESETS; k++)
+		fprintf(fp, " %s", presets[k].m_name);
+	fprintf(fp, "\n\tOptionally followed by :param=value,...  using any of\n"
+		"\tbanks, row, cl, rcd, rp, wr, turn, ctrl, refi, rfc, jitter,\n"
+		"\tdist (uniform or exp), or seed.  See sim/dramsim.h.\n");
+}
+// }}}
+
+////////////////////////////////////////////////////////////////////////
+//
+// DPI interface, as used by rtl/memtiming.v
+// {{{
+////////////////////////////////////////////////////////////////////////
+//
+//
+
+extern "C" {
+int	memtiming_enabled(void) {
+	return (dramsim != NULL) ? 1 : 0;
+}
+
+long long	memtiming_request(long long now, int wr, long long addr,
+			int len, int size) {
+	if (!dramsim)
+		return now;
+	return (long long)dramsim->request((uint64_t)now, wr != 0,
+			(uint64_t)addr, (unsigned)len, (unsigned)size);
+}
+}
+// }}}
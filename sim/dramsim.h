@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/dramsim.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A (very) simple model of DRAM timing, used to delay requests
+//		to the AXI RAM (see rtl/memtiming.v).  The model tracks the
+//	open row in each bank, so that each request becomes a row hit, a miss
+//	(bank closed), or a conflict (some other row open).  It also models
+//	periodic refresh, a fixed controller pipeline delay, a turnaround
+//	penalty whenever the data bus changes direction, and an optional
+//	random read latency.
+//
+//	All times are in AXI bus clocks.  A model is chosen at run time by
+//	name, optionally followed by a colon and a comma separated list of
+//	parameters to override, as in "ddr3" or "ddr4:cl=6,jitter=4".  The
+//	parameters are:
+//
+//	banks=	Number of banks
+//	row=	Bytes per row (page), across all the chips of the rank
+//	cl=	Column access latency, from column command to first data
+//	rcd=	Row activate to column command delay
+//	rp=	Row precharge time
+//	wr=	Write recovery time, before a bank may be used again
+//	turn=	Data bus turnaround penalty, read to write or write to read
+//	ctrl=	Fixed controller pipeline delay added to every request
+//	refi=	Interval between refreshes, zero to disable refresh
+//	rfc=	Time the memory is unavailable during each refresh
+//	jitter=	Maximum (uniform), or mean (exp), added read latency
+//	dist=	Read latency distribution: "uniform" or "exp"
+//	seed=	Random number seed, for repeatable jitter
+//
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	DRAMSIM_H
+#define	DRAMSIM_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+class	DRAMSIM {
+public:
+	typedef	struct	{
+		unsigned	m_banks, m_row,
+				m_cl, m_rcd, m_rp, m_wr, m_turn, m_ctrl,
+				m_refi, m_rfc, m_jitter;
+		bool		m_exponential;
+		uint32_t	m_seed;
+	} CONFIG;
+
+	typedef	struct	{
+		unsigned long	m_reads, m_writes, m_hits, m_misses,
+				m_conflicts, m_refreshes, m_turnarounds;
+		unsigned long	m_latency;	// Sum of all request delays
+	} STATS;
+
+private:
+	typedef	struct	{
+		long		m_open;	// Open row, or -1 if closed
+		uint64_t	m_ready;// First clock the bank may be used
+	} BANK;
+
+	char		*m_name;
+	CONFIG		m_cfg;
+	STATS		m_stats;
+	BANK		*m_bank;
+	uint64_t	m_next_cmd, m_next_refresh, m_data_free;
+	bool		m_last_wr;
+	uint32_t	m_rng;
+
+	unsigned	jitter(void);
+public:
+	DRAMSIM(const char *name, const CONFIG &cfg);
+	~DRAMSIM(void);
+
+	// Returns the clock at which a request arriving at clock "now" may
+	// be released to the memory
+	uint64_t	request(uint64_t now, bool wr, uint64_t addr,
+				unsigned len, unsigned size);
+
+	const char	*name(void) const { return m_name; }
+	const STATS	&stats(void) const { return m_stats; }
+	void	report(FILE *fp) const;
+
+	// Creates a model from a description, such as "ddr3:cl=4".  Returns
+	// NULL, and describes the problem on stderr, if the description isn't
+	// understood.
+	static	DRAMSIM	*create(const char *spec);
+	static	void	usage(FILE *fp);
+};
+
+// The model used by rtl/memtiming.v.  If NULL at reset, as it is by default,
+// the AXI RAM has no added delay.
+extern	DRAMSIM	*dramsim;
+
+#endif	// DRAMSIM_H
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/errsim.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Implements the error injection model described in errsim.h,
+//		and the DPI function through which rtl/errinject.v uses it.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#include <stdlib.h>
+#include <string.h>
+
+#include "Vmain__Dpi.h"
+#include "errsim.h"
+
+ERRSIM	*errsim = NULL;
+
+ERRSIM::ERRSIM(void) {
+	// {{{
+	m_rng = 1;
+	memset(m_bursts, 0, sizeof(m_bursts));
+	memset(m_resps, 0, sizeof(m_resps));
+}
+// }}}
+
+uint32_t	ERRSIM::random(void) {
+	// Xorshift32, as in the reordering model
+	m_rng ^= m_rng << 13;
+	m_rng ^= m_rng >> 17;
+	m_rng ^= m_rng << 5;
+	return m_rng;
+}
+
+ERRSIM::RULE	ERRSIM::rule(bool wr, uint64_t lo, uint64_t hi,
+				unsigned long nth, unsigned resp) {
+	// {{{
+	RULE	r;
+
+	r.m_rd   = !wr;
+	r.m_wr   =  wr;
+	r.m_lo   = lo;
+	r.m_hi   = hi;
+	r.m_nth  = nth;
+	r.m_seen = 0;
+	r.m_rate = 0;
+	r.m_resp = resp;
+	return r;
+}
+// }}}
+
+unsigned	ERRSIM::request(bool wr, uint64_t addr, unsigned len) {
+	// {{{
+	unsigned	resp = OKAY;
+
+	(void)len;
+	m_bursts[wr ? 1:0]++;
+	for(RULE &r : m_rules) {
+		if (!((wr) ? r.m_wr : r.m_rd))
+			continue;
+		if (addr < r.m_lo || addr >= r.m_hi)
+			continue;
+		if (r.m_nth != 0 && ++r.m_seen != r.m_nth)
+			continue;
+		if (r.m_rate != 0 && random() >= r.m_rate)
+			continue;
+
+		resp = r.m_resp;
+		break;
+	}
+
+	m_resps[wr ? 1:0][resp]++;
+	return resp;
+}
+// }}}
+
+void	ERRSIM::report(FILE *fp) const {
+	// {{{
+	fprintf(fp, "ERRORS: %lu rules\n", (unsigned long)m_rules.size());
+	for(int wr=0; wr<2; wr++)
+		fprintf(fp, "\t%-5s %8lu bursts, %8lu SLVERR, %8lu DECERR\n",
+			(wr) ? "WRITE" : "READ", m_bursts[wr],
+			m_resps[wr][SLVERR], m_resps[wr][DECERR]);
+}
+// }}}
+
+bool	ERRSIM::parse(const char *spec) {
+	// {{{
+	char	*str, *tok, *eq, *ptr;
+	RULE	r = rule(false, 0, -1ul, 0, SLVERR);
+
+	r.m_rd = r.m_wr = true;
+	str = strdup(spec);
+	for(tok = strtok(str, ","); tok; tok = strtok(NULL, ",")) {
+		if (0 == strcmp(tok, "r") || 0 == strcmp(tok, "R")) {
+			r.m_wr = false;
+			continue;
+		} else if (0 == strcmp(tok, "w") || 0 == strcmp(tok, "W")) {
+			r.m_rd = false;
+			continue;
+		}
+
+		eq = strchr(tok, '=');
+		if (!eq) {
+			fprintf(stderr, "ERR: Error parameter %s has no value\n",
+				tok);
+			goto fail;
+		} *eq++ = '\0';
+
+		if (0 == strcmp(tok, "addr")) {
+			r.m_lo = strtoull(eq, &ptr, 0);
+			r.m_hi = r.m_lo + 1;
+			if (*ptr == '-')
+				r.m_hi = strtoull(ptr+1, &ptr, 0);
+			if (*ptr != '\0' || r.m_hi <= r.m_lo) {
+				fprintf(stderr, "ERR: Bad error address range, "
+					"%s\n", eq);
+				goto fail;
+			}
+		} else if (0 == strcmp(tok, "burst")) {
+			r.m_nth = strtoul(eq, &ptr, 0);
+			if (*ptr != '\0' || r.m_nth == 0) {
+				fprintf(stderr, "ERR: Bad burst number, %s\n", eq);
+				goto fail;
+			}
+		} else if (0 == strcmp(tok, "rate")) {
+			double	p = strtod(eq, &ptr);
+
+			if (*ptr != '\0' || p <= 0.0 || p > 1.0) {
+				fprintf(stderr, "ERR: Bad error rate, %s\n", eq);
+				goto fail;
+			}
+			r.m_rate = (p >= 1.0) ? 0 : (uint32_t)(p * 4294967295.0);
+			if (r.m_rate == 0 && p < 1.0)
+				r.m_rate = 1;
+		} else if (0 == strcmp(tok, "resp")) {
+			if (0 == strcmp(eq, "slverr"))
+				r.m_resp = SLVERR;
+			else if (0 == strcmp(eq, "decerr"))
+				r.m_resp = DECERR;
+			else {
+				fprintf(stderr, "ERR: Unknown response, %s\n", eq);
+				goto fail;
+			}
+		} else if (0 == strcmp(tok, "seed")) {
+			m_rng = strtoul(eq, NULL, 0);
+			if (m_rng == 0)
+				m_rng = 1;
+		} else {
+			fprintf(stderr, "ERR: Unknown error parameter, %s\n", tok);
+			goto fail;
+		}
+	}
+
+	if (!r.m_rd && !r.m_wr) {
+		fprintf(stderr, "ERR: An error rule can't be both r and w\n");
+		goto fail;
+	}
+
+	add(r);
+	free(str);
+	return true;
+fail:
+	usage(stderr);
+	free(str);
+	return false;
+}
+// }}}
+
+void	ERRSIM::usage(FILE *fp) {
+	// {{{
+	fprintf(fp, "Error rules are a comma separated list of r|w,\n"
+		"\taddr=<lo>[-<hi>], burst=<n>, rate=<p>, resp=slverr|decerr,\n"
+		"\tand seed=<n>, as in w,addr=0x200000-0x210000,rate=0.01.\n"
+		"\tSee sim/errsim.h.\n");
+}
+// }}}
+
+////////////////////////////////////////////////////////////////////////
+//
+// DPI interface, as used by rtl/errinject.v
+// {{{
+////////////////////////////////////////////////////////////////////////
+//
+//
+
+int	errinject_request(int wr, long long addr, int len) {
+	if (!errsim)
+		return ERRSIM::OKAY;
+	return (int)errsim->request(wr != 0, (uint64_t)addr, (unsigned)len);
+}
+// }}}
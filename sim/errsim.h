@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/errsim.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Chooses which bursts to or from the AXI RAM end in a bus error,
+//		for rtl/errinject.v.  Each burst, as the RAM accepts it, is
+//	checked against a list of rules.  The first rule to match sets the
+//	burst's response to SLVERR or DECERR.  Bursts matching no rule are
+//	answered OKAY.
+//
+//	Rules may be given on the command line.  Each is a comma separated
+//	list of
+//
+//	r|w
+//		Match reads only, or writes only.  The default is both.
+//	addr=<lo>[-<hi>]
+//		Match bursts starting at RAM offsets from lo up to (not
+//		including) hi.  A lone lo matches only the burst starting
+//		there.
+//	burst=<n>
+//		Match only the n'th burst (from one) to pass the other tests.
+//	rate=<p>
+//		Match bursts passing the other tests with probability p.
+//	resp=slverr|decerr
+//		The response to return.  The default is SLVERR.
+//	seed=<n>
+//		Seeds the random rate, for repeatable runs.
+//
+//	For example, "w,addr=0x200000-0x210000,rate=0.01,resp=decerr" fails
+//	one in a hundred writes into the 64kB at 0x200000.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	ERRSIM_H
+#define	ERRSIM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+class	ERRSIM {
+public:
+	enum { OKAY = 0, SLVERR = 2, DECERR = 3 };
+
+	typedef	struct	{
+		bool		m_rd, m_wr;
+		uint64_t	m_lo, m_hi;
+		unsigned long	m_nth, m_seen;
+		uint32_t	m_rate;		// Out of 2^32-1, or always if 0
+		unsigned	m_resp;
+	} RULE;
+private:
+	std::vector<RULE>	m_rules;
+	uint32_t	m_rng;
+	// Bursts, and the responses given them, by [wr][resp]
+	unsigned long	m_bursts[2], m_resps[2][4];
+
+	uint32_t	random(void);
+public:
+	ERRSIM(void);
+
+	// Adds a rule.  Rules added by the harness use these directly
+	void	add(const RULE &r) { m_rules.push_back(r); }
+	void	clear(void) { m_rules.clear(); }
+	static	RULE	rule(bool wr, uint64_t lo, uint64_t hi,
+				unsigned long nth, unsigned resp);
+
+	// Returns the response a new burst should receive
+	unsigned	request(bool wr, uint64_t addr, unsigned len);
+
+	// Bursts failed so far, of either response
+	unsigned long	failed(bool wr) const {
+		return m_resps[wr?1:0][SLVERR] + m_resps[wr?1:0][DECERR]; }
+
+	void	report(FILE *fp) const;
+
+	// Adds a rule from a description, as above.  Returns false, and
+	// describes the problem on stderr, if it isn't understood.
+	bool	parse(const char *spec);
+	static	void	usage(FILE *fp);
+};
+
+// The model used by rtl/errinject.v.  If NULL, as it is by default, every
+// burst is answered OKAY.
+extern	ERRSIM	*errsim;
+
+#endif	// ERRSIM_H
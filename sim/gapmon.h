@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/gapmon.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Measures the hand-off between back to back continuous mode
+//		commands to the MM2S or the S2MM.  Every command moves the
+//	same number of beats, so the first beat of each new command is known
+//	by count alone.  For both the mover's AXI data channel (R for the MM2S,
+//	W for the S2MM) and its stream (into the sink, or out of the source),
+//	this records the idle clocks between the last beat of one command and
+//	the first beat of the next, as well as the fraction of clocks, first
+//	beat to last, that carried a beat.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	GAPMON_H
+#define	GAPMON_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "aximon.h"
+
+//
+// GAPMON
+// {{{
+class	GAPMON : public TICKMON {
+public:
+	typedef	struct {
+		unsigned long	m_beats, m_first, m_last;
+		// Idle clocks at command boundaries: total, and the worst
+		unsigned long	m_handoffs, m_gaps, m_worst;
+	} FLOW;
+
+	FLOW		m_axi, m_stream;
+private:
+	CData		*m_dvalid, *m_dready, *m_tvalid, *m_tready;
+	unsigned long	m_per;
+
+	void	beat(FLOW &f, unsigned long clk) {
+		// {{{
+		if (f.m_beats == 0)
+			f.m_first = clk;
+		else if (f.m_beats % m_per == 0) {
+			unsigned long	gap = clk - f.m_last - 1;
+
+			f.m_handoffs++;
+			f.m_gaps += gap;
+			if (gap > f.m_worst)
+				f.m_worst = gap;
+		}
+
+		f.m_last = clk;
+		f.m_beats++;
+	}
+	// }}}
+
+	void	clear(FLOW &f) {
+		f.m_beats = f.m_first = f.m_last = 0;
+		f.m_handoffs = f.m_gaps = f.m_worst = 0;
+	}
+public:
+	GAPMON(Vmain *core, int master, unsigned long beats_per_command) {
+		// {{{
+		if (master == AXIMON::S2MM) {
+			m_dvalid = &core->VVAR(_axi_s2mm_wvalid);
+			m_dready = &core->VVAR(_axi_s2mm_wready);
+			m_tvalid = &core->VVAR(_streamsrc_tvalid);
+			m_tready = &core->VVAR(_streamsrc_tready);
+		} else {
+			m_dvalid = &core->VVAR(_axi_mm2s_rvalid);
+			m_dready = &core->VVAR(_axi_mm2s_rready);
+			m_tvalid = &core->VVAR(_streamsink_tvalid);
+			m_tready = &core->VVAR(_streamsink_tready);
+		}
+
+		m_per = (beats_per_command > 0) ? beats_per_command : 1;
+		clear(m_axi);
+		clear(m_stream);
+	}
+	// }}}
+
+	// Fraction of the clocks, from the first beat to the last, with a beat
+	double	efficiency(const FLOW &f) const {
+		if (f.m_beats == 0)
+			return 0.0;
+		return f.m_beats / (double)(f.m_last - f.m_first + 1);
+	}
+
+	// Average idle clocks per hand-off
+	double	average(const FLOW &f) const {
+		return (f.m_handoffs > 0) ? f.m_gaps / (double)f.m_handoffs : 0.0;
+	}
+
+	virtual	void	tick(unsigned long clk) {
+		if (*m_dvalid && *m_dready)
+			beat(m_axi, clk);
+		if (*m_tvalid && *m_tready)
+			beat(m_stream, clk);
+	}
+};
+// }}}
+#endif
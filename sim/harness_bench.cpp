@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/harness_bench.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Measures the cost of the AXI_TB primitives the host software
+//		is built from: tick() (with and without tracing), idle(),
+//	reset(), readio(), writeio(), write64(), readv(), and writev().  Each
+//	benchmark is repeated several times, and the median is reported as
+//	both simulated clocks and host nanoseconds per call, so that changes
+//	to the harness (or the Verilated model) can be compared run to run.
+//
+//	Usage:	harness_bench [-n <trials>] [-r <reps scale>]
+//
+//	Each result is also printed as,
+//		BENCH: <name> <clocks/op> <ns/op> <ns/clock> <spread%>
+//	where spread is the (max-min)/median of the host time across trials.
+//	The clock counts don't depend upon the host, and should never change
+//	unless the design does.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include <string>
+
+#include "verilated.h"
+#include "design.h"
+
+#include "testb.h"
+#include "main_tb.cpp"
+#include "axi_tb.h"
+
+#define	BENCH_ADDR	R_AXIRAM
+#define	BENCH_MAXLEN	256
+#define	BENCH_TRIALS	7
+
+typedef	AXI_TB<MAINTB>	BENCHTB;
+typedef	void	(*BENCHFN)(BENCHTB *tb, unsigned arg);
+
+typedef	struct	{
+	const char	*m_name;
+	BENCHFN		m_fn;
+	unsigned	m_arg, m_reps;
+	bool		m_trace;
+} BENCH;
+
+static	uint32_t	benchbuf[BENCH_MAXLEN];
+
+// The benchmarks themselves
+// {{{
+static	void	b_tick(BENCHTB *tb, unsigned) {
+	tb->tick();
+}
+
+static	void	b_idle(BENCHTB *tb, unsigned n) {
+	tb->idle(n);
+}
+
+static	void	b_reset(BENCHTB *tb, unsigned) {
+	tb->reset();
+}
+
+static	void	b_readio(BENCHTB *tb, unsigned) {
+	(void)tb->readio(BENCH_ADDR);
+}
+
+static	void	b_writeio(BENCHTB *tb, unsigned) {
+	tb->writeio(BENCH_ADDR, 0x5a5a5a5a);
+}
+
+static	void	b_write64(BENCHTB *tb, unsigned) {
+	// The MM2S address register is safe to write while the core is idle
+	tb->write64(R_MM2SADDRLO, BENCH_ADDR);
+}
+
+static	void	b_readv(BENCHTB *tb, unsigned n) {
+	tb->readv(BENCH_ADDR, n, benchbuf);
+}
+
+static	void	b_writev(BENCHTB *tb, unsigned n) {
+	tb->writev(BENCH_ADDR, n, benchbuf);
+}
+// }}}
+
+static	const BENCH	benches[] = {
+	{ "tick",	b_tick,    0, 20000, false },
+	{ "tick+trace",	b_tick,    0,  5000, true  },
+	{ "idle(1)",	b_idle,    1, 20000, false },
+	{ "idle(16)",	b_idle,   16,  2000, false },
+	{ "idle(256)",	b_idle,  256,   200, false },
+	{ "reset",	b_reset,   0,  1000, false },
+	{ "readio",	b_readio,  0,  4000, false },
+	{ "writeio",	b_writeio, 0,  4000, false },
+	{ "write64",	b_write64, 0,  2000, false },
+	{ "readv(1)",	b_readv,   1,  4000, false },
+	{ "readv(4)",	b_readv,   4,  2000, false },
+	{ "readv(16)",	b_readv,  16,   500, false },
+	{ "readv(64)",	b_readv,  64,   200, false },
+	{ "readv(256)",	b_readv, 256,    50, false },
+	{ "writev(1)",	b_writev,  1,  4000, false },
+	{ "writev(4)",	b_writev,  4,  2000, false },
+	{ "writev(16)",	b_writev, 16,   500, false },
+	{ "writev(64)",	b_writev, 64,   200, false },
+	{ "writev(256)", b_writev, 256,   50, false },
+	{ NULL, NULL, 0, 0, false }
+};
+
+static	double	nanoseconds(const struct timespec &a, const struct timespec &b) {
+	return (b.tv_sec - a.tv_sec) * 1e9 + (b.tv_nsec - a.tv_nsec);
+}
+
+static	void	usage(void) {
+	fprintf(stderr, "USAGE: harness_bench [-n <trials>] [-r <reps scale>]\n");
+}
+
+int	main(int argc, char **argv) {
+	// Variable declaration and initialization
+	// {{{
+	Verilated::commandArgs(argc, argv);
+
+	unsigned	trials = BENCH_TRIALS;
+	double		scale = 1.0;
+	BENCHTB		*tb;
+	std::vector<std::string>	results;
+	char		line[128];
+	// }}}
+
+	// Process arguments
+	// {{{
+	for(int argn=1; argn < argc; argn++) {
+		if (argv[argn][0] == '+')
+			continue;	// +verilator+... arguments
+		else if (0 == strcmp(argv[argn], "-n") && argn+1 < argc)
+			trials = strtoul(argv[++argn], NULL, 0);
+		else if (0 == strcmp(argv[argn], "-r") && argn+1 < argc)
+			scale = atof(argv[++argn]);
+		else {
+			usage();
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (trials < 1 || scale <= 0.0) {
+		usage();
+		exit(EXIT_FAILURE);
+	}
+	// }}}
+
+	tb = new BENCHTB;
+	tb->reset();
+	for(unsigned k=0; k<BENCH_MAXLEN; k++)
+		benchbuf[k] = k * 0x01010101;
+
+	printf("%-12s %10s %10s %10s %8s\n",
+		"Benchmark", "Clocks/op", "ns/op", "ns/clock", "Spread");
+	for(const BENCH *b = benches; b->m_name; b++) {
+		std::vector<double>	ns;
+		unsigned long	clocks = 0;
+		unsigned	reps;
+
+		reps = (unsigned)(b->m_reps * scale);
+		if (reps < 1)
+			reps = 1;
+
+		if (b->m_trace)
+			tb->opentrace("/dev/null");
+
+		// One untimed call first, to warm up the caches and branch
+		// predictors and to leave the bus idle.
+		(*b->m_fn)(tb, b->m_arg);
+		tb->idle(4);
+
+		for(unsigned t=0; t<trials; t++) {
+			struct timespec	start, stop;
+			unsigned long	startclk = tb->tickcount();
+
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			for(unsigned k=0; k<reps; k++)
+				(*b->m_fn)(tb, b->m_arg);
+			clock_gettime(CLOCK_MONOTONIC, &stop);
+
+			clocks = tb->tickcount() - startclk;
+			ns.push_back(nanoseconds(start, stop) / reps);
+		}
+
+		if (b->m_trace)
+			tb->closetrace();
+
+		std::sort(ns.begin(), ns.end());
+
+		double	cpo = clocks / (double)reps,
+			median = ns[ns.size()/2],
+			spread = (median > 0) ? 100.0 * (ns.back()-ns.front())
+					/ median : 0.0;
+
+		printf("%-12s %10.2f %10.1f %10.2f %7.1f%%\n", b->m_name,
+			cpo, median, (clocks > 0) ? median / cpo : 0.0, spread);
+		fflush(stdout);
+		snprintf(line, sizeof(line), "BENCH: %s %.2f %.1f %.2f %.1f",
+			b->m_name, cpo, median,
+			(clocks > 0) ? median / cpo : 0.0, spread);
+		results.push_back(line);
+	}
+
+	printf("\n");
+	for(unsigned k=0; k<results.size(); k++)
+		printf("%s\n", results[k].c_str());
+
+	delete tb;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/hostprof.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Opens, reads, and reports the host CPU counters declared in
+//		hostprof.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "hostprof.h"
+
+HOSTPROF	*hostprof = NULL;
+
+static	int	perf_open(uint64_t config, int group) {
+	// {{{
+	struct perf_event_attr	attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size   = sizeof(attr);
+	attr.type   = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.disabled       = (group < 0) ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv     = 1;
+	attr.read_format    = PERF_FORMAT_GROUP;
+
+	return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+// }}}
+
+HOSTPROF::HOSTPROF(void) {
+	// {{{
+	const	uint64_t	config[NCOUNTERS] = {
+			PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+			PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+	m_leader = -1;
+	m_nopen  = 0;
+	for(int k=0; k<NCOUNTERS; k++) {
+		m_fd[k] = perf_open(config[k], m_leader);
+		if (m_fd[k] < 0)
+			continue;
+		if (m_leader < 0)
+			m_leader = m_fd[k];
+		m_nopen++;
+	}
+
+	if (m_leader >= 0) {
+		ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	} else
+		fprintf(stderr, "WARNING: No host CPU counters, "
+				"only time will be profiled\n");
+
+	for(int k=0; k<NSTEPS; k++)
+		clear(m_step[k]);
+	m_current = -1;
+	read(m_pstart, m_pns);
+}
+// }}}
+
+HOSTPROF::~HOSTPROF(void) {
+	for(int k=0; k<NCOUNTERS; k++)
+		if (m_fd[k] >= 0)
+			close(m_fd[k]);
+}
+
+void	HOSTPROF::clear(TOTALS &t) {
+	for(int k=0; k<NCOUNTERS; k++)
+		t.m_count[k] = 0;
+	t.m_ns = 0;
+	t.m_calls = 0;
+}
+
+// Subtracts b from a, stopping at zero
+void	HOSTPROF::less(TOTALS &a, const TOTALS &b) {
+	for(int k=0; k<NCOUNTERS; k++)
+		a.m_count[k] -= (a.m_count[k] > b.m_count[k])
+				? b.m_count[k] : a.m_count[k];
+	a.m_ns -= (a.m_ns > b.m_ns) ? b.m_ns : a.m_ns;
+}
+
+void	HOSTPROF::read(uint64_t *v, uint64_t &ns) {
+	// {{{
+	struct timespec	now;
+
+	if (m_leader >= 0) {
+		// With PERF_FORMAT_GROUP, the counters that opened follow
+		// their number, in the order they were opened
+		uint64_t	buf[1+NCOUNTERS];
+		int		n = 0;
+
+		if (::read(m_leader, buf, sizeof(buf)) < (ssize_t)sizeof(uint64_t))
+			buf[0] = 0;
+		for(int k=0; k<NCOUNTERS; k++)
+			v[k] = (m_fd[k] >= 0 && n < (int)buf[0]) ? buf[1+n++] : 0;
+	} else for(int k=0; k<NCOUNTERS; k++)
+		v[k] = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	ns = now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+// }}}
+
+void	HOSTPROF::add(TOTALS &t, const uint64_t *start, uint64_t ns) {
+	uint64_t	v[NCOUNTERS], now;
+
+	read(v, now);
+	for(int k=0; k<NCOUNTERS; k++)
+		t.m_count[k] += v[k] - start[k];
+	t.m_ns += now - ns;
+	t.m_calls++;
+}
+
+void	HOSTPROF::phase(const char *name) {
+	// {{{
+	int	p;
+
+	if (m_current >= 0)
+		add(m_phase[m_current], m_pstart, m_pns);
+
+	if (!name) {
+		m_current = -1;
+		return;
+	}
+
+	for(p=0; p<(int)m_names.size(); p++)
+		if (m_names[p] == name)
+			break;
+	if (p >= (int)m_names.size()) {
+		TOTALS	t;
+
+		clear(t);
+		m_names.push_back(name);
+		m_phase.push_back(t);
+	}
+
+	m_current = p;
+	read(m_pstart, m_pns);
+}
+// }}}
+
+void	HOSTPROF::line(FILE *fp, const char *name, const TOTALS &t) {
+	// {{{
+	fprintf(fp, "%-24s %9lu %9.1f", name, t.m_calls, t.m_ns / 1e6);
+	if (counting()) {
+		fprintf(fp, " %9.1f %9.1f %5.2f %9.1f %9.1f",
+			t.m_count[C_CYCLES] / 1e6,
+			t.m_count[C_INSNS] / 1e6,
+			(t.m_count[C_CYCLES] > 0) ? t.m_count[C_INSNS]
+				/ (double)t.m_count[C_CYCLES] : 0.0,
+			t.m_count[C_CMISS] / 1e3,
+			t.m_count[C_BMISS] / 1e3);
+	}
+	fprintf(fp, "\n");
+}
+// }}}
+
+void	HOSTPROF::report(FILE *fp) {
+	// {{{
+	TOTALS	other, harness, total;
+
+	phase(NULL);
+
+	clear(total);
+	for(unsigned p=0; p<m_phase.size(); p++) {
+		for(int k=0; k<NCOUNTERS; k++)
+			total.m_count[k] += m_phase[p].m_count[k];
+		total.m_ns    += m_phase[p].m_ns;
+		total.m_calls += m_phase[p].m_calls;
+	}
+
+	// The clock's own cost, less the design's evaluation, is that of the
+	// trace and everything else within TESTB::tick().  Whatever's left
+	// over once the clock, monitors, and RAM clearing are accounted for
+	// belongs to the harness itself.
+	other = m_step[S_CLOCK];
+	less(other, m_step[S_EVAL]);
+	harness = total;
+	less(harness, m_step[S_CLOCK]);
+	less(harness, m_step[S_MONITORS]);
+	less(harness, m_step[S_CLEAR]);
+	harness.m_calls = 0;
+
+	fprintf(fp, "HOST PROFILE:\n%-24s %9s %9s", "", "CALLS", "MS");
+	if (counting())
+		fprintf(fp, " %9s %9s %5s %9s %9s", "MCYCLES", "MINSNS",
+			"IPC", "KCMISS", "KBMISS");
+	fprintf(fp, "\n");
+
+	line(fp, "Clock ticks", m_step[S_CLOCK]);
+	line(fp, "  eval()", m_step[S_EVAL]);
+	line(fp, "  trace, other", other);
+	line(fp, "Monitors", m_step[S_MONITORS]);
+	line(fp, "Clear RAM", m_step[S_CLEAR]);
+	line(fp, "Harness, other", harness);
+	for(unsigned p=0; p<m_phase.size(); p++)
+		line(fp, m_names[p].c_str(), m_phase[p]);
+	line(fp, "Total", total);
+}
+// }}}
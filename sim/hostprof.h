@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/hostprof.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Measures where the host's time goes while simulating.  Using
+//		Linux's perf_event_open(), this counts CPU cycles, instructions
+//	retired, cache misses, and branch misses (along with wall clock time)
+//	across:
+//
+//	- Each clock tick's sub-steps: evaluating the design, everything else
+//		the clock does (trace dumping included), and the monitors
+//	- Clearing the AXI RAM
+//	- Each named test phase, as given to phase()
+//
+//	Scopes are counted while a global HOSTPROF, hostprof, exists.  Without
+//	one, each HOSTPROF_SCOPE costs a single test.  With one, each costs a
+//	pair of system calls, so counts from inside a tick include some of the
+//	profiler's own overhead.  Where the kernel won't allow the counters
+//	(see /proc/sys/kernel/perf_event_paranoid), only time is reported.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	HOSTPROF_H
+#define	HOSTPROF_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class	HOSTPROF {
+public:
+	enum { C_CYCLES = 0, C_INSNS, C_CMISS, C_BMISS, NCOUNTERS };
+	enum { S_CLOCK = 0, S_EVAL, S_MONITORS, S_CLEAR, NSTEPS };
+
+	typedef	struct {
+		uint64_t	m_count[NCOUNTERS], m_ns;
+		unsigned long	m_calls;
+	} TOTALS;
+
+	// SCOPE
+	// {{{
+	// Counts everything from its construction to its destruction
+	// against one of the steps above
+	class	SCOPE {
+		HOSTPROF	*m_prof;
+		int		m_step;
+		uint64_t	m_start[NCOUNTERS], m_ns;
+	public:
+		SCOPE(int step);
+		~SCOPE(void);
+	};
+	// }}}
+private:
+	int		m_leader, m_fd[NCOUNTERS], m_nopen;
+	TOTALS		m_step[NSTEPS];
+	std::vector<std::string>	m_names;
+	std::vector<TOTALS>		m_phase;
+	int		m_current;
+	uint64_t	m_pstart[NCOUNTERS], m_pns;
+
+	void	clear(TOTALS &t);
+	void	less(TOTALS &a, const TOTALS &b);
+	void	add(TOTALS &t, const uint64_t *start, uint64_t ns);
+	void	line(FILE *fp, const char *name, const TOTALS &t);
+public:
+	HOSTPROF(void);
+	~HOSTPROF(void);
+
+	// True if the hardware counters are available
+	bool	counting(void) const { return m_nopen > 0; }
+
+	// Reads every counter, and the time in ns
+	void	read(uint64_t *v, uint64_t &ns);
+
+	void	add(int step, const uint64_t *start, uint64_t ns) {
+		add(m_step[step], start, ns);
+	}
+
+	// Everything from here until the next call counts against name
+	void	phase(const char *name);
+
+	void	report(FILE *fp);
+};
+
+extern	HOSTPROF	*hostprof;
+
+#define	HOSTPROF_SCOPE(S)	HOSTPROF::SCOPE	hostprof_scope(S)
+
+inline	HOSTPROF::SCOPE::SCOPE(int step) {
+	m_prof = hostprof;
+	m_step = step;
+	if (m_prof)
+		m_prof->read(m_start, m_ns);
+}
+
+inline	HOSTPROF::SCOPE::~SCOPE(void) {
+	if (m_prof)
+		m_prof->add(m_step, m_start, m_ns);
+}
+#endif
@@ -7,7 +7,7 @@
 // Computer Generated: This file is computer generated by AUTOFPGA. DO NOT EDIT.
 // DO NOT EDIT THIS FILE!
 //
-// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt vibus.txt noconsole.txt
+// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axiram2.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt streamcheck.txt qos.txt vibus.txt noconsole.txt
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -52,7 +52,9 @@
 #include "design.h"
 #include "regdefs.h"
 #include "testb.h"
+#include "hostprof.h"
 #include "byteswap.h"
+#include "sparsemem.h"
 //
 // SIM.DEFINES
 //
@@ -84,7 +86,39 @@
 #define	RAMSIZE	(1<<24)
 #endif
 
-#define	block_ram	VVAR(_axiram_mem)
+#ifdef	AXIRAM_SPARSE
+// Only the bottom of a sparse RAM may be reached by pointer, and that only as
+// far as the test bench needs.  See sparsemem.h
+#define	AXIRAM_WINDOW	(1ul<<23)
+#else
+#define	AXIRAM_WINDOW	RAMSIZE
+#endif
+
+#define	block_ram	AXIRAM
+
+//
+// ramwords()
+//
+// Returns the RAM as an array of 32-bit words, no matter how wide the bus
+// (and hence each RAM word) is.  Verilator keeps RAM words of any width
+// (IData, QData, or VlWide<>) as little-endian 32-bit words, so 32-bit word
+// K of the result always holds bus bytes 4K through 4K+3.
+//
+template<class MEMW>	inline	uint32_t *ramwords(MEMW *mem) {
+	static_assert(sizeof(MEMW) % sizeof(uint32_t) == 0,
+		"RAM words must be a multiple of 32-bits wide");
+	return (uint32_t *)mem;
+}
+
+#ifdef	ROOT_VERILATOR
+#define	AXIRAM2	VVAR(_axiram2_mem.m_storage)
+#else
+#define	AXIRAM2	VVAR(_axiram2_mem)
+#endif
+
+#ifndef	RAM2SIZE
+#define	RAM2SIZE	(1<<22)
+#endif
 class	MAINTB : public TESTB<Vmain> {
 public:
 		// SIM.DEFNS
@@ -153,14 +187,14 @@ public:
 	// this function to load values into any (memory-type) location
 	// on the bus.
 	//
-	bool	load(uint32_t addr, const char *buf, uint32_t len) {
-		uint32_t	start, offset, wlen, base, adrln;
+	bool	load(uint64_t addr, const char *buf, uint32_t len) {
+		uint64_t	start, offset, wlen, base, adrln;
 
 		//
 		// Loading the axiram component
 		//
-		base  = 0x01000000; // in octets
-		adrln = 0x01000000;
+		base  = 0x200000000ul; // in octets
+		adrln = AXIRAM_WINDOW; // Only what axiram_words() reaches
 
 		if ((addr >= base)&&(addr < base + adrln)) {
 			// If the start access is in axiram
@@ -172,12 +206,43 @@ public:
 			start = start & (-4);
 			wlen = (wlen+3)&(-4);
 
-			// Need to byte swap data to get it into the memory
-			char	*bswapd = new char[len+8];
+			// Need to byte swap data to get it into the memory.  The
+			// memory is addressed as 32-bit words here, so this
+			// works for any bus width.
+			char	*bswapd = new char[wlen+8];
 			memcpy(bswapd, &buf[offset], wlen);
-			byteswapbuf(len>>2, (uint32_t *)bswapd);
-			memcpy(&m_core->block_ram[start], bswapd, wlen);
-			delete	bswapd;
+			byteswapbuf(wlen>>2, (uint32_t *)bswapd);
+			memcpy(&axiram_words()[start>>2], bswapd, wlen);
+			delete[] bswapd;
+			// AUTOFPGA::Now clean up anything else
+			// Was there more to write than we wrote?
+			if (addr + len > base + adrln)
+				return load(base + adrln, &buf[offset+wlen], len-wlen);
+			return true;
+		}
+
+		//
+		// Loading the axiram2 component
+		//
+		base  = 0x00400000; // in octets
+		adrln = 0x00400000;
+
+		if ((addr >= base)&&(addr < base + adrln)) {
+			// If the start access is in axiram2
+			start = (addr > base) ? (addr-base) : 0;
+			offset = (start + base) - addr;
+			wlen = (len-offset > adrln - start)
+				? (adrln - start) : len - offset;
+			// FROM axiram2.SIM.LOAD
+			start = start & (-4);
+			wlen = (wlen+3)&(-4);
+
+			// As with the first AXI RAM
+			char	*bswapd = new char[wlen+8];
+			memcpy(bswapd, &buf[offset], wlen);
+			byteswapbuf(wlen>>2, (uint32_t *)bswapd);
+			memcpy(&axiram2_words()[start>>2], bswapd, wlen);
+			delete[] bswapd;
 			// AUTOFPGA::Now clean up anything else
 			// Was there more to write than we wrote?
 			if (addr + len > base + adrln)
@@ -199,5 +264,73 @@ public:
 	// define this tag by those functions (or other sim code), and
 	// it will be pasated here.
 	//
+	// eval()
+	// {{{
+	// Evaluates the design, counted by the host profiler (if any)
+	virtual	void	eval(void) {
+		HOSTPROF_SCOPE(HOSTPROF::S_EVAL);
+		TESTB<Vmain>::eval();
+	}
+	// }}}
+
+	// axiram_words()
+	// {{{
+	// The axiram memory, as an array of 32-bit words
+	uint32_t	*axiram_words(void) {
+#ifdef	AXIRAM_SPARSE
+		return getsparsemem()->window(AXIRAM_WINDOW);
+#else
+		return ramwords(&m_core->block_ram[0]);
+#endif
+	}
+	// }}}
+
+	// axiram_clear()
+	// {{{
+	// Sets every word of the axiram memory to fill.  A sparse memory does
+	// this in O(1), outside of any pointer window.
+	void	axiram_clear(uint32_t fill) {
+		HOSTPROF_SCOPE(HOSTPROF::S_CLEAR);
+#ifdef	AXIRAM_SPARSE
+		getsparsemem()->clear(fill);
+#else
+		uint32_t	*w = axiram_words();
+
+		for(unsigned long k=0; k<RAMSIZE/sizeof(uint32_t); k++)
+			w[k] = fill;
+#endif
+	}
+	// }}}
+
+	// axiram2_words()
+	// {{{
+	// The axiram2 memory, as an array of 32-bit words
+	uint32_t	*axiram2_words(void) {
+		return ramwords(&m_core->AXIRAM2[0]);
+	}
+	// }}}
+
+	// axiram2_clear()
+	// {{{
+	void	axiram2_clear(uint32_t fill) {
+		HOSTPROF_SCOPE(HOSTPROF::S_CLEAR);
+		uint32_t	*w = axiram2_words();
+
+		for(unsigned long k=0; k<RAM2SIZE/sizeof(uint32_t); k++)
+			w[k] = fill;
+	}
+	// }}}
+
+	// qos_set()
+	// {{{
+	// Sets the AxQOS of each data mover.  These only matter to the
+	// arbitration if the design was built with QOS_ARBITER defined.
+	void	qos_set(unsigned mm2s, unsigned s2mm, unsigned dma) {
+		m_core->VVAR(_qos_mm2s_ar) = mm2s & 0x0f;
+		m_core->VVAR(_qos_s2mm_aw) = s2mm & 0x0f;
+		m_core->VVAR(_qos_dma_ar)  = dma  & 0x0f;
+		m_core->VVAR(_qos_dma_aw)  = dma  & 0x0f;
+	}
+	// }}}
 
 };
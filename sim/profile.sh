@@ -0,0 +1,101 @@
+#!/bin/bash
+################################################################################
+##
+## Filename:	sim/profile.sh
+## {{{
+## Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+##
+## Purpose:	To find which parts of the design cost the most to simulate.
+##		This script copies the project into its own build directory,
+##	builds it with Verilator's profiling turned on (make PROF=1, giving
+##	--prof-cfuncs and --prof-exec), runs the standard simulation, and then
+##	reports where the time went:
+##
+##	- profcfunc.txt	verilator_profcfunc's breakdown of gprof's results,
+##			by design, by module, and by function
+##	- gantt.txt	verilator_gantt's summary of the execution profile
+##
+##	The per-module summary, slowest module first, is then printed.
+##
+##	Usage:	profile.sh
+##
+##	Results are left in $BUILD (build/profile by default).  Any options
+##	in $MAIN_TB_ARGS, such as "-m ddr3", are passed on to the simulation.
+##
+## Creator:	Dan Gisselquist, Ph.D.
+##		Gisselquist Technology, LLC
+##
+################################################################################
+## }}}
+## Copyright (C) 2020-2025, Gisselquist Technology, LLC
+## {{{
+## This program is free software (firmware): you can redistribute it and/or
+## modify it under the terms of the GNU General Public License as published
+## by the Free Software Foundation, either version 3 of the License, or (at
+## your option) any later version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+## FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+## for more details.
+##
+## You should have received a copy of the GNU General Public License along
+## with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+## target there if the PDF file isn't present.)  If not, see
+## <http://www.gnu.org/licenses/> for a copy.
+## }}}
+## License:	GPL, v3, as defined and found on www.gnu.org,
+## {{{
+##		http://www.gnu.org/licenses/gpl.html
+##
+################################################################################
+##
+## }}}
+ROOT=`cd \`dirname $0\`/..; pwd`
+BUILD=${BUILD:-${ROOT}/build/profile}
+D=${BUILD}
+
+echo "Building a profiling design in ${D}"
+
+## Start from a (clean) copy of the project
+## {{{
+mkdir -p ${D}
+for dir in rtl sim sw
+do
+  rsync -a --exclude obj_dir --exclude obj-pc --exclude logs \
+	--exclude main_tb --exclude '*.vcd' ${ROOT}/${dir} ${D}/
+done
+ln -sfn ${ROOT}/wb2axip ${D}/wb2axip
+## }}}
+
+## Build and run the simulation
+## {{{
+make --no-print-directory -C ${D}/rtl PROF=1 || exit 1
+make --no-print-directory -C ${D}/sim PROF=1 main_tb || exit 1
+mkdir -p ${D}/sim/logs
+rm -f ${D}/sim/gmon.out ${D}/sim/profile_exec.dat
+( cd ${D}/sim; ./main_tb ${MAIN_TB_ARGS} \
+	+verilator+prof+exec+file+profile_exec.dat ) > ${D}/main_tb.log
+if ! tail -1 ${D}/main_tb.log | grep -q SUCCESS
+then
+  echo "WARNING: The profiled simulation did not succeed"
+fi
+## }}}
+
+## Report
+## {{{
+( cd ${D}/sim; gprof main_tb gmon.out ) > ${D}/gprof.out || exit 1
+verilator_profcfunc ${D}/gprof.out > ${D}/profcfunc.txt || exit 1
+if [ -e ${D}/sim/profile_exec.dat ]
+then
+  ( cd ${D}; verilator_gantt --no-vcd sim/profile_exec.dat ) \
+	> ${D}/gantt.txt 2>&1
+fi
+
+echo
+awk '/summary by module/	{ show = 1 }
+	show && /^[ \t]*$/	{ exit }
+	show			{ print }' ${D}/profcfunc.txt
+echo
+echo "See ${D}/profcfunc.txt for the full breakdown"
+## }}}
@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/reordersim.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Implements the reordering model described in reordersim.h,
+//		and the DPI functions through which rtl/axireorder.v uses it.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Vmain__Dpi.h"
+#include "reordersim.h"
+
+REORDERSIM	*reordersim = NULL;
+
+REORDERSIM::REORDERSIM(const char *name) {
+	// {{{
+	m_name = strdup(name);
+	memset(m_wait, 0, sizeof(m_wait));
+	memset(m_stats, 0, sizeof(m_stats));
+	m_exponential = false;
+	m_rng = 1;
+}
+// }}}
+
+REORDERSIM::~REORDERSIM(void) {
+	free(m_name);
+}
+
+unsigned	REORDERSIM::random(void) {
+	// Xorshift32: cheap, and repeatable from run to run
+	m_rng ^= m_rng << 13;
+	m_rng ^= m_rng >> 17;
+	m_rng ^= m_rng << 5;
+	return m_rng;
+}
+
+unsigned	REORDERSIM::delay(bool wr, unsigned id) {
+	// {{{
+	const WAIT	&w = m_wait[wr ? 1:0][id % NIDS];
+	unsigned	range = w.m_max - w.m_min, d;
+
+	if (range == 0)
+		d = w.m_min;
+	else if (!m_exponential)
+		d = w.m_min + random() % (range + 1);
+	else {
+		double	u = (random() + 1.0) / 4294967297.0,
+			x = -log(u) * range / 4.0;
+
+		d = w.m_min + ((x < range) ? (unsigned)x : range);
+	}
+
+	m_stats[wr ? 1:0].m_items[id % NIDS]++;
+	m_stats[wr ? 1:0].m_wait[id % NIDS] += d;
+	return d;
+}
+// }}}
+
+void	REORDERSIM::report(FILE *fp) const {
+	// {{{
+	fprintf(fp, "REORDER: %s\n", m_name);
+	for(int wr=0; wr<2; wr++) {
+		const STATS	&s = m_stats[wr];
+
+		for(int id=0; id<NIDS; id++) {
+			if (s.m_items[id] == 0)
+				continue;
+			fprintf(fp, "\t%-5s ID %2d: %8lu items, AVG-WAIT %8.2f\n",
+				(wr) ? "WRITE" : "READ", id, s.m_items[id],
+				s.m_wait[id] / (double)s.m_items[id]);
+		}
+		fprintf(fp, "\t%-5s PASSED: %lu items released ahead of an "
+			"older one\n", (wr) ? "WRITE" : "READ", s.m_passed);
+	}
+}
+// }}}
+
+REORDERSIM	*REORDERSIM::create(const char *spec) {
+	// {{{
+	char		*str, *tok, *eq, *ptr;
+	REORDERSIM	*model;
+	bool		given[2][NIDS];
+	WAIT		dflt[2];
+	bool		dflt_given[2] = { false, false };
+
+	model = new REORDERSIM(spec);
+	memset(given, 0, sizeof(given));
+	memset(dflt, 0, sizeof(dflt));
+	str = strdup(spec);
+	for(tok = strtok(str, ","); tok; tok = strtok(NULL, ",")) {
+		bool	rd = true, wr = true;
+		WAIT	w;
+		int	id;
+
+		eq = strchr(tok, '=');
+		if (!eq) {
+			fprintf(stderr, "ERR: Reorder parameter %s has no value\n",
+				tok);
+			goto fail;
+		} *eq++ = '\0';
+
+		if (0 == strcmp(tok, "dist")) {
+			if (0 == strcmp(eq, "exp"))
+				model->m_exponential = true;
+			else if (0 == strcmp(eq, "uniform"))
+				model->m_exponential = false;
+			else {
+				fprintf(stderr, "ERR: Unknown distribution, %s\n", eq);
+				goto fail;
+			}
+			continue;
+		} else if (0 == strcmp(tok, "seed")) {
+			model->m_rng = strtoul(eq, NULL, 0);
+			if (model->m_rng == 0)
+				model->m_rng = 1;
+			continue;
+		}
+
+		if (tok[0] == 'r' || tok[0] == 'R') {
+			wr = false;
+			tok++;
+		} else if (tok[0] == 'w' || tok[0] == 'W') {
+			rd = false;
+			tok++;
+		}
+
+		if (0 == strcmp(tok, "*"))
+			id = -1;
+		else {
+			id = strtoul(tok, &ptr, 0);
+			if (*ptr != '\0' || tok[0] == '\0' || id >= NIDS) {
+				fprintf(stderr, "ERR: Bad reorder ID, %s\n", tok);
+				goto fail;
+			}
+		}
+
+		w.m_min = strtoul(eq, &ptr, 0);
+		w.m_max = w.m_min;
+		if (*ptr == '-')
+			w.m_max = strtoul(ptr+1, &ptr, 0);
+		if (*ptr != '\0' || w.m_max < w.m_min) {
+			fprintf(stderr, "ERR: Bad reorder wait, %s\n", eq);
+			goto fail;
+		}
+
+		for(int k=0; k<2; k++) {
+			if ((k == 0 && !rd) || (k == 1 && !wr))
+				continue;
+			if (id < 0) {
+				dflt[k] = w;
+				dflt_given[k] = true;
+			} else {
+				model->m_wait[k][id] = w;
+				given[k][id] = true;
+			}
+		}
+	}
+
+	for(int k=0; k<2; k++)
+	for(int id=0; id<NIDS; id++)
+		if (dflt_given[k] && !given[k][id])
+			model->m_wait[k][id] = dflt[k];
+
+	free(str);
+	return model;
+fail:
+	usage(stderr);
+	free(str);
+	delete model;
+	return NULL;
+}
+// }}}
+
+void	REORDERSIM::usage(FILE *fp) {
+	// {{{
+	fprintf(fp, "Reordering models are a comma separated list of\n"
+		"\t[r|w]<id>=<min>[-<max>], dist=uniform|exp, and seed=<n>,\n"
+		"\tas in r2=0-400,*=0-32.  See sim/reordersim.h.\n");
+}
+// }}}
+
+////////////////////////////////////////////////////////////////////////
+//
+// DPI interface, as used by rtl/axireorder.v
+// {{{
+////////////////////////////////////////////////////////////////////////
+//
+//
+
+int	reorder_enabled(void) {
+	return (reordersim != NULL) ? 1 : 0;
+}
+
+int	reorder_delay(int wr, int id) {
+	if (!reordersim)
+		return 0;
+	return (int)reordersim->delay(wr != 0, (unsigned)id);
+}
+
+void	reorder_passed(int wr) {
+	if (reordersim)
+		reordersim->passed(wr != 0);
+}
+// }}}
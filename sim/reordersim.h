@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/reordersim.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Chooses how long each read request, and each write response,
+//		waits in front of (or behind) the AXI RAM, by AXI ID, so that
+//	rtl/axireorder.v may return them out of order across IDs.
+//
+//	A model is described by a comma separated list of
+//
+//	[r|w]<id>=<min>[-<max>]
+//		Items with this ID wait between min and max clocks.  An "r"
+//		applies this to read requests only, a "w" to write responses
+//		only, and neither to both.  An ID of "*" applies to every ID
+//		not otherwise given.  Unlisted IDs don't wait at all.
+//	dist=uniform|exp
+//		How waits are spread between min and max.  exp gives min plus
+//		an exponential wait with a mean of (max-min)/4, cut off at max.
+//	seed=<n>
+//		Seeds the random waits, for repeatable runs.
+//
+//	For example, "r2=0-400,*=0-32" holds the DMA's reads (ID 2) up to 400
+//	clocks, and everything else up to 32.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#ifndef	REORDERSIM_H
+#define	REORDERSIM_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+class	REORDERSIM {
+public:
+	enum { NIDS = 16 };
+
+	typedef	struct	{
+		unsigned	m_min, m_max;
+	} WAIT;
+
+	typedef	struct	{
+		unsigned long	m_items[NIDS], m_wait[NIDS], m_passed;
+	} STATS;
+private:
+	char		*m_name;
+	WAIT		m_wait[2][NIDS];	// [wr][id]
+	bool		m_exponential;
+	uint32_t	m_rng;
+	STATS		m_stats[2];
+
+	unsigned	random(void);
+public:
+	REORDERSIM(const char *name);
+	~REORDERSIM(void);
+
+	// Returns the number of clocks an item with the given ID should wait
+	unsigned	delay(bool wr, unsigned id);
+
+	// Counts an item released ahead of an older one
+	void	passed(bool wr) { m_stats[wr ? 1:0].m_passed++; }
+
+	const char	*name(void) const { return m_name; }
+	void	report(FILE *fp) const;
+
+	// Creates a model from a description, as above.  Returns NULL, and
+	// describes the problem on stderr, if it isn't understood.
+	static	REORDERSIM	*create(const char *spec);
+	static	void	usage(FILE *fp);
+};
+
+// The model used by rtl/axireorder.v.  If NULL at reset, as it is by default,
+// the AXI RAM answers in order.
+extern	REORDERSIM	*reordersim;
+
+#endif	// REORDERSIM_H
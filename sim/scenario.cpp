@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/scenario.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A host software scenario, written only against the DEVBUS
+//		interface.  See scenario.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "regdefs.h"
+#include "scenario.h"
+
+#define	SC_SRC_ADDR	(R_AXIRAM + 0x00500000)
+#define	SC_DST_ADDR	(R_AXIRAM + 0x00600000)
+#define	SC_DMA_ADDR	(R_AXIRAM + 0x00700000)
+#define	SC_LENGTH	8192
+#define	SC_LENGTHW	(SC_LENGTH/4)
+#define	SC_MAXPOLL	1000000
+
+#define	SC_START	0xc0000000	// MM2S and S2MM
+#define	SC_BUSY		0x80000000
+#define	SC_ERR		0x40000000
+#define	SC_MM2S_ABORT	0x6d000000
+#define	SC_DMA_START	0x00000011
+#define	SC_DMA_BUSY	0x00000001
+
+// waitidle()
+// {{{
+// Polls a control register until the given busy bit clears, giving up after
+// SC_MAXPOLL reads.  Returns the last value read.
+static	uint32_t	waitidle(DEVBUS *dev, uint32_t addr, uint32_t busy,
+			bool *timeout) {
+	uint32_t	v = 0;
+
+	for(unsigned k=0; k<SC_MAXPOLL; k++)
+		if (0 == ((v = dev->readio(addr)) & busy))
+			return v;
+	printf("SCENARIO: Timed out waiting on 0x%08x\n", addr);
+	*timeout = true;
+	return v;
+}
+// }}}
+
+static	void	write64(DEVBUS *dev, uint32_t addr, uint64_t v) {
+	dev->writeio(addr,   (uint32_t)v);
+	dev->writeio(addr+4, (uint32_t)(v >> 32));
+}
+
+bool	scenario(DEVBUS *dev, unsigned busbytes) {
+	// {{{
+	uint32_t	*buf = new uint32_t[SC_LENGTHW], *chk, status;
+	bool		fail = false;
+
+	chk = new uint32_t[SC_LENGTHW];
+	for(unsigned k=0; k<SC_LENGTHW; k++)
+		buf[k] = k;
+	dev->writei(SC_SRC_ADDR, SC_LENGTHW, buf);
+
+	// MM2S: every beat should reach the stream sink
+	// {{{
+	dev->writeio(R_STREAMSINK_BEATS, 0);
+	write64(dev, R_MM2SADDRLO, SC_SRC_ADDR);
+	write64(dev, R_MM2SLENLO,  SC_LENGTH);
+	dev->writeio(R_MM2SCTRL, SC_START);
+	status = waitidle(dev, R_MM2SCTRL, SC_BUSY, &fail);
+	if (status & SC_ERR) {
+		printf("SCENARIO: MM2S error, 0x%08x\n", status);
+		fail = true;
+	} if (dev->readio(R_STREAMSINK_BEATS) != SC_LENGTH / busbytes) {
+		printf("SCENARIO: MM2S sent %u beats, not %u\n",
+			dev->readio(R_STREAMSINK_BEATS), SC_LENGTH / busbytes);
+		fail = true;
+	}
+	// }}}
+
+	// S2MM: the stream source counts, one value per word
+	// {{{
+	dev->writeio(R_STREAMSRC_RESTART, 0);
+	write64(dev, R_S2MMADDRLO, SC_DST_ADDR);
+	write64(dev, R_S2MMLENLO,  SC_LENGTH);
+	dev->writeio(R_S2MMCTRL, SC_START);
+	status = waitidle(dev, R_S2MMCTRL, SC_BUSY, &fail);
+	if (status & SC_ERR) {
+		printf("SCENARIO: S2MM error, 0x%08x\n", status);
+		fail = true;
+	}
+	dev->readi(SC_DST_ADDR, SC_LENGTHW, chk);
+	for(unsigned k=1; k<SC_LENGTHW; k++)
+		if (chk[k] != chk[k-1]+1) {
+			printf("SCENARIO: S2MM word %u is 0x%08x, following "
+				"0x%08x\n", k, chk[k], chk[k-1]);
+			fail = true;
+			break;
+		}
+	// }}}
+
+	// DMA, from an odd address to an even one
+	// {{{
+	write64(dev, R_AXIDMASRCLO, SC_SRC_ADDR + 1);
+	write64(dev, R_AXIDMADSTLO, SC_DMA_ADDR + 2);
+	write64(dev, R_AXIDMALENLO, SC_LENGTH - 4);
+	dev->writeio(R_AXIDMACTRL, SC_DMA_START);
+	waitidle(dev, R_AXIDMACTRL, SC_DMA_BUSY, &fail);
+	dev->readi(SC_DMA_ADDR, SC_LENGTHW, chk);
+	if (memcmp((uint8_t *)buf + 1, (uint8_t *)chk + 2, SC_LENGTH - 4)) {
+		printf("SCENARIO: DMA copy mismatch\n");
+		fail = true;
+	}
+	// }}}
+
+	// MM2S, aborted as soon as it starts
+	// {{{
+	write64(dev, R_MM2SADDRLO, SC_SRC_ADDR);
+	write64(dev, R_MM2SLENLO,  0x100000);
+	dev->writeio(R_MM2SCTRL, SC_START);
+	// The abort key only means something once the core is busy
+	for(unsigned k=0; k<SC_MAXPOLL; k++)
+		if (dev->readio(R_MM2SCTRL) & SC_BUSY)
+			break;
+	dev->writeio(R_MM2SCTRL, SC_MM2S_ABORT);
+	waitidle(dev, R_MM2SCTRL, SC_BUSY, &fail);
+	// }}}
+
+	if (dev->bus_err()) {
+		printf("SCENARIO: Bus error\n");
+		fail = true;
+	}
+
+	printf("SCENARIO: %s\n", (fail) ? "FAIL" : "PASS");
+	delete[] buf;
+	delete[] chk;
+	return !fail;
+}
+// }}}
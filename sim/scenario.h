@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/scenario.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A host software scenario, written only against the DEVBUS
+//		interface, so that it may be run against either the
+//	transaction level model (AXITLM, see tlm_tb.cpp) or the Verilated
+//	design (AXI_TB, see automaster_tb.cpp) without change.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	SCENARIO_H
+#define	SCENARIO_H
+
+#include "devbus.h"
+
+// Runs an MM2S, an S2MM, an (unaligned) DMA copy, and an aborted MM2S,
+// checking the results of each.  Returns true if all passed.
+extern	bool	scenario(DEVBUS *dev, unsigned busbytes);
+
+#endif	// SCENARIO_H
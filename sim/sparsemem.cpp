@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/sparsemem.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A sparse, paged, backing store for the AXI RAM.  See
+//		sparsemem.h.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Vmain__Dpi.h"
+#include "sparsemem.h"
+
+static	SPARSEMEM	*sparsemem = NULL;
+
+SPARSEMEM	*getsparsemem(void) {
+	if (!sparsemem)
+		sparsemem = new SPARSEMEM();
+	return sparsemem;
+}
+
+SPARSEMEM::SPARSEMEM(unsigned lgpage, uint32_t fillv) {
+	// {{{
+	m_lgpage = (lgpage < 2) ? 2 : lgpage;
+	m_gen    = 0;
+	m_fill   = fillv;
+	m_window = NULL;
+	m_wlen   = 0;
+	m_wstale = false;
+	m_lastpg = 0;
+	m_last   = NULL;
+}
+// }}}
+
+SPARSEMEM::~SPARSEMEM(void) {
+	// {{{
+	for(auto &p : m_pages)
+		delete[] p.second.m_data;
+	delete[] m_window;
+}
+// }}}
+
+void	SPARSEMEM::fill(uint8_t *ptr, uint64_t len) const {
+	// {{{
+	uint32_t	*w = (uint32_t *)ptr;
+
+	if (((m_fill >> 8) & 0x0ffffff) == (m_fill & 0x0ffffff))
+		memset(ptr, m_fill & 0x0ff, len);
+	else for(uint64_t k=0; k<len/4; k++)
+		w[k] = m_fill;
+}
+// }}}
+
+void	SPARSEMEM::freshen(void) {
+	// {{{
+	if (m_wstale) {
+		fill(m_window, m_wlen);
+		m_wstale = false;
+	}
+}
+// }}}
+
+void	SPARSEMEM::sweep(unsigned count) {
+	// {{{
+	// Frees up to count of the oldest pages, if retired.  The rest go to
+	// the back of the line.
+	for(unsigned k=0; k<count && !m_sweep.empty(); k++) {
+		uint64_t	pg = m_sweep.front();
+		auto		it = m_pages.find(pg);
+
+		m_sweep.pop_front();
+		if (it == m_pages.end())
+			continue;	// Already freed by window()
+		if (it->second.m_gen != m_gen) {
+			delete[] it->second.m_data;
+			m_pages.erase(it);
+		} else
+			m_sweep.push_back(pg);
+	}
+}
+// }}}
+
+uint8_t	*SPARSEMEM::page(uint64_t addr, bool wr) {
+	// {{{
+	uint64_t	pg = addr >> m_lgpage;
+	PAGE		*p;
+
+	if (m_last && pg == m_lastpg)
+		return m_last;
+
+	auto	it = m_pages.find(pg);
+	if (it != m_pages.end() && it->second.m_gen == m_gen)
+		p = &it->second;
+	else if (!wr)
+		return NULL;
+	else {
+		if (it == m_pages.end()) {
+			PAGE	np;
+
+			sweep(2);
+			np.m_data = new uint8_t[1ul << m_lgpage];
+			p = &(m_pages[pg] = np);
+			m_sweep.push_back(pg);
+		} else	// Retired by clear(), and now reused
+			p = &it->second;
+		fill(p->m_data, 1ul << m_lgpage);
+		p->m_gen = m_gen;
+	}
+
+	m_lastpg = pg;
+	m_last   = p->m_data;
+	return m_last;
+}
+// }}}
+
+uint32_t	SPARSEMEM::read(uint64_t addr) {
+	// {{{
+	uint8_t		*p;
+	uint32_t	v;
+
+	addr &= -4;
+	if (addr < m_wlen) {
+		if (m_wstale)
+			return m_fill;
+		p = &m_window[addr];
+	} else if (NULL != (p = page(addr, false)))
+		p += addr & ((1ul << m_lgpage)-1);
+	else
+		return m_fill;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+// }}}
+
+void	SPARSEMEM::write(uint64_t addr, uint32_t data, unsigned strb) {
+	// {{{
+	uint8_t	*p;
+
+	if ((strb & 0x0f) == 0)
+		return;
+	addr &= -4;
+	if (addr < m_wlen) {
+		freshen();
+		p = &m_window[addr];
+	} else
+		p = page(addr, true) + (addr & ((1ul << m_lgpage)-1));
+
+	for(int k=0; k<4; k++)
+		if (strb & (1<<k))
+			p[k] = (uint8_t)(data >> (8*k));
+}
+// }}}
+
+void	SPARSEMEM::clear(uint32_t fillv) {
+	// {{{
+	m_fill = fillv;
+	m_gen++;
+	m_last = NULL;
+	if (m_window)
+		m_wstale = true;
+}
+// }}}
+
+uint32_t	*SPARSEMEM::window(uint64_t len) {
+	// {{{
+	len = (len + 3) & -4;
+	if (len > m_wlen) {
+		uint8_t	*w = new uint8_t[len];
+
+		// Move anything already written into the new window
+		for(uint64_t a=0; a<len; a+=4) {
+			uint32_t	v = read(a);
+
+			memcpy(&w[a], &v, sizeof(v));
+		}
+
+		// ... and free the pages it now covers
+		for(uint64_t pg=0; pg < (len >> m_lgpage); pg++) {
+			auto	it = m_pages.find(pg);
+
+			if (it != m_pages.end()) {
+				delete[] it->second.m_data;
+				m_pages.erase(it);
+			}
+		}
+		m_last = NULL;
+
+		delete[] m_window;
+		m_window = w;
+		m_wlen   = len;
+		m_wstale = false;
+	}
+
+	freshen();
+	return (uint32_t *)m_window;
+}
+// }}}
+
+unsigned long	SPARSEMEM::pages(void) const {
+	// {{{
+	unsigned long	count = 0;
+
+	for(auto &p : m_pages)
+		if (p.second.m_gen == m_gen)
+			count++;
+	return count;
+}
+// }}}
+
+uint64_t	SPARSEMEM::footprint(void) const {
+	return (uint64_t)m_pages.size() * (1ul << m_lgpage) + m_wlen;
+}
+
+// DPI access from the AXI RAM
+// {{{
+extern "C" {
+int	sparsemem_read(long long addr) {
+	return (int)getsparsemem()->read((uint64_t)addr);
+}
+
+void	sparsemem_write(long long addr, int data, int strb) {
+	getsparsemem()->write((uint64_t)addr, (uint32_t)data, (unsigned)strb);
+}
+}
+// }}}
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/sparsemem.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A sparse, paged, backing store for the AXI RAM, used in place
+//		of the (dense) Verilog memory array when the design is built
+//	with AXIRAM_SPARSE defined (make SPARSE=1).  The RAM then reads and
+//	writes this store, 32-bits at a time, via DPI.
+//
+//	- Addresses are 64-bits wide.
+//	- Pages are allocated on their first write.  Reads from any page that
+//		hasn't been written return the fill value.
+//	- clear() empties the whole memory in O(1), by retiring every page
+//		at once.  Retired pages are refilled, and reused, on their next
+//		write.  Those that aren't are freed, a couple at a time, as
+//		new pages are allocated.
+//
+//	The test bench may also ask for a pointer to the bottom of the memory,
+//	as with axiram_words().  That window is allocated (densely) on request,
+//	and so should be kept small.  clear() leaves the window stale, and
+//	it is only refilled when next used.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	SPARSEMEM_H
+#define	SPARSEMEM_H
+
+#include <stdint.h>
+#include <unordered_map>
+#include <deque>
+
+class	SPARSEMEM {
+	typedef	struct {
+		uint8_t		*m_data;
+		unsigned	m_gen;	// Valid only if equal to m_gen below
+	} PAGE;
+
+	std::unordered_map<uint64_t, PAGE>	m_pages;
+	// Every allocated page, oldest first, for freeing retired pages
+	std::deque<uint64_t>	m_sweep;
+	unsigned	m_lgpage, m_gen;
+	uint32_t	m_fill;
+	uint8_t		*m_window;
+	uint64_t	m_wlen;
+	bool		m_wstale;	// Cleared, but not yet refilled
+	// The last page used, since most accesses are sequential
+	uint64_t	m_lastpg;
+	uint8_t		*m_last;
+
+	uint8_t	*page(uint64_t addr, bool wr);
+	void	fill(uint8_t *ptr, uint64_t len) const;
+	void	freshen(void);
+	void	sweep(unsigned count);
+public:
+	SPARSEMEM(unsigned lgpage = 16, uint32_t fillv = 0);
+	~SPARSEMEM(void);
+
+	uint32_t	read(uint64_t addr);
+	void	write(uint64_t addr, uint32_t data, unsigned strb);
+
+	// Empty the whole memory, so that every word reads as fillv
+	void	clear(uint32_t fillv);
+
+	// A dense pointer to the bottom len bytes of the memory
+	uint32_t	*window(uint64_t len);
+
+	// Pages currently in use, and the bytes allocated for them
+	unsigned long	pages(void) const;
+	uint64_t	footprint(void) const;
+};
+
+// The memory behind the AXI RAM, created on first use
+extern	SPARSEMEM	*getsparsemem(void);
+
+#endif	// SPARSEMEM_H
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/tlm_tb.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Runs the host software scenario (scenario.cpp) against the
+//		transaction level model of the design (axitlm.cpp).  No
+//	Verilator is required.  main_tb runs the same scenario against the
+//	Verilated design.
+//
+//	Usage:	tlm_tb [-s <bytes>]
+//
+//	-s sets how many bytes each copy engine may move per bus access.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "axitlm.h"
+#include "scenario.h"
+
+int	main(int argc, char **argv) {
+	AXITLM	*dev = new AXITLM(AXIBUS_WIDTH/8);
+	struct timespec	start, stop;
+	bool	pass;
+
+	if (argc > 2 && 0 == strcmp(argv[1], "-s"))
+		dev->setstep(strtoul(argv[2], NULL, 0));
+	else if (argc > 1) {
+		fprintf(stderr, "USAGE: tlm_tb [-s <bytes per step>]\n");
+		exit(EXIT_FAILURE);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pass = scenario(dev, AXIBUS_WIDTH/8);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+
+	printf("TLM: %lu bus accesses, %.3f ms\n", dev->accesses(),
+		(stop.tv_sec - start.tv_sec) * 1e3
+			+ (stop.tv_nsec - start.tv_nsec) / 1e6);
+	delete dev;
+
+	if (!pass) {
+		printf("TEST FAIL!\n");
+		return EXIT_FAILURE;
+	}
+	printf("SUCCESS!\n");
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/togglemon.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	A switching activity (power) proxy.  Counts, every clock, the
+//		bits that change on each crossbar port's address (ARADDR,
+//	AWADDR) and data (WDATA and WSTRB, RDATA) buses, and the bytes each
+//	port moves, giving toggles per byte transferred.
+//
+//	It also counts the clocks each port is quiet: no xVALID on any
+//	channel, and no burst outstanding.  These are the clocks a clock gate
+//	may hold the clock off.  For the AXI DMA, whose OPT_CLKGATE gate is
+//	real, it also counts the clocks that gate's enable, axidma's
+//	clk_active (made visible by rtl/main.vlt), is low.
+//
+//	None of this is a power estimate.  It is, however, enough to compare
+//	configurations, such as with and without OPT_LOWPOWER, by activity.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	TOGGLEMON_H
+#define	TOGGLEMON_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "axitrace.h"
+
+//
+// TOGGLEBUS
+// {{{
+// One bus, of any width Verilator may give it (CData through VlWide<>), and
+// the number of bits that have changed on it
+class	TOGGLEBUS {
+	enum { MAXBYTES = 128 };
+	const uint8_t	*m_ptr;
+	unsigned	m_bytes;
+	uint8_t		m_last[MAXBYTES];
+public:
+	unsigned long	m_toggles;
+
+	TOGGLEBUS(void) : m_ptr(NULL), m_bytes(0), m_toggles(0) {}
+
+	template<class T>	void	bind(T *sig) {
+		static_assert(sizeof(T) <= MAXBYTES, "Bus is too wide");
+		m_ptr   = (const uint8_t *)sig;
+		m_bytes = sizeof(T);
+		memcpy(m_last, m_ptr, m_bytes);
+		m_toggles = 0;
+	}
+
+	void	tick(void) {
+		// {{{
+		unsigned	k = 0;
+
+		for(; k + 8 <= m_bytes; k += 8) {
+			uint64_t	now, last;
+
+			memcpy(&now,  m_ptr  + k, 8);
+			memcpy(&last, m_last + k, 8);
+			m_toggles += __builtin_popcountll(now ^ last);
+		} for(; k < m_bytes; k++)
+			m_toggles += __builtin_popcount(m_ptr[k] ^ m_last[k]);
+		memcpy(m_last, m_ptr, m_bytes);
+	}
+	// }}}
+};
+// }}}
+
+//
+// TOGGLEMON
+// {{{
+class	TOGGLEMON : public TICKMON {
+public:
+	enum { B_ARADDR = 0, B_AWADDR, B_WDATA, B_WSTRB, B_RDATA, NBUSES };
+
+	typedef	struct {
+		// As bound by AXITRACE_BIND
+		CData	*arvalid, *arready, *arid, *arlen,
+			*rvalid, *rready, *rid, *rlast,
+			*awvalid, *awready, *awid, *awlen,
+			*wvalid, *wready, *wlast,
+			*bvalid, *bready, *bid;
+		AXIADDR	araddr, awaddr;
+
+		TOGGLEBUS	m_bus[NBUSES];
+		unsigned long	m_beats, m_quiet;
+		unsigned long	m_rbursts, m_wbursts;
+	} PORT;
+
+	PORT		m_port[AXITRACE::NPORTS];
+	unsigned long	m_clocks, m_gated;
+private:
+	unsigned	m_busbytes;
+	// The DMA's clock gate enable
+	CData		*m_dmaclk;
+
+	void	tickport(PORT &p) {
+		// {{{
+		for(int b=0; b<NBUSES; b++)
+			p.m_bus[b].tick();
+
+		if (*p.arvalid && *p.arready)
+			p.m_rbursts++;
+		if (*p.awvalid && *p.awready)
+			p.m_wbursts++;
+		if (*p.rvalid && *p.rready) {
+			p.m_beats++;
+			if (*p.rlast && p.m_rbursts > 0)
+				p.m_rbursts--;
+		} if (*p.wvalid && *p.wready)
+			p.m_beats++;
+		if (*p.bvalid && *p.bready && p.m_wbursts > 0)
+			p.m_wbursts--;
+
+		if (!*p.arvalid && !*p.rvalid && !*p.awvalid && !*p.wvalid
+				&& !*p.bvalid && p.m_rbursts == 0
+				&& p.m_wbursts == 0)
+			p.m_quiet++;
+	}
+	// }}}
+public:
+	TOGGLEMON(Vmain *core, unsigned busbytes);
+
+	void	clear(void) {
+		// {{{
+		m_clocks = m_gated = 0;
+		for(int k=0; k<AXITRACE::NPORTS; k++) {
+			PORT	&p = m_port[k];
+
+			for(int b=0; b<NBUSES; b++)
+				p.m_bus[b].m_toggles = 0;
+			p.m_beats = p.m_quiet = 0;
+		}
+	}
+	// }}}
+
+	unsigned long	toggles(int k) const {
+		unsigned long	t = 0;
+
+		for(int b=0; b<NBUSES; b++)
+			t += m_port[k].m_bus[b].m_toggles;
+		return t;
+	}
+
+	unsigned long	bytes(int k) const {
+		return m_port[k].m_beats * m_busbytes; }
+
+	virtual	void	tick(unsigned long clk) {
+		(void)clk;
+		m_clocks++;
+		if (!*m_dmaclk)
+			m_gated++;
+		for(int k=0; k<AXITRACE::NPORTS; k++)
+			tickport(m_port[k]);
+	}
+
+	void	report(FILE *fp) const;
+};
+// }}}
+
+#define	TOGGLEMON_BIND(PT, P)	do {					\
+	AXITRACE_BIND(PT, P);						\
+	(PT).m_bus[B_ARADDR].bind(&core->VVAR(_axi_ ## P ## _araddr));	\
+	(PT).m_bus[B_AWADDR].bind(&core->VVAR(_axi_ ## P ## _awaddr));	\
+	(PT).m_bus[B_WDATA].bind(&core->VVAR(_axi_ ## P ## _wdata));	\
+	(PT).m_bus[B_WSTRB].bind(&core->VVAR(_axi_ ## P ## _wstrb));	\
+	(PT).m_bus[B_RDATA].bind(&core->VVAR(_axi_ ## P ## _rdata));	\
+	} while(0)
+
+inline	TOGGLEMON::TOGGLEMON(Vmain *core, unsigned busbytes) {
+	// {{{
+	TOGGLEMON_BIND(m_port[AXITRACE::P_HOST],   wbu);
+	TOGGLEMON_BIND(m_port[AXITRACE::P_MM2S],   mm2s);
+	TOGGLEMON_BIND(m_port[AXITRACE::P_S2MM],   s2mm);
+	TOGGLEMON_BIND(m_port[AXITRACE::P_DMA],    dma);
+	TOGGLEMON_BIND(m_port[AXITRACE::P_AXIRAM], axiram);
+	TOGGLEMON_BIND(m_port[AXITRACE::P_CTRL],   controlbus);
+	TOGGLEMON_BIND(m_port[AXITRACE::P_AXIRAM2], axiram2);
+
+	for(int k=0; k<AXITRACE::NPORTS; k++)
+		m_port[k].m_rbursts = m_port[k].m_wbursts = 0;
+	m_busbytes = busbytes;
+	m_dmaclk = &core->VVAR(_dmai__DOT__clk_active);
+	clear();
+}
+// }}}
+
+// report()
+// {{{
+// One line per port, and the DMA's gated clocks, followed by machine readable
+// lines for sim/configs.sh, as in
+//	"TOGGLE: <port> <width> <bytes> <toggles> <clocks> <quiet clocks>"
+//	"CLKGATE: DMA <width> <clocks> <gated clocks>"
+inline	void	TOGGLEMON::report(FILE *fp) const {
+	static const char *const	pname[AXITRACE::NPORTS] = {
+			"Host", "MM2S", "S2MM", "DMA", "AXIRAM", "Control",
+			"AXIRAM2" };
+
+	fprintf(fp, "Toggle activity, over %lu clocks:\n", m_clocks);
+	fprintf(fp, "\t%-8s %9s %9s %10s %10s %10s %8s %8s %6s\n",
+		"PORT", "AR-ADDR", "AW-ADDR", "W-DATA", "R-DATA", "BYTES",
+		"TGL/BYTE", "TGL/CLK", "QUIET");
+	for(int k=0; k<AXITRACE::NPORTS; k++) {
+		const PORT	&p = m_port[k];
+		unsigned long	t = toggles(k), b = bytes(k);
+
+		fprintf(fp, "\t%-8s %9lu %9lu %10lu %10lu %10lu %8.3f %8.3f "
+				"%5.1f%%\n", pname[k],
+			p.m_bus[B_ARADDR].m_toggles,
+			p.m_bus[B_AWADDR].m_toggles,
+			p.m_bus[B_WDATA].m_toggles + p.m_bus[B_WSTRB].m_toggles,
+			p.m_bus[B_RDATA].m_toggles, b,
+			(b > 0) ? t / (double)b : 0.0,
+			(m_clocks > 0) ? t / (double)m_clocks : 0.0,
+			(m_clocks > 0) ? 100.0 * p.m_quiet / m_clocks : 0.0);
+	}
+
+	fprintf(fp, "\tDMA clock gated for %lu of %lu clocks (%.1f%%)\n",
+		m_gated, m_clocks,
+		(m_clocks > 0) ? 100.0 * m_gated / m_clocks : 0.0);
+
+	for(int k=0; k<AXITRACE::NPORTS; k++)
+		fprintf(fp, "TOGGLE: %-20s %3u %10lu %10lu %10lu %10lu\n",
+			pname[k], m_busbytes * 8, bytes(k), toggles(k),
+			m_clocks, m_port[k].m_quiet);
+	fprintf(fp, "CLKGATE: %-20s %3u %10lu %10lu\n", "DMA",
+		m_busbytes * 8, m_clocks, m_gated);
+}
+// }}}
+// }}}
+#endif	// TOGGLEMON_H
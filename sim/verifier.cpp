@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/verifier.cpp
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Implements the memory checks described in verifier.h, and the
+//		worker thread that runs them.
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "verifier.h"
+
+static	double	now(void) {
+	struct	timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+VERIFIER::VERIFIER(bool async) {
+	// {{{
+	m_stop  = false;
+	m_words = 0;
+	m_busy  = 0.0;
+	m_thread = (async) ? new std::thread(&VERIFIER::worker, this) : NULL;
+}
+// }}}
+
+VERIFIER::~VERIFIER(void) {
+	// {{{
+	if (m_thread) {
+		{
+			std::lock_guard<std::mutex>	guard(m_lock);
+			m_stop = true;
+		}
+		m_cv.notify_one();
+		m_thread->join();
+		delete m_thread;
+	}
+
+	for(JOB *job : m_jobs) {
+		free(job->m_name);
+		delete job;
+	}
+}
+// }}}
+
+VERIFIER::JOB	*VERIFIER::newjob(const char *name, CHECK check,
+		unsigned first, unsigned nwords) {
+	// {{{
+	JOB	*job = new JOB;
+
+	job->m_name   = strdup(name);
+	job->m_check  = check;
+	job->m_first  = first;
+	job->m_other  = 0;
+	job->m_value  = 0;
+	job->m_done   = false;
+	job->m_errors = 0;
+	job->m_at     = 0;
+	job->m_got    = job->m_want = 0;
+	job->m_data.resize(nwords);
+	return job;
+}
+// }}}
+
+void	VERIFIER::submit(JOB *job) {
+	// {{{
+	m_jobs.push_back(job);
+	if (!m_thread) {
+		check(job);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex>	guard(m_lock);
+		m_queue.push_back(job);
+	}
+	m_cv.notify_one();
+}
+// }}}
+
+void	VERIFIER::increment(const char *name, const uint32_t *mem,
+		unsigned first, unsigned nwords) {
+	// {{{
+	JOB	*job = newjob(name, V_INCREMENT, first, nwords);
+
+	memcpy(job->m_data.data(), &mem[first], nwords * sizeof(uint32_t));
+	submit(job);
+}
+// }}}
+
+void	VERIFIER::fill(const char *name, const uint32_t *mem, unsigned first,
+		unsigned nwords, uint32_t value) {
+	// {{{
+	JOB	*job = newjob(name, V_FILL, first, nwords);
+
+	job->m_value = value;
+	memcpy(job->m_data.data(), &mem[first], nwords * sizeof(uint32_t));
+	submit(job);
+}
+// }}}
+
+void	VERIFIER::match(const char *name, const uint32_t *mem, unsigned first,
+		unsigned other, unsigned nwords, const uint32_t *src) {
+	// {{{
+	JOB	*job = newjob(name, V_MATCH, first, nwords);
+
+	job->m_other = other;
+	job->m_expect.resize(nwords);
+	memcpy(job->m_data.data(), &mem[first], nwords * sizeof(uint32_t));
+	if (!src)
+		src = mem;
+	memcpy(job->m_expect.data(), &src[other], nwords * sizeof(uint32_t));
+	submit(job);
+}
+// }}}
+
+void	VERIFIER::check(JOB *job) {
+	// {{{
+	const	std::vector<uint32_t>	&d = job->m_data;
+	double		start = now();
+	unsigned	n = d.size();
+
+	for(unsigned k=0; k<n; k++) {
+		uint32_t	want;
+
+		switch(job->m_check) {
+		case V_INCREMENT:
+			if (k == 0)
+				continue;
+			want = d[k-1] + 1;
+			break;
+		case V_FILL:
+			want = job->m_value;
+			break;
+		default: // case V_MATCH:
+			want = job->m_expect[k];
+			break;
+		}
+
+		if (d[k] != want) {
+			if (job->m_errors++ == 0) {
+				job->m_at   = k;
+				job->m_got  = d[k];
+				job->m_want = want;
+			}
+		}
+	}
+
+	// Only the worker updates these while it runs
+	m_words += n;
+	m_busy  += now() - start;
+	job->m_done = true;
+}
+// }}}
+
+void	VERIFIER::worker(void) {
+	// {{{
+	while(1) {
+		JOB	*job;
+
+		{
+			std::unique_lock<std::mutex>	lock(m_lock);
+
+			m_cv.wait(lock, [this]{
+				return m_stop || !m_queue.empty(); });
+			if (m_queue.empty())
+				return;
+			job = m_queue.front();
+			m_queue.pop_front();
+		}
+
+		check(job);
+	}
+}
+// }}}
+
+bool	VERIFIER::finish(FILE *fp) {
+	// {{{
+	double		start = now();
+	unsigned	failed = 0;
+
+	if (m_thread) {
+		// The worker empties its queue before it stops
+		{
+			std::lock_guard<std::mutex>	guard(m_lock);
+			m_stop = true;
+		}
+		m_cv.notify_one();
+		m_thread->join();
+		delete m_thread;
+		m_thread = NULL;
+	}
+
+	for(JOB *job : m_jobs) {
+		unsigned	at = job->m_first + job->m_at;
+
+		if (job->m_errors == 0)
+			continue;
+		failed++;
+		switch(job->m_check) {
+		case V_INCREMENT:
+			fprintf(fp, "%s: AXIRAM[%u] = 0x%08x != 0x%08x + 1",
+				job->m_name, at, job->m_got, job->m_want - 1);
+			break;
+		case V_FILL:
+			fprintf(fp, "%s: AXIRAM[%u] = 0x%08x, not 0x%08x",
+				job->m_name, at, job->m_got, job->m_want);
+			break;
+		default:
+			fprintf(fp, "%s: AXIRAM[%u] = 0x%08x != AXIRAM[%u] = "
+				"0x%08x", job->m_name, at, job->m_got,
+				job->m_other + job->m_at, job->m_want);
+			break;
+		}
+		fprintf(fp, ", %u word%s wrong\n", job->m_errors,
+			(job->m_errors == 1) ? "" : "s");
+	}
+
+	fprintf(fp, "VERIFY: %lu checks, %lu words, %.3f seconds checking, "
+		"%.3f seconds waited for at the end\n",
+		(unsigned long)m_jobs.size(), m_words, m_busy, now() - start);
+	return failed == 0;
+}
+// }}}
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// Filename:	sim/verifier.h
+// {{{
+// Project:	AXI DMA Check: A utility to measure AXI DMA speeds
+//
+// Purpose:	Checks the AXI RAM's contents after a test, off of the
+//		simulation thread.  Each check copies the words it needs from
+//	the RAM as it's requested--a single memcpy--and is then queued for a
+//	worker thread, so that the simulation may go on to its next test
+//	(and clear or overwrite the RAM) while the check is run.  Results are
+//	collected, and reported in the order the checks were requested, by
+//	finish().
+//
+//	Three checks are supported:
+//
+//	- increment(): each word is one more than the word before it
+//	- fill(): every word holds the same value
+//	- match(): one range of words matches another
+//
+//	Constructed with async false, checks are run as they are requested
+//	instead, on the simulation thread, yet still reported by finish().
+//
+// Creator:	Dan Gisselquist, Ph.D.
+//		Gisselquist Technology, LLC
+//
+////////////////////////////////////////////////////////////////////////////////
+// }}}
+// Copyright (C) 2020-2025, Gisselquist Technology, LLC
+// {{{
+// This program is free software (firmware): you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or (at
+// your option) any later version.
+//
+// This program is distributed in the hope that it will be useful, but WITHOUT
+// ANY WARRANTY; without even the implied warranty of MERCHANTIBILITY or
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+// for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program.  (It's in the $(ROOT)/doc directory.  Run make with no
+// target there if the PDF file isn't present.)  If not, see
+// <http://www.gnu.org/licenses/> for a copy.
+// }}}
+// License:	GPL, v3, as defined and found on www.gnu.org,
+// {{{
+//		http://www.gnu.org/licenses/gpl.html
+//
+////////////////////////////////////////////////////////////////////////////////
+//
+// }}}
+#ifndef	VERIFIER_H
+#define	VERIFIER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class	VERIFIER {
+public:
+	enum	CHECK { V_INCREMENT, V_FILL, V_MATCH };
+
+	typedef	struct {
+		char		*m_name;
+		CHECK		m_check;
+		// The word index of the first word checked, for reporting
+		unsigned	m_first, m_other;
+		uint32_t	m_value;
+		// The words to check, and (for match()) the words expected
+		std::vector<uint32_t>	m_data, m_expect;
+
+		// Results
+		bool		m_done;
+		unsigned	m_errors, m_at;
+		uint32_t	m_got, m_want;
+	} JOB;
+private:
+	std::vector<JOB *>	m_jobs;		// Every job, in order
+	std::deque<JOB *>	m_queue;	// Jobs not yet started
+	std::mutex		m_lock;
+	std::condition_variable	m_cv;
+	std::thread		*m_thread;
+	bool			m_stop;
+	// Words checked, and seconds spent checking them
+	unsigned long		m_words;
+	double			m_busy;
+
+	JOB	*newjob(const char *name, CHECK check, unsigned first,
+			unsigned nwords);
+	void	submit(JOB *job);
+	void	check(JOB *job);
+	void	worker(void);
+public:
+	VERIFIER(bool async = true);
+	~VERIFIER(void);
+
+	// mem[first+1] through mem[first+nwords-1], each one more than the
+	// word before it
+	void	increment(const char *name, const uint32_t *mem,
+			unsigned first, unsigned nwords);
+	// mem[first] through mem[first+nwords-1] all equal to value
+	void	fill(const char *name, const uint32_t *mem, unsigned first,
+			unsigned nwords, uint32_t value);
+	// mem[first+k] equal to src[other+k], for k from 0 to nwords-1.  src
+	// defaults to mem.
+	void	match(const char *name, const uint32_t *mem, unsigned first,
+			unsigned other, unsigned nwords,
+			const uint32_t *src = NULL);
+
+	// Waits for every check to complete, reports any failures (and a
+	// summary) to fp, and returns true if every check passed
+	bool	finish(FILE *fp);
+};
+
+#endif	// VERIFIER_H
@@ -7,7 +7,7 @@
 // Computer Generated: This file is computer generated by AUTOFPGA. DO NOT EDIT.
 // DO NOT EDIT THIS FILE!
 //
-// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt vibus.txt noconsole.txt
+// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axiram2.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt streamcheck.txt qos.txt vibus.txt noconsole.txt
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -45,9 +45,23 @@
 #include "regdefs.h"
 
 const	REGNAME	raw_bregs[] = {
+	{ R_AXIRAM2           ,	"AXIRAM2"    	},
+	{ R_AXIRAM2           ,	"RAM2"       	},
 	{ R_STREAMSINK_BEATS  ,	"BEATS"      	},
 	{ R_STREAMSINK_PACKETS,	"PACKETS"    	},
 	{ R_STREAMSINK_CLOCKS ,	"CLOCKS"     	},
+	{ R_STREAMSINK_BPCTRL ,	"BPCTRL"     	},
+	{ R_STREAMSINK_BPARG  ,	"BPARG"      	},
+	{ R_STREAMSINK_BPSEED ,	"BPSEED"     	},
+	{ R_STREAMSINK_BPTRACE,	"BPTRACE"    	},
+	{ R_STREAMSINK_LATENCY,	"LATENCY"    	},
+	{ R_STREAMSINK_MAXGAP ,	"MAXGAP"     	},
+	{ R_STREAMSINK_STALLS ,	"STALLS"     	},
+	{ R_STREAMSINK_HIST0  ,	"HIST0"      	},
+	{ R_STREAMSINK_HIST1  ,	"HIST1"      	},
+	{ R_STREAMSINK_HIST2  ,	"HIST2"      	},
+	{ R_STREAMSINK_HIST3  ,	"HIST3"      	},
+	{ R_STREAMSINK_HIST4  ,	"HIST4"      	},
 	{ R_AXIDMACTRL        ,	"AXIDMACTRL" 	},
 	{ R_AXIDMASRCLO       ,	"AXIDMASRCLO"	},
 	{ R_AXIDMASRCHI       ,	"AXIDMASRCHI"	},
@@ -65,6 +79,21 @@ const	REGNAME	raw_bregs[] = {
 	{ R_S2MMADDRHI        ,	"S2MMADDRHI" 	},
 	{ R_S2MMLENLO         ,	"S2MMLENLO"  	},
 	{ R_S2MMLENHI         ,	"S2MMLENHI"  	},
+	{ R_STREAMSRC_RATE    ,	"SRCRATE"    	},
+	{ R_STREAMSRC_BURST   ,	"SRCBURST"   	},
+	{ R_STREAMSRC_PKTLEN  ,	"SRCPKTLEN"  	},
+	{ R_STREAMSRC_RESTART ,	"SRCRESTART" 	},
+	{ R_STREAMSRC_BEATS   ,	"SRCBEATS"   	},
+	{ R_STREAMSRC_PACKETS ,	"SRCPACKETS" 	},
+	{ R_STREAMSRC_STALLS  ,	"SRCSTALLS"  	},
+	{ R_STREAMCHK_CTRL    ,	"CHKCTRL"    	},
+	{ R_STREAMCHK_SEED    ,	"CHKSEED"    	},
+	{ R_STREAMCHK_WORDS   ,	"CHKWORDS"   	},
+	{ R_STREAMCHK_ERRORS  ,	"CHKERRORS"  	},
+	{ R_STREAMCHK_ERRIDX  ,	"CHKERRIDX"  	},
+	{ R_STREAMCHK_ERRDATA ,	"CHKERRDATA" 	},
+	{ R_STREAMCHK_ERREXP  ,	"CHKERREXP"  	},
+	{ R_STREAMCHK_CRC     ,	"CHKCRC"     	},
 	{ R_AXIRAM            ,	"AXIRAM"     	},
 	{ R_AXIRAM            ,	"RAM"        	}
 };
@@ -77,7 +106,7 @@ const	REGNAME	raw_bregs[] = {
 const	REGNAME		*bregs = raw_bregs;
 const	int	NREGS = RAW_NREGS;
 
-unsigned	addrdecode(const char *v) {
+unsigned long	addrdecode(const char *v) {
 	if (isalpha(v[0])) {
 		for(int i=0; i<NREGS; i++)
 			if (strcasecmp(v, bregs[i].m_name)==0)
@@ -88,7 +117,7 @@ unsigned	addrdecode(const char *v) {
 		return strtoul(v, NULL, 0);
 }
 
-const	char *addrname(const unsigned v) {
+const	char *addrname(const unsigned long v) {
 	for(int i=0; i<NREGS; i++)
 		if (bregs[i].m_addr == v)
 			return bregs[i].m_name;
@@ -7,7 +7,7 @@
 // Computer Generated: This file is computer generated by AUTOFPGA. DO NOT EDIT.
 // DO NOT EDIT THIS FILE!
 //
-// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt vibus.txt noconsole.txt
+// CmdLine:	/home/dan/work/rnd/opencores/autofpga/trunk/sw/autofpga -d autofpga.dbg -o ./ global.txt axibus.txt axiram.txt axiram2.txt axidma.txt aximm2s.txt axis2mm.txt controlbus.txt streamsink.txt streamsrc.txt streamcheck.txt qos.txt vibus.txt noconsole.txt
 //
 // Creator:	Dan Gisselquist, Ph.D.
 //		Gisselquist Technology, LLC
@@ -54,28 +54,56 @@
 //
 // Register address definitions, from @REGS.#d
 //
+#define	R_AXIRAM2           	0x00400000	// 00400000, wbregs names: AXIRAM2, RAM2
 #define	R_STREAMSINK_BEATS  	0x00800000	// 00800000, wbregs names: BEATS
 #define	R_STREAMSINK_PACKETS	0x00800004	// 00800000, wbregs names: PACKETS
 #define	R_STREAMSINK_CLOCKS 	0x00800008	// 00800000, wbregs names: CLOCKS
-#define	R_AXIDMACTRL        	0x00800020	// 00800020, wbregs names: AXIDMACTRL
-#define	R_AXIDMASRCLO       	0x00800028	// 00800020, wbregs names: AXIDMASRCLO
-#define	R_AXIDMASRCHI       	0x0080002c	// 00800020, wbregs names: AXIDMASRCHI
-#define	R_AXIDMADSTLO       	0x00800030	// 00800020, wbregs names: AXIDMADSTLO
-#define	R_AXIDMADSTHI       	0x00800034	// 00800020, wbregs names: AXIDMADSTHI
-#define	R_AXIDMALENLO       	0x00800038	// 00800020, wbregs names: AXIDMALENLO
-#define	R_AXIDMALENHI       	0x0080003c	// 00800020, wbregs names: AXIDMALENHI
+#define	R_STREAMSINK_BPCTRL 	0x00800010	// 00800000, wbregs names: BPCTRL
+#define	R_STREAMSINK_BPARG  	0x00800014	// 00800000, wbregs names: BPARG
+#define	R_STREAMSINK_BPSEED 	0x00800018	// 00800000, wbregs names: BPSEED
+#define	R_STREAMSINK_BPTRACE	0x0080001c	// 00800000, wbregs names: BPTRACE
+#define	R_STREAMSINK_LATENCY	0x00800020	// 00800000, wbregs names: LATENCY
+#define	R_STREAMSINK_MAXGAP 	0x00800024	// 00800000, wbregs names: MAXGAP
+#define	R_STREAMSINK_STALLS 	0x00800028	// 00800000, wbregs names: STALLS
+#define	R_STREAMSINK_HIST0  	0x0080002c	// 00800000, wbregs names: HIST0
+#define	R_STREAMSINK_HIST1  	0x00800030	// 00800000, wbregs names: HIST1
+#define	R_STREAMSINK_HIST2  	0x00800034	// 00800000, wbregs names: HIST2
+#define	R_STREAMSINK_HIST3  	0x00800038	// 00800000, wbregs names: HIST3
+#define	R_STREAMSINK_HIST4  	0x0080003c	// 00800000, wbregs names: HIST4
+#define	R_AXIDMACTRL        	0x00800040	// 00800040, wbregs names: AXIDMACTRL
+#define	R_AXIDMASRCLO       	0x00800048	// 00800040, wbregs names: AXIDMASRCLO
+#define	R_AXIDMASRCHI       	0x0080004c	// 00800040, wbregs names: AXIDMASRCHI
+#define	R_AXIDMADSTLO       	0x00800050	// 00800040, wbregs names: AXIDMADSTLO
+#define	R_AXIDMADSTHI       	0x00800054	// 00800040, wbregs names: AXIDMADSTHI
+#define	R_AXIDMALENLO       	0x00800058	// 00800040, wbregs names: AXIDMALENLO
+#define	R_AXIDMALENHI       	0x0080005c	// 00800040, wbregs names: AXIDMALENHI
 // AXI MM2S registers
-#define	R_MM2SCTRL          	0x00800040	// 00800040, wbregs names: MM2SCTRL
-#define	R_MM2SADDRLO        	0x00800048	// 00800040, wbregs names: MM2SADDRLO
-#define	R_MM2SADDRHI        	0x0080004c	// 00800040, wbregs names: MM2SADDRHI
-#define	R_MM2SLENLO         	0x00800058	// 00800040, wbregs names: MM2SLENLO
-#define	R_MM2SLENHI         	0x0080005c	// 00800040, wbregs names: MM2SLENHI
-#define	R_S2MMCTRL          	0x00800060	// 00800060, wbregs names: S2MMCTRL
-#define	R_S2MMADDRLO        	0x00800070	// 00800060, wbregs names: S2MMADDRLO
-#define	R_S2MMADDRHI        	0x00800074	// 00800060, wbregs names: S2MMADDRHI
-#define	R_S2MMLENLO         	0x00800078	// 00800060, wbregs names: S2MMLENLO
-#define	R_S2MMLENHI         	0x0080007c	// 00800060, wbregs names: S2MMLENHI
-#define	R_AXIRAM            	0x01000000	// 01000000, wbregs names: AXIRAM, RAM
+#define	R_MM2SCTRL          	0x00800060	// 00800060, wbregs names: MM2SCTRL
+#define	R_MM2SADDRLO        	0x00800068	// 00800060, wbregs names: MM2SADDRLO
+#define	R_MM2SADDRHI        	0x0080006c	// 00800060, wbregs names: MM2SADDRHI
+#define	R_MM2SLENLO         	0x00800078	// 00800060, wbregs names: MM2SLENLO
+#define	R_MM2SLENHI         	0x0080007c	// 00800060, wbregs names: MM2SLENHI
+#define	R_S2MMCTRL          	0x00800080	// 00800080, wbregs names: S2MMCTRL
+#define	R_S2MMADDRLO        	0x00800090	// 00800080, wbregs names: S2MMADDRLO
+#define	R_S2MMADDRHI        	0x00800094	// 00800080, wbregs names: S2MMADDRHI
+#define	R_S2MMLENLO         	0x00800098	// 00800080, wbregs names: S2MMLENLO
+#define	R_S2MMLENHI         	0x0080009c	// 00800080, wbregs names: S2MMLENHI
+#define	R_STREAMSRC_RATE    	0x008000a0	// 008000a0, wbregs names: SRCRATE
+#define	R_STREAMSRC_BURST   	0x008000a4	// 008000a0, wbregs names: SRCBURST
+#define	R_STREAMSRC_PKTLEN  	0x008000a8	// 008000a0, wbregs names: SRCPKTLEN
+#define	R_STREAMSRC_RESTART 	0x008000ac	// 008000a0, wbregs names: SRCRESTART
+#define	R_STREAMSRC_BEATS   	0x008000b0	// 008000a0, wbregs names: SRCBEATS
+#define	R_STREAMSRC_PACKETS 	0x008000b4	// 008000a0, wbregs names: SRCPACKETS
+#define	R_STREAMSRC_STALLS  	0x008000b8	// 008000a0, wbregs names: SRCSTALLS
+#define	R_STREAMCHK_CTRL    	0x008000c0	// 008000c0, wbregs names: CHKCTRL
+#define	R_STREAMCHK_SEED    	0x008000c4	// 008000c0, wbregs names: CHKSEED
+#define	R_STREAMCHK_WORDS   	0x008000c8	// 008000c0, wbregs names: CHKWORDS
+#define	R_STREAMCHK_ERRORS  	0x008000cc	// 008000c0, wbregs names: CHKERRORS
+#define	R_STREAMCHK_ERRIDX  	0x008000d0	// 008000c0, wbregs names: CHKERRIDX
+#define	R_STREAMCHK_ERRDATA 	0x008000d4	// 008000c0, wbregs names: CHKERRDATA
+#define	R_STREAMCHK_ERREXP  	0x008000d8	// 008000c0, wbregs names: CHKERREXP
+#define	R_STREAMCHK_CRC     	0x008000dc	// 008000c0, wbregs names: CHKCRC
+#define	R_AXIRAM            	0x200000000	// 200000000, wbregs names: AXIRAM, RAM
 
 
 //
@@ -90,12 +118,16 @@
 //
 // @REGDEFS.H.INSERT for masters
 // @REGDEFS.H.INSERT for peripherals
+#define	AXIBUS_WIDTH	32
 
 #define	RAMSIZE	(1u<<24)
+#define	RAMSPAN	(1ul<<33)
+
+#define	RAM2SIZE	(1u<<22)
 
 // @REGDEFS.H.INSERT from the top level
 typedef	struct {
-	unsigned	m_addr;
+	unsigned long	m_addr;
 	const char	*m_name;
 } REGNAME;
 
@@ -103,8 +135,8 @@ extern	const	REGNAME	*bregs;
 extern	const	int	NREGS;
 // #define	NREGS	(sizeof(bregs)/sizeof(bregs[0]))
 
-extern	unsigned	addrdecode(const char *v);
-extern	const	char *addrname(const unsigned v);
+extern	unsigned long	addrdecode(const char *v);
+extern	const	char *addrname(const unsigned long v);
 // End of definitions from REGDEFS.H.INSERT
 
 